@@ -12,6 +12,9 @@
 #ifndef BaseAnalysis_h
 #define BaseAnalysis_h
 
+// Jet analysis headers
+#include "InputRequirements.h"
+
 // ROOT headers
 #include "TObject.h"
 #include "TList.h"
@@ -43,6 +46,13 @@ class BaseAnalysis {
     /// @brief Finish analysis
     virtual void finish() = 0; ///<
 
+    /// @brief Write analysis output (histograms) to the current directory
+    virtual void writeOutput() { /* empty */ }
+
+    /// @brief Add input quantities used by the analysis. Only required inputs are read.
+    /// By default all inputs are required
+    virtual void addRequiredInputs(InputRequirements& inputs) const { inputs.requireAll(); }
+
     ClassDef(BaseAnalysis, 0)
 };
 
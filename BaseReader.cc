@@ -13,11 +13,29 @@
 #include "BaseReader.h"
 
 // ROOT headers
+#include "TChain.h"
+#include "TFile.h"
+#include "TObjArray.h"
 #include "TString.h"
+#include "TTree.h"
+
+// C++ headers
+#include <algorithm>
+#include <cstdlib>
+
+//_________________
+/// @brief Division rounded towards minus infinity (entries may precede the sampling origin)
+static Long64_t floorDivide(const Long64_t& a, const Long64_t& b) {
+    Long64_t q = a / b;
+    return ( (a % b != 0) && ((a < 0) != (b < 0)) ) ? q - 1 : q;
+}
 
 //_________________
-BaseReader::BaseReader() : fReaderStatus{0} {
-    /* empty */
+BaseReader::BaseReader() : fReaderStatus{0}, fFirstEntry{0}, fLastEntry{-1},
+    fShardIndex{0}, fNShards{1}, fSamplingStep{1}, fSamplingBlockSize{1}, fSamplingOrigin{-1}, 
+    fStageStats{nullptr}, fRequiredInputs{}, fEventsAreQueued{false} {
+    // Read everything unless told otherwise
+    fRequiredInputs.requireAll();
 }
 
 //_________________
@@ -32,4 +50,140 @@ void BaseReader::report() {
     //     temp += "NONE";
     // }
     std::cout << "\n" << std::endl;
-}
\ No newline at end of file
+}
+//_________________
+void BaseReader::setShard(const int& index, const int& nShards) {
+    if ( nShards < 1 || index < 0 || index >= nShards ) {
+        std::cerr << Form("[ERROR] BaseReader::setShard - wrong shard %d of %d. Terminating\n", index, nShards);
+        exit(1);
+    }
+    fShardIndex = index;
+    fNShards = nShards;
+}
+
+//_________________
+Long64_t BaseReader::entryNumber(const Long64_t& iEvent) const {
+    if ( fSamplingStep <= 1 ) {
+        return fFirstEntry + iEvent;
+    }
+    // Index of the event among the sampled entries counted from the origin
+    const Long64_t origin = ( fSamplingOrigin < 0 ) ? fFirstEntry : fSamplingOrigin;
+    const Long64_t iSampled = nSampledBefore( fFirstEntry ) + iEvent;
+    const Long64_t iBlock = floorDivide( iSampled, fSamplingBlockSize );
+    return origin + iBlock * fSamplingStep * fSamplingBlockSize + ( iSampled - iBlock * fSamplingBlockSize );
+}
+
+//_________________
+Long64_t BaseReader::nSampledBefore(const Long64_t& entry) const {
+    const Long64_t origin = ( fSamplingOrigin < 0 ) ? fFirstEntry : fSamplingOrigin;
+    if ( fSamplingStep <= 1 ) return entry - origin;
+    const Long64_t period = fSamplingStep * fSamplingBlockSize;
+    const Long64_t nPeriods = floorDivide( entry - origin, period );
+    return nPeriods * fSamplingBlockSize + std::min( entry - origin - nPeriods * period, fSamplingBlockSize );
+}
+
+//_________________
+Long64_t BaseReader::resolveEntryRange(const Long64_t& nEntries) {
+    // Keep the range inside the input
+    if ( fFirstEntry < 0 ) fFirstEntry = 0;
+    Long64_t last = ( fLastEntry < 0 || fLastEntry > nEntries ) ? nEntries : fLastEntry;
+    if ( fFirstEntry > last ) fFirstEntry = last;
+    // Sampling blocks are anchored to the whole range: shards and later splits read the same entries
+    if ( fSamplingOrigin < 0 ) fSamplingOrigin = fFirstEntry;
+
+    if ( fNShards > 1 ) {
+        Long64_t nRange = last - fFirstEntry;
+        Long64_t first = fFirstEntry;
+        fFirstEntry = first + fShardIndex * nRange / fNShards;
+        last = first + (fShardIndex + 1) * nRange / fNShards;
+        fLastEntry = last;
+        std::cout << Form("Reading shard %d of %d\n", fShardIndex, fNShards);
+        fShardIndex = 0;
+        fNShards = 1;
+    }
+    return last;
+}
+
+//_________________
+Long64_t BaseReader::nSampledEntries(const Long64_t& nEntries) const {
+    if ( fSamplingStep <= 1 || nEntries <= 0 ) return nEntries;
+    // Only every fSamplingStep-th block of entries (counted from the origin) is read
+    return nSampledBefore( fFirstEntry + nEntries ) - nSampledBefore( fFirstEntry );
+}
+
+//_________________
+void BaseReader::clusterTasks(const std::vector<Long64_t>& clusterEnds, const Long64_t& last, 
+                              std::vector<EntryTask>& tasks) const {
+    const Long64_t period = ( fSamplingStep > 1 ) ? fSamplingStep * fSamplingBlockSize : 1;
+    const Long64_t origin = ( fSamplingOrigin < 0 ) ? fFirstEntry : fSamplingOrigin;
+    Long64_t taskFirst = fFirstEntry;
+    for (const auto clusterEnd : clusterEnds) {
+        Long64_t taskLast = ( clusterEnd >= last ) ? last : 
+                            origin + floorDivide( clusterEnd - origin, period ) * period;
+        if ( taskLast > taskFirst ) {
+            tasks.push_back( EntryTask{ taskFirst, taskLast } );
+            taskFirst = taskLast;
+        }
+    }
+    // Files may be shorter than the chain says
+    if ( taskFirst < last ) {
+        tasks.push_back( EntryTask{ taskFirst, last } );
+    }
+}
+
+//_________________
+void BaseReader::chainClusterEnds(TChain *chain, const Long64_t& first, const Long64_t& last, 
+                                  std::vector<Long64_t>& clusterEnds) {
+    if ( !chain ) return;
+    Long64_t entry = first;
+    while ( entry < last ) {
+        Long64_t localEntry = chain->LoadTree( entry );
+        TTree *tree = chain->GetTree();
+        if ( localEntry < 0 || !tree ) break;
+        const Long64_t offset = entry - localEntry;
+
+        // Loop over clusters of the file
+        TTree::TClusterIterator clusterIter = tree->GetClusterIterator( localEntry );
+        Long64_t clusterStart{0};
+        while ( ( clusterStart = clusterIter() ) < tree->GetEntries() && offset + clusterStart < last ) {
+            clusterEnds.push_back( std::min( offset + clusterIter.GetNextEntry(), last ) );
+        }
+        entry = offset + tree->GetEntries();
+    }
+}
+
+//_________________
+void BaseReader::fileClusterEnds(TChain *chain, TChain *offsetChain, const Long64_t& first, const Long64_t& last, 
+                                 std::vector<Long64_t>& clusterEnds) {
+    if ( !chain || !offsetChain ) return;
+    // Files added with their numbers of entries (or counted already) have known boundaries:
+    // tasks of the small files are made without opening them
+    const Long64_t *offsets = offsetChain->GetTreeOffset();
+    TObjArray *files = offsetChain->GetListOfFiles();
+    for (int iFile{0}; iFile<offsetChain->GetNtrees(); iFile++) {
+        const Long64_t fileFirst = offsets[iFile];
+        if ( fileFirst >= last ) break;
+        if ( offsets[iFile + 1] == TTree::kMaxEntries ) {
+            chainClusterEnds( chain, std::max( fileFirst, first ), last, clusterEnds );
+            return;
+        }
+        if ( offsets[iFile + 1] <= first ) continue;
+        const Long64_t start = std::max( fileFirst, first );
+        const Long64_t end = std::min( offsets[iFile + 1], last );
+
+        if ( end - start > kFileTaskEntries ) {
+            TFile *file = TFile::Open( files->At(iFile)->GetTitle() );
+            TTree *tree = ( file && !file->IsZombie() ) ? dynamic_cast<TTree*>( file->Get( chain->GetName() ) ) : nullptr;
+            if ( tree ) {
+                TTree::TClusterIterator clusterIter = tree->GetClusterIterator( start - fileFirst );
+                Long64_t clusterStart{0};
+                while ( ( clusterStart = clusterIter() ) < tree->GetEntries() && fileFirst + clusterStart < end ) {
+                    clusterEnds.push_back( std::min( fileFirst + clusterIter.GetNextEntry(), end ) );
+                }
+            }
+            delete file;
+        }
+        // Task never spans two files
+        clusterEnds.push_back( end );
+    }
+}
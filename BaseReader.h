@@ -18,9 +18,18 @@
 
 // JetAnalysis headers
 #include "Event.h"
+#include "InputRequirements.h"
+#include "JetBatch.h"
+#include "StageStats.h"
+#include "TaskScheduler.h"
 
 // C++ headers
 #include <iostream>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class TChain;
 
 //_________________
 class BaseReader {
@@ -34,9 +43,21 @@ class BaseReader {
     /// @return Instance of Event class
     virtual Event* returnEvent() = 0;
 
+    /// @brief Read jets of the next nEvents entries into the columns of the batch (the
+    /// batch is cleared first). No corrections and no event selection are applied
+    /// @return Number of events read (0 - end of input or batches are not supported)
+    virtual Long64_t readBatch(JetBatch& batch, const Long64_t& nEvents) { (void)nEvents; batch.clear(); return 0; }
+
+    /// @brief Give back the event returned by returnEvent() when it is no longer needed.
+    /// Readers may reuse it for the next events
+    virtual void recycleEvent(Event *event) { delete event; }
+
     /// @brief Initialize event reader
     /// @return Base return function
     virtual Int_t init()  { std::cout << "BaseReader::init() - Do nothing\n"; return 0; }
+    /// @brief Prepare input shared by the processes (e.g. validate the input files). Called by the
+    /// manager before the processes are forked: the forked readers reuse the result in init()
+    virtual void prepareInput() { /* empty */ }
 
     /// @brief Finish reading
     virtual void finish() { /* empty*/ }
@@ -48,11 +69,120 @@ class BaseReader {
     /// @brief Report reader status including cuts
     virtual void report();
 
+    /// @brief Return number of events to be read (within the entry range)
     virtual Long64_t nEventsTotal() const { return 0; }
+    /// @brief Return number of entries in the whole input (ignoring the entry range)
+    virtual Long64_t nEntriesInChain() const { return nEventsTotal(); }
+
+    /// @brief Read only entries [first, last). Negative last means till the end of input
+    virtual void setEntryRange(const Long64_t& first, const Long64_t& last = -1) { fFirstEntry = first; fLastEntry = last; }
+    /// @brief Return first entry to be read
+    Long64_t firstEntry() const { return fFirstEntry; }
+    /// @brief Return last entry to be read (excluded). Negative value means the end of input
+    Long64_t lastEntry() const  { return fLastEntry; }
+
+    /// @brief Set stats where time spent in the reading stages is stored (nullptr - no timing)
+    virtual void setStageStats(StageStats *stats) { fStageStats = stats; }
+
+    /// @brief Return number of entries in the entry range (before sampling)
+    virtual Long64_t nEntriesInRange() const { return nEventsTotal(); }
+    /// @brief Return chain entry of the iEvent-th event to be read (sampled blocks only)
+    virtual Long64_t entryNumber(const Long64_t& iEvent) const;
+
+    /// @brief Read only the first of every step blocks of blockSize consecutive entries.
+    /// Block size close to the TTree cluster size avoids reading unused baskets
+    virtual void setSampling(const Long64_t& step, const Long64_t& blockSize = 1) 
+    { fSamplingStep = (step < 1) ? 1 : step; fSamplingBlockSize = (blockSize < 1) ? 1 : blockSize; }
+    /// @brief Return sampling step
+    Long64_t samplingStep() const      { return fSamplingStep; }
+    /// @brief Return sampling block size
+    Long64_t samplingBlockSize() const { return fSamplingBlockSize; }
+    /// @brief Set entry where the sampling blocks start (negative - first entry of the range before
+    /// the shard split). Later range, shard, process and task splits do not move the blocks
+    virtual void setSamplingOrigin(const Long64_t& entry = -1) { fSamplingOrigin = entry; }
+    /// @brief Return entry where the sampling blocks start (negative - not set yet)
+    virtual Long64_t samplingOrigin() const { return fSamplingOrigin; }
+
+    /// @brief Split the entry range into tasks processed by the threads (default: a single task)
+    virtual void entryTasks(std::vector<EntryTask>& tasks) const
+    { tasks.push_back( EntryTask{ fFirstEntry, fFirstEntry + nEntriesInRange() } ); }
+    /// @brief Read entries of the task: the entry range is replaced by [task.first, task.last)
+    virtual void startTask(const EntryTask& task) { setEntryRange(task.first, task.last); }
+
+    /// @brief Read only shard index (0 <= index < nShards) of nShards equal parts of the entry range
+    virtual void setShard(const int& index, const int& nShards);
+    /// @brief Return shard index
+    int shardIndex() const { return fShardIndex; }
+    /// @brief Return number of shards
+    int nShards() const    { return fNShards; }
+
+    /// @brief Set input quantities required by the analyses. Must be called before init().
+    /// Readers may skip reading of the rest (default: everything is read)
+    virtual void setRequiredInputs(const InputRequirements& inputs) { fRequiredInputs = inputs; }
+    /// @brief Return input quantities required by the analyses
+    const InputRequirements& requiredInputs() const { return fRequiredInputs; }
+
+    /// @brief Events are queued (read-ahead) and used after the next entries are read.
+    /// Readers must not leave references to their buffers in such events
+    virtual void setEventsAreQueued(const bool& queued = true) { fEventsAreQueued = queued; }
+    /// @brief Return true if events are used after the next entries are read
+    bool eventsAreQueued() const { return fEventsAreQueued; }
+
+    /// @brief Add files the events depend on (input and calibration files) and the reader
+    /// settings that change them (after init()). Used as the key of caches of the reader output
+    virtual void cacheKey(std::vector<std::string>& files, std::string& settings) const { (void)files; (void)settings; }
+    /// @brief Return true if events carry content that is not kept by JetCache
+    /// (tracks, jet collections other than the main reco one)
+    virtual bool hasUncachedContent() const { return false; }
 
   protected:
+    /// @brief Keep the entry range inside [0, nEntries) and take the shard of it. The shard
+    /// becomes the new entry range, so it is applied only once
+    /// @return End of the entry range (excluded)
+    Long64_t resolveEntryRange(const Long64_t& nEntries);
+    /// @brief Number of entries read from nEntries entries starting at the first entry of the range
+    Long64_t nSampledEntries(const Long64_t& nEntries) const;
+    /// @brief Entry is in a block read with the current sampling
+    bool isSampledEntry(const Long64_t& entry) const
+    { return ( fSamplingStep <= 1 || nSampledBefore( entry + 1 ) > nSampledBefore( entry ) ); }
+    /// @brief Number of sampled entries between the sampling origin and the entry (negative before the origin)
+    Long64_t nSampledBefore(const Long64_t& entry) const;
+    /// @brief Split [fFirstEntry, last) into tasks ending at the cluster ends. Task boundaries are
+    /// moved to the beginning of the sampling blocks: sampled entries do not depend on the split
+    void clusterTasks(const std::vector<Long64_t>& clusterEnds, const Long64_t& last, std::vector<EntryTask>& tasks) const;
+    /// @brief Add ends of the clusters of the chain trees in [first, last) (the trees are loaded)
+    static void chainClusterEnds(TChain *chain, const Long64_t& first, const Long64_t& last, std::vector<Long64_t>& clusterEnds);
+    /// @brief Add ends of the files of the offset chain in [first, last). Only files with more than
+    /// kFileTaskEntries entries in the range are opened to add ends of the clusters of the chain tree.
+    /// Falls back to chainClusterEnds() if the file boundaries are not known
+    static void fileClusterEnds(TChain *chain, TChain *offsetChain, const Long64_t& first, const Long64_t& last,
+                                std::vector<Long64_t>& clusterEnds);
+
+    /// @brief Files with more entries than this are split into tasks at their clusters
+    static constexpr Long64_t kFileTaskEntries{100000};
+
     /// @brief Reader status. 0 - good, 1 - error, 2 - EOF
     Int_t fReaderStatus;
+    /// @brief First entry to read
+    Long64_t fFirstEntry;
+    /// @brief Last entry to read (excluded). Negative value means the end of input
+    Long64_t fLastEntry;
+    /// @brief Shard index to read
+    int fShardIndex;
+    /// @brief Number of shards the entry range is split into
+    int fNShards;
+    /// @brief Sampling step: every step-th block of entries is read
+    Long64_t fSamplingStep;
+    /// @brief Number of consecutive entries in the sampling block
+    Long64_t fSamplingBlockSize;
+    /// @brief Entry where the sampling blocks start
+    Long64_t fSamplingOrigin;
+    /// @brief Time spent in the reading stages (not owned)
+    StageStats *fStageStats; //!
+    /// @brief Input quantities required by the analyses
+    InputRequirements fRequiredInputs; //!
+    /// @brief Events are used after the next entries are read
+    bool fEventsAreQueued;
 
     ClassDef(BaseReader, 0)
 };
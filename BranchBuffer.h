@@ -0,0 +1,47 @@
+/**
+ * @file BranchBuffer.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Array read from a variable-length branch. The size follows the input
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef BranchBuffer_h
+#define BranchBuffer_h
+
+// C++ headers
+#include <cstddef>
+#include <memory>
+
+//________________
+template <typename T>
+class BranchBuffer {
+  public:
+    /// @brief Constructor
+    BranchBuffer() = default;
+
+    /// @brief Allocate n zero-initialized elements. Previous content is lost and
+    /// the branch address must be set again
+    void allocate(const size_t& n) { fData.reset( new T[n]() ); fSize = n; }
+
+    /// @brief Number of elements
+    size_t size() const { return fSize; }
+    /// @brief Pointer to the first element (branch address)
+    T *data() { return fData.get(); }
+    const T *data() const { return fData.get(); }
+
+    /// @brief Element access
+    T& operator[](const size_t& i) { return fData[i]; }
+    const T& operator[](const size_t& i) const { return fData[i]; }
+
+  private:
+    /// @brief Elements
+    std::unique_ptr<T[]> fData{};
+    /// @brief Number of elements
+    size_t fSize{0};
+};
+
+#endif // #define BranchBuffer_h
@@ -14,6 +14,7 @@
 #include "TVector3.h"
 #include "TLorentzVector.h"
 #include "TROOT.h"
+#include "TDirectory.h"
 #include "TMath.h"
 
 // C++ headers
@@ -43,7 +44,8 @@ DiJetAnalysis::DiJetAnalysis() : BaseAnalysis(),
     fRecoIdLead{-1}, fRecoIdSubLead{-1}, fGenIdLead{-1}, fGenIdSubLead{-1}, fRefSelRecoIdLead{-1}, fRefSelRecoIdSubLead{-1},
     fRecoPtSortedJetIds{}, fGenPtSortedJetIds{}, fRefSelRecoPtSortedJetIds{},
     fRecoDijet{nullptr}, fGenDijet{nullptr}, fRefDijet{nullptr},
-    fRecoJetCut{nullptr}, fGenJetCut{nullptr}, fDiJetCut{nullptr} {
+    fRecoJetCut{nullptr}, fGenJetCut{nullptr}, fDiJetCut{nullptr},
+    fJetCollectionName{}, fRecoJets{nullptr}, fGenJets{nullptr} {
 
     fPtHatRange[0] = {0};
     fPtHatRange[1] = {100000000};
@@ -257,7 +259,8 @@ void DiJetAnalysis::print() {
               << "Collision energy (GeV)      : " << fCollisionEnergy << std::endl
               << "Is Pb-going direction       : " << fIsPbGoingDir << std::endl
               << "eta shift                   : " << fEtaShift << std::endl
-              << "ptHat range                 : " << fPtHatRange[0] << "-" << fPtHatRange[1] << std::endl;
+              << "ptHat range                 : " << fPtHatRange[0] << "-" << fPtHatRange[1] << std::endl
+              << "Jet collection              : " << ( fJetCollectionName.empty() ? "main" : fJetCollectionName.c_str() ) << std::endl;
               if ( fRecoJetCut ) {
                   std::cout << "Reco jet cut parameters     : " << std::endl;
                   fRecoJetCut->report();
@@ -475,9 +478,9 @@ void DiJetAnalysis::makePtSortedJetVectors(const Event* event) {
 
     // Jet counter
     int recoJetCounter{0};
-    // std::cout << "Reco jet collection size: " << event->recoJetCollection()->size() << std::endl;
+    // std::cout << "Reco jet collection size: " << fRecoJets->size() << std::endl;
     // Loop over reconstructed jets and store indices of good jets
-    for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ ) {
+    for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ ) {
 
         recoJetCounter++;
 
@@ -485,17 +488,17 @@ void DiJetAnalysis::makePtSortedJetVectors(const Event* event) {
         if ( fRecoJetCut && !fRecoJetCut->pass(*recoJetIter, false, true, false) ) continue; 
 
         fRecoPtSortedJetIds.push_back( recoJetCounter-1 );
-    } // for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ )
+    } // for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ )
 
     // Sort indices based on the jet corrected pT (from high to low)
         std::sort( fRecoPtSortedJetIds.begin(), fRecoPtSortedJetIds.end(), [&](int i, int j) { 
-            return event->recoJetCollection()->at(i)->ptJECCorr() > event->recoJetCollection()->at(j)->ptJECCorr(); 
+            return fRecoJets->at(i)->ptJECCorr() > fRecoJets->at(j)->ptJECCorr(); 
     } );
 
     if ( fVerbose ) {
         // Print sorted indices and corresponding jet pT    
         for (const auto& id : fRecoPtSortedJetIds) {
-            std::cout << Form("Sorted reco jet index: %d | pT: %5.1f eta: %3.2f\n", id, event->recoJetCollection()->at(id)->ptJECCorr(), etaLab(event->recoJetCollection()->at(id)->eta()));
+            std::cout << Form("Sorted reco jet index: %d | pT: %5.1f eta: %3.2f\n", id, fRecoJets->at(id)->ptJECCorr(), etaLab(fRecoJets->at(id)->eta()));
         }
     }
 
@@ -521,24 +524,24 @@ void DiJetAnalysis::makePtSortedJetVectors(const Event* event) {
 
         int genJetCounter{0};
         // Loop over generated jets and store indices of good jets
-        for ( genJetIter = event->genJetCollection()->begin(); genJetIter != event->genJetCollection()->end(); genJetIter++ ) {
+        for ( genJetIter = fGenJets->begin(); genJetIter != fGenJets->end(); genJetIter++ ) {
             genJetCounter++;
 
             // Check gen jet passes the selection criteria (*genJet, isCM)
             if ( fGenJetCut && !fGenJetCut->pass(*genJetIter, false) ) continue;
 
             fGenPtSortedJetIds.push_back( genJetCounter-1 );
-        } // for ( genJetIter = event->genJetCollection()->begin(); genJetIter != event->genJetCollection()->end(); genJetIter++ )
+        } // for ( genJetIter = fGenJets->begin(); genJetIter != fGenJets->end(); genJetIter++ )
 
         // Sort indices based on the jet pT (from high to low)
         std::sort( fGenPtSortedJetIds.begin(), fGenPtSortedJetIds.end(), [&](int i, int j) { 
-            return event->genJetCollection()->at(i)->pt() > event->genJetCollection()->at(j)->pt(); 
+            return fGenJets->at(i)->pt() > fGenJets->at(j)->pt(); 
         } );
 
         if ( fVerbose ) {
             // Print sorted indices and corresponding jet pT
             for (const auto& id : fGenPtSortedJetIds) {
-                std::cout << Form("Sorted gen jet index: %d | pT: %5.1f eta: %3.2f\n", id, event->genJetCollection()->at(id)->pt(), etaLab(event->genJetCollection()->at(id)->eta()));
+                std::cout << Form("Sorted gen jet index: %d | pT: %5.1f eta: %3.2f\n", id, fGenJets->at(id)->pt(), etaLab(fGenJets->at(id)->eta()));
             }
         }
 
@@ -558,24 +561,24 @@ void DiJetAnalysis::makePtSortedJetVectors(const Event* event) {
 
         int refSelRecoJetCounter{0};
         // Loop over reconstructed jets and select those only that have matching gen jets
-        for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ ) {
+        for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ ) {
             refSelRecoJetCounter++;
 
             // Check selection criteria (*recoJet, isCM, isMC, requireMatching)
             if ( fRecoJetCut && !fRecoJetCut->pass(*recoJetIter, false, true, true) ) continue;
 
             fRefSelRecoPtSortedJetIds.push_back( refSelRecoJetCounter-1 );
-        } // for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ )
+        } // for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ )
 
         // Sort indices based on the gen jet pT from the reco matched jets (from high to low)
         std::sort( fRefSelRecoPtSortedJetIds.begin(), fRefSelRecoPtSortedJetIds.end(), [&](int i, int j) { 
-            return event->genJetCollection()->at( event->recoJetCollection()->at(i)->genJetId() )->pt() > event->genJetCollection()->at( event->recoJetCollection()->at(j)->genJetId() )->pt(); 
+            return fGenJets->at( fRecoJets->at(i)->genJetId() )->pt() > fGenJets->at( fRecoJets->at(j)->genJetId() )->pt(); 
         } );
 
         if ( fVerbose ) {
             // Print sorted indices and corresponding gen jet pT
             for (const auto& id : fRefSelRecoPtSortedJetIds) {
-                std::cout << Form("Sorted ref-selected reco jet index: %d | gen pT: %5.1f | reco pT: %5.1f\n", id, event->genJetCollection()->at( event->recoJetCollection()->at(id)->genJetId() )->pt(), event->recoJetCollection()->at(id)->ptJECCorr());
+                std::cout << Form("Sorted ref-selected reco jet index: %d | gen pT: %5.1f | reco pT: %5.1f\n", id, fGenJets->at( fRecoJets->at(id)->genJetId() )->pt(), fRecoJets->at(id)->ptJECCorr());
             }
         }
 
@@ -602,12 +605,12 @@ void DiJetAnalysis::processInclusiveJets(const Event* event, const double& weigh
         std::cout << "DiJetAnalysis::processInclusiveJets -- begin" << std::endl;
     }
 
-    fHM->hRecoJetCollectionSize->Fill( event->recoJetCollection()->size(), 1. );
+    fHM->hRecoJetCollectionSize->Fill( fRecoJets->size(), 1. );
     processRecoJets( event, weight );
 
     if ( fIsMc ) {
-        fHM->hGenJetCollectionSize->Fill( event->genJetCollection()->size(), 1. );
-        fHM->hGenVsRecoJetCollectionSize->Fill( event->recoJetCollection()->size(), event->genJetCollection()->size(), 1. );
+        fHM->hGenJetCollectionSize->Fill( fGenJets->size(), 1. );
+        fHM->hGenVsRecoJetCollectionSize->Fill( fRecoJets->size(), fGenJets->size(), 1. );
         processGenJets( event, weight );
         processRefJets( event, weight );
     } // if ( fIsMc )
@@ -635,7 +638,7 @@ void DiJetAnalysis::processRecoJets(const Event* event, const double &weight) {
     int recoJetCounter{0};
 
     // Loop over reconstructed jets
-    for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ ) {
+    for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ ) {
 
         float pt = (*recoJetIter)->ptJECCorr();
         float eta = etaLab( (*recoJetIter)->eta() );
@@ -744,7 +747,7 @@ void DiJetAnalysis::processRecoJets(const Event* event, const double &weight) {
             // If reco jet has matching to gen jet
             if ( (*recoJetIter)->hasMatching() ) {
 
-                GenJet *matchedJet = event->genJetCollection()->at( (*recoJetIter)->genJetId() );
+                GenJet *matchedJet = fGenJets->at( (*recoJetIter)->genJetId() );
                 if ( !matchedJet ) {
                     std::cerr << Form("Cannot retrieve gen jet with id: %d", (*recoJetIter)->genJetId() ) << std::endl;
                     continue;
@@ -854,7 +857,7 @@ void DiJetAnalysis::processRecoJets(const Event* event, const double &weight) {
                 }
             } // else
         } // if ( fIsMc )
-    } // for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ )
+    } // for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ )
 
     if ( fVerbose ) {
         std::cout << Form("Reco jet idLead: %d  idSubLead: %d\n", fRecoIdLead, fRecoIdSubLead);
@@ -876,10 +879,10 @@ void DiJetAnalysis::processGenJets(const Event* event, const double &weight) {
 
     // Jet counter
     int genJetCounter{0};
-    if ( event->genJetCollection()->size() > 0 ) {
+    if ( fGenJets->size() > 0 ) {
 
         // Loop over generated jets and search for Lead and SubLead jets
-        for ( genJetIter = event->genJetCollection()->begin(); genJetIter != event->genJetCollection()->end(); genJetIter++ ) {
+        for ( genJetIter = fGenJets->begin(); genJetIter != fGenJets->end(); genJetIter++ ) {
 
             float pt = (*genJetIter)->pt();
             float eta = etaLab( (*genJetIter)->eta() );
@@ -931,8 +934,8 @@ void DiJetAnalysis::processGenJets(const Event* event, const double &weight) {
                 fHM->hGenGoodInclusiveJetEtaCMFrame->Fill( etaCM, weight );
             }
 
-        } // for ( genJetIter = event->genJetCollection()->begin(); genJetIter != event->genJetCollection()->end(); genJetIter++ )
-    } // if ( event->genJetCollection()->size() > 0 )
+        } // for ( genJetIter = fGenJets->begin(); genJetIter != fGenJets->end(); genJetIter++ )
+    } // if ( fGenJets->size() > 0 )
 
     if ( fVerbose ) {
         std::cout << Form("Gen jet idLead: %d  idSubLead: %d\n", fGenIdLead, fGenIdSubLead);
@@ -955,10 +958,10 @@ void DiJetAnalysis::processRefJets(const Event* event, const double &weight) {
 
     // Jet counter
     int refSelJetCounter{0};
-    if ( event->recoJetCollection()->size() > 0 ) {
+    if ( fRecoJets->size() > 0 ) {
 
         // Loop over reconstructed jets and search for Lead and SubLead gen-matched jets
-        for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ ) {
+        for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ ) {
 
             refSelJetCounter++;
 
@@ -966,7 +969,7 @@ void DiJetAnalysis::processRefJets(const Event* event, const double &weight) {
             if ( fRecoJetCut && !fRecoJetCut->pass(*recoJetIter, false, true, true) ) continue; 
 
             // Retrieve matched gen jet
-            GenJet *matchedJet = event->genJetCollection()->at( (*recoJetIter)->genJetId() );
+            GenJet *matchedJet = fGenJets->at( (*recoJetIter)->genJetId() );
             float genPt = matchedJet->pt();
             float genEta = etaLab( matchedJet->eta() );
             float genEtaCM = boostEta2CM( matchedJet->eta() );
@@ -994,8 +997,8 @@ void DiJetAnalysis::processRefJets(const Event* event, const double &weight) {
                 fHM->hRefSelSubLeadJetPtEta->Fill(genEta, genPt, weight );
                 fHM->hRefSelSubLeadJetPtEtaPtHat->Fill(genEta, genPt, ptHat, weight );
             }
-        } // for ( recoJetIter = event->recoJetCollection()->begin(); recoJetIter != event->recoJetCollection()->end(); recoJetIter++ )
-    } // if ( event->recoJetCollection()->size() > 0 )
+        } // for ( recoJetIter = fRecoJets->begin(); recoJetIter != fRecoJets->end(); recoJetIter++ )
+    } // if ( fRecoJets->size() > 0 )
     
     if ( fVerbose ) {
         std::cout << Form("Ref-selected reco jet idLead: %d  idSubLead: %d\n", fRefSelRecoIdLead, fRefSelRecoIdSubLead);
@@ -1020,8 +1023,8 @@ bool DiJetAnalysis::isOverweightedEvent(const Event* event, const double& weight
     // Process reco jets in order to remove x-jets
     //
     if ( fRecoIdLead >= 0 && fRecoIdSubLead >= 0 ) {
-        RecoJet *recoLeadJet = event->recoJetCollection()->at( fRecoIdLead );
-        RecoJet *recoSubLeadJet = event->recoJetCollection()->at( fRecoIdSubLead );
+        RecoJet *recoLeadJet = fRecoJets->at( fRecoIdLead );
+        RecoJet *recoSubLeadJet = fRecoJets->at( fRecoIdSubLead );
         
         float ptRecoLead = recoLeadJet->pt();
         float ptRecoSubLead = recoSubLeadJet->pt();
@@ -1104,13 +1107,13 @@ void DiJetAnalysis::processGenDijets(const Event* event, const double &weight) {
         return;
     } 
 
-    GenJet* leadJet = event->genJetCollection()->at( fGenIdLead );
+    GenJet* leadJet = fGenJets->at( fGenIdLead );
     float ptGenLead = leadJet->pt();
     float phiGenLead = leadJet->phi();
     float etaGenLeadLab = etaLab( leadJet->eta() );
     float etaGenLeadCM = boostEta2CM( leadJet->eta() );
 
-    GenJet* subLeadJet = event->genJetCollection()->at( fGenIdSubLead );
+    GenJet* subLeadJet = fGenJets->at( fGenIdSubLead );
     float ptGenSubLead = subLeadJet->pt();
     float phiGenSubLead = subLeadJet->phi();
     float etaGenSubLeadLab = etaLab( subLeadJet->eta() );
@@ -1358,7 +1361,7 @@ void DiJetAnalysis::processRecoDijets(const Event* event, const double &weight)
     unsigned int runId = event->runId();
 
     // Lead jet
-    RecoJet* recoLeadJet = event->recoJetCollection()->at( fRecoIdLead );
+    RecoJet* recoLeadJet = fRecoJets->at( fRecoIdLead );
     float ptRawRecoLead = recoLeadJet->rawPt();
     float ptRecoLead = recoLeadJet->ptJECCorr();
     float etaRecoLeadLab = etaLab( recoLeadJet->eta() );
@@ -1366,7 +1369,7 @@ void DiJetAnalysis::processRecoDijets(const Event* event, const double &weight)
     float phiRecoLead = recoLeadJet->phi();
 
     // SubLead jet
-    RecoJet* recoSubLeadJet = event->recoJetCollection()->at( fRecoIdSubLead );
+    RecoJet* recoSubLeadJet = fRecoJets->at( fRecoIdSubLead );
     float ptRawRecoSubLead = recoSubLeadJet->rawPt();
     float ptRecoSubLead = recoSubLeadJet->ptJECCorr();
     float etaRecoSubLeadLab = etaLab( recoSubLeadJet->eta() );
@@ -1454,8 +1457,8 @@ void DiJetAnalysis::processRecoDijets(const Event* event, const double &weight)
         // // Lead and SubLead jets must have matching gen jets (just a protection, easy to comment out)
         // if ( !recoLeadJet->hasMatching() || !recoSubLeadJet->hasMatching() ) {
         //     // if ( fVerbose ) {
-        //         GenJet* genLeadJet = event->genJetCollection()->at( fGenIdLead );
-        //         GenJet* genSubLeadJet = event->genJetCollection()->at( fGenIdSubLead );
+        //         GenJet* genLeadJet = fGenJets->at( fGenIdLead );
+        //         GenJet* genSubLeadJet = fGenJets->at( fGenIdSubLead );
         //         std::cerr << Form("[ERROR] Unmatched dijet idLead: %d idSubLead: %d Lead matched: %s SubLead matched: %s - Skip\n", 
         //                         fRecoIdLead, fRecoIdSubLead, 
         //                         (recoLeadJet->hasMatching() ? "[true]" : "[false]"), 
@@ -1467,12 +1470,12 @@ void DiJetAnalysis::processRecoDijets(const Event* event, const double &weight)
         //         std::cerr << std::endl;
         //             std::cerr << "Sorted reco jets (id, ptCorr, ptRaw, eta, matched):" << std::endl;
         //             for (const auto& id : fRecoPtSortedJetIds) {
-        //                 RecoJet* jet = event->recoJetCollection()->at(id);
+        //                 RecoJet* jet = fRecoJets->at(id);
         //                 std::cerr << Form("-->  id: %d, ptCorr: %5.2f, ptRaw: %5.2f, eta: %3.2f matched: %s", jet->id(), jet->ptJECCorr(), jet->pt(), etaLab(jet->eta()), (jet->hasMatching() ? "[true]" : "[false]")) << std::endl;
         //             }
         //             std::cerr << "Sorted gen jets (id, pt, eta):" << std::endl;
         //             for (const auto& id : fGenPtSortedJetIds) {
-        //                 GenJet* jet = event->genJetCollection()->at(id);
+        //                 GenJet* jet = fGenJets->at(id);
         //                 std::cerr << Form("-->  id: %d, pt: %5.2f, eta: %3.2f", jet->id(), jet->pt(), etaLab(jet->eta())) << std::endl;
         //             }
         //     // }
@@ -1481,7 +1484,7 @@ void DiJetAnalysis::processRecoDijets(const Event* event, const double &weight)
 
         if ( recoLeadJet->hasMatching() ) {
             // Matching gen jet for Lead reco jet
-            refLeadJet = event->genJetCollection()->at( recoLeadJet->genJetId() );
+            refLeadJet = fGenJets->at( recoLeadJet->genJetId() );
             if ( !refLeadJet ) {
                 std::cerr << "Error: Lead jet has no matching gen jet\n";
                 return;
@@ -1495,7 +1498,7 @@ void DiJetAnalysis::processRecoDijets(const Event* event, const double &weight)
         
         if ( recoSubLeadJet->hasMatching() ) {
             // Matching gen jet for SubLead reco jet
-            refSubLeadJet = event->genJetCollection()->at( recoSubLeadJet->genJetId() );
+            refSubLeadJet = fGenJets->at( recoSubLeadJet->genJetId() );
             if ( !refSubLeadJet ) {
                 std::cerr << "Error: SubLead jet has no matching gen jet\n";
                 return;
@@ -1879,10 +1882,10 @@ void DiJetAnalysis::processRefDijets(const Event* event, const double &weight) {
     }
 
     // Retrieve Lead and SubLead jets
-    RecoJet *recoLeadJet = event->recoJetCollection()->at( fRefSelRecoIdLead );
-    RecoJet *recoSubLeadJet = event->recoJetCollection()->at( fRefSelRecoIdSubLead );
-    GenJet *refLeadJet = event->genJetCollection()->at( recoLeadJet->genJetId() );
-    GenJet *refSubLeadJet = event->genJetCollection()->at( recoSubLeadJet->genJetId() );
+    RecoJet *recoLeadJet = fRecoJets->at( fRefSelRecoIdLead );
+    RecoJet *recoSubLeadJet = fRecoJets->at( fRefSelRecoIdSubLead );
+    GenJet *refLeadJet = fGenJets->at( recoLeadJet->genJetId() );
+    GenJet *refSubLeadJet = fGenJets->at( recoSubLeadJet->genJetId() );
 
     // Retrieve kinematic information for reference Lead and SubLead jets, dijets
     float ptRefLead = refLeadJet->pt();
@@ -2116,6 +2119,15 @@ void DiJetAnalysis::processEvent(const Event* event) {
     fGenPtSortedJetIds.clear();
     fRefSelRecoPtSortedJetIds.clear();
 
+    // Reco jets of the analyzed collection
+    fRecoJets = event->recoJetCollection( fJetCollectionName );
+    fGenJets = event->genJetCollection( fJetCollectionName );
+    if ( !fRecoJets || !fGenJets ) {
+        std::cerr << Form("[ERROR] DiJetAnalysis::processEvent - jet collection %s is not read. Terminating\n",
+                          fJetCollectionName.c_str());
+        exit(1);
+    }
+
     //
     // Event quantities
     //
@@ -2254,6 +2266,22 @@ void DiJetAnalysis::finish() {
     std::cout << "DiJetAnalysis::finish" << std::endl;
 }
 
+//________________
+void DiJetAnalysis::writeOutput() {
+    if ( !fHM ) return;
+    // Histograms of other jet collections go to the directory named after the collection
+    if ( fJetCollectionName.empty() ) {
+        fHM->writeOutput();
+        return;
+    }
+    TDirectory *current = gDirectory;
+    TDirectory *dir = current->GetDirectory( fJetCollectionName.c_str() );
+    if ( !dir ) dir = current->mkdir( fJetCollectionName.c_str() );
+    dir->cd();
+    fHM->writeOutput();
+    current->cd();
+}
+
 //________________
 void DiJetAnalysis::report() {
     // Force to report everyone
@@ -2266,3 +2294,14 @@ TList* DiJetAnalysis::getOutputList() {
     // Add list of settings for cuts
     return outputList;
 }
+
+//________________
+void DiJetAnalysis::addRequiredInputs(InputRequirements& inputs) const {
+    // Jet kinematics and event quantities are always read.
+    // Inclusive jet histograms use PF fractions and multiplicities
+    inputs.requireJetContent( InputRequirements::kJetPFFractions | 
+                              InputRequirements::kJetPFMultiplicities );
+    // Jet cuts of the analysis (e.g. trackMax/rawPt selection)
+    if ( fRecoJetCut ) fRecoJetCut->addRequiredInputs( inputs );
+    if ( fGenJetCut ) fGenJetCut->addRequiredInputs( inputs );
+}
@@ -28,6 +28,7 @@
 // C++ headers
 #include <vector>
 #include <map>
+#include <string>
 
 // Forward declarations
 class JetCut;
@@ -47,11 +48,15 @@ class DiJetAnalysis : public BaseAnalysis {
     void processEvent(const Event* ev);
     /// @brief Finish analysis
     void finish();
+    /// @brief Write histograms to the current directory
+    void writeOutput();
 
     /// @brief Returns reports of all cuts applied and correlation functions being done
     virtual void report();
     /// @brief Return a TList of objects to be written as output
     virtual TList* getOutputList();
+    /// @brief Add input quantities used by the analysis (PF jet composition)
+    virtual void addRequiredInputs(InputRequirements& inputs) const;
 
     /// @brief Add histogram manager to the analysis
     void addHistoManager(HistoManagerDiJet *hm) { fHM = hm; }
@@ -80,6 +85,9 @@ class DiJetAnalysis : public BaseAnalysis {
     void setGenJetCut(JetCut *cut)  { fGenJetCut = cut; }
     /// @brief Set dijet cut
     void setDiJetCut(DiJetCut *cut)   { fDiJetCut = cut; }
+    /// @brief Analyze reco jet collection with the given name (jet tree name, e.g. ak4PFJetAnalyzer).
+    /// Empty name - the main collection of the reader (default)
+    void setJetCollectionName(const char *name) { fJetCollectionName = name; }
 
     /// @brief Reweight MC to data (trigger-dependent): 
     /// 0 - do not reweight (default)
@@ -205,6 +213,13 @@ class DiJetAnalysis : public BaseAnalysis {
     JetCut *fGenJetCut;
     DiJetCut *fDiJetCut;
 
+    /// @brief Name of the analyzed reco jet collection (empty - main collection)
+    std::string fJetCollectionName;
+    /// @brief Reco jets of the analyzed collection in the current event
+    RecoJetCollection *fRecoJets; //!
+    /// @brief Generated jets of the analyzed collection (reco jets are matched to them)
+    GenJetCollection *fGenJets; //!
+
   ClassDef(DiJetAnalysis, 0)
 };
 
@@ -0,0 +1,385 @@
+/**
+ * @file DiJetTreeReader.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Reader of the slim calibrated dijet tree written by DiJetTreeWriter
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "DiJetTreeReader.h"
+
+// ROOT headers
+#include "TLeaf.h"
+#include "TTree.h"
+
+// C++ headers
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+//_________________
+DiJetTreeReader::DiJetTreeReader() : DiJetTreeReader("", "dijetTree") {
+    /* empty */
+}
+
+//_________________
+DiJetTreeReader::DiJetTreeReader(const char *inputStream, const char *treeName) : BaseReader(),
+    fEvent{nullptr}, fEventPool{nullptr}, fInFileName{inputStream}, fTreeName{treeName}, fJetCollectionName{},
+    fChain{nullptr}, fBufferTreeNumber{-1},
+    fEntriesInChain{0}, fEntriesInRange{0}, fEvents2Read{0}, fEventsProcessed{0},
+    fEventCut{nullptr}, fJetCut{nullptr}, fVerbose{false}, fReadPFContent{false}, fReadWTAAxes{false}, fReadFlavor{false},
+    fRunId{0}, fLumi{0}, fEventId{0}, fVz{0}, fHiBin{0}, fPtHat{0}, fPtHatWeight{0}, fCentralityWeight{0},
+    fMult{0}, fTriggerMask{0}, fIsGenJetCollectionFilled{kFALSE},
+    fNRecoJets{0}, fNGenJets{0}, fRecoBufferSize{0}, fGenBufferSize{0} {
+    fEventPool = new EventPool{};
+}
+
+//_________________
+DiJetTreeReader::~DiJetTreeReader() {
+    // Events handed out are returned to the pool by the user
+    if (fEventPool) delete fEventPool;
+    if (fChain) delete fChain;
+    if (fEventCut) delete fEventCut;
+    if (fJetCut) delete fJetCut;
+}
+
+//_________________
+int DiJetTreeReader::init() {
+    int status = setupChain();
+    applyEntryRange();
+    setupBranches();
+    return status;
+}
+
+//_________________
+int DiJetTreeReader::setupChain() {
+
+    fChain = new TChain( fTreeName.Data() );
+    if ( fInFileName.Length() <= 0 ) {
+        std::cerr << "[ERROR] DiJetTreeReader::setupChain - no input file. Terminating" << std::endl;
+        exit(1);
+    }
+
+    if ( fInFileName.Index(".root") > 0 ) {
+        std::cout << Form( "Adding %s file to chain\n", fInFileName.Data() );
+        fChain->Add( fInFileName.Data() );
+    }
+    else {
+        // List of files: "file NumEvents" lines are allowed
+        std::ifstream inputStream( fInFileName.Data() );
+        if ( !inputStream ) {
+            std::cerr << Form("[ERROR] DiJetTreeReader::setupChain - cannot open file list: %s. Terminating\n", 
+                              fInFileName.Data());
+            exit(1);
+        }
+        std::string file;
+        int nFiles{0};
+        while ( getline( inputStream, file ) ) {
+            size_t pos = file.find_first_of(" ");
+            if ( pos != std::string::npos ) file.erase( pos, file.length() - pos );
+            if ( file.find(".root") == std::string::npos ) continue;
+            fChain->Add( file.c_str() );
+            ++nFiles;
+        }
+        std::cout << Form("Total number of files in chain: %d\n", nFiles);
+    }
+
+    fEntriesInChain = fChain->GetEntries();
+    std::cout << Form("Total number of events to read: %lld\n", fEntriesInChain );
+    return 0;
+}
+
+//_________________
+void DiJetTreeReader::setupBranches() {
+
+    // Optional content is read only if it was written and is needed
+    fChain->LoadTree( 0 );
+    auto hasBranch = [this](const char *name) {
+        return ( fChain->GetTree() && fChain->GetTree()->GetBranch( name ) );
+    };
+    fReadPFContent = hasBranch("jtPfNHF") && fRequiredInputs.isJetContentRequired( InputRequirements::kJetPFFractions ) &&
+                     fRequiredInputs.isJetContentRequired( InputRequirements::kJetPFMultiplicities );
+    fReadWTAAxes = hasBranch("WTAeta") && fRequiredInputs.isJetContentRequired( InputRequirements::kJetWTAAxes );
+    fReadFlavor = hasBranch("genFlavor") && fRequiredInputs.isJetContentRequired( InputRequirements::kJetPartonFlavor );
+
+    fChain->SetBranchStatus("*", 0);
+    auto enable = [this](const char *name, void *address) {
+        fChain->SetBranchStatus( name, 1 );
+        fChain->SetBranchAddress( name, address );
+    };
+    enable("run", &fRunId);
+    enable("lumi", &fLumi);
+    enable("evt", &fEventId);
+    enable("vz", &fVz);
+    enable("hiBin", &fHiBin);
+    enable("pthat", &fPtHat);
+    enable("weight", &fPtHatWeight);
+    enable("centWeight", &fCentralityWeight);
+    enable("mult", &fMult);
+    enable("trigMask", &fTriggerMask);
+    enable("isGenJetsFilled", &fIsGenJetCollectionFilled);
+    enable("nref", &fNRecoJets);
+    enable("ngen", &fNGenJets);
+    for (const char *name : { "rawpt", "jtpt", "jteta", "jtphi", "trackMax", "genJetId", "jetId", 
+                              "genpt", "geneta", "genphi" }) {
+        fChain->SetBranchStatus( name, 1 );
+    }
+    if ( fReadPFContent ) {
+        fChain->SetBranchStatus( "jtPf*", 1 );
+    }
+    // Ref jet kinematics are not read: reco jets point to their gen jets by genJetId
+    if ( fReadWTAAxes ) {
+        for (const char *name : { "WTAeta", "WTAphi", "WTAgeneta", "WTAgenphi" }) {
+            fChain->SetBranchStatus( name, 1 );
+        }
+    }
+    if ( fReadFlavor ) {
+        fChain->SetBranchStatus( "genFlavor", 1 );
+        fChain->SetBranchStatus( "genFlavorForB", 1 );
+    }
+
+    fitBuffers();
+}
+
+//_________________
+void DiJetTreeReader::setArrayAddresses() {
+    fChain->SetBranchAddress("rawpt", fRecoRawPt.data());
+    fChain->SetBranchAddress("jtpt", fRecoPt.data());
+    fChain->SetBranchAddress("jteta", fRecoEta.data());
+    fChain->SetBranchAddress("jtphi", fRecoPhi.data());
+    fChain->SetBranchAddress("trackMax", fRecoTrackMaxPt.data());
+    fChain->SetBranchAddress("genJetId", fRecoGenJetId.data());
+    fChain->SetBranchAddress("jetId", fRecoJetId.data());
+    if ( fReadPFContent ) {
+        fChain->SetBranchAddress("jtPfNHF", fRecoPfNHF.data());
+        fChain->SetBranchAddress("jtPfNEF", fRecoPfNEF.data());
+        fChain->SetBranchAddress("jtPfCHF", fRecoPfCHF.data());
+        fChain->SetBranchAddress("jtPfMUF", fRecoPfMUF.data());
+        fChain->SetBranchAddress("jtPfCEF", fRecoPfCEF.data());
+        fChain->SetBranchAddress("jtPfCHM", fRecoPfCHM.data());
+        fChain->SetBranchAddress("jtPfCEM", fRecoPfCEM.data());
+        fChain->SetBranchAddress("jtPfNHM", fRecoPfNHM.data());
+        fChain->SetBranchAddress("jtPfNEM", fRecoPfNEM.data());
+        fChain->SetBranchAddress("jtPfMUM", fRecoPfMUM.data());
+    }
+    if ( fReadWTAAxes ) {
+        fChain->SetBranchAddress("WTAeta", fRecoWTAEta.data());
+        fChain->SetBranchAddress("WTAphi", fRecoWTAPhi.data());
+        fChain->SetBranchAddress("WTAgeneta", fGenWTAEta.data());
+        fChain->SetBranchAddress("WTAgenphi", fGenWTAPhi.data());
+    }
+    if ( fReadFlavor ) {
+        fChain->SetBranchAddress("genFlavor", fGenFlavor.data());
+        fChain->SetBranchAddress("genFlavorForB", fGenFlavorForB.data());
+    }
+    fChain->SetBranchAddress("genpt", fGenPt.data());
+    fChain->SetBranchAddress("geneta", fGenEta.data());
+    fChain->SetBranchAddress("genphi", fGenPhi.data());
+}
+
+//_________________
+void DiJetTreeReader::fitBuffers() {
+
+    // Longest arrays of the file are known from the counter leaves
+    TTree *tree = fChain->GetTree();
+    if ( !tree || fChain->GetTreeNumber() == fBufferTreeNumber ) return;
+    fBufferTreeNumber = fChain->GetTreeNumber();
+
+    auto maximum = [tree](const char *counterName) -> size_t {
+        TLeaf *leaf = tree->GetLeaf( counterName );
+        if ( !leaf ) return 0;
+        return static_cast<size_t>( std::max( 0, leaf->GetMaximum() ) );
+    };
+    const size_t nReco = std::max( maximum("nref"), static_cast<size_t>( 1 ) );
+    const size_t nGen = std::max( maximum("ngen"), static_cast<size_t>( 1 ) );
+
+    // Buffers only grow
+    bool isResized{false};
+    if ( nReco > fRecoBufferSize ) {
+        fRecoBufferSize = nReco;
+        for (auto buffer : { &fRecoRawPt, &fRecoPt, &fRecoEta, &fRecoPhi, &fRecoWTAEta, &fRecoWTAPhi,
+                             &fRecoTrackMaxPt, &fRecoPfNHF, &fRecoPfNEF, &fRecoPfCHF, &fRecoPfMUF, &fRecoPfCEF }) {
+            buffer->allocate( fRecoBufferSize );
+        }
+        for (auto buffer : { &fRecoJetId, &fRecoPfCHM, &fRecoPfCEM, &fRecoPfNHM, &fRecoPfNEM, &fRecoPfMUM }) {
+            buffer->allocate( fRecoBufferSize );
+        }
+        fRecoGenJetId.allocate( fRecoBufferSize );
+        isResized = {true};
+    }
+    if ( nGen > fGenBufferSize ) {
+        fGenBufferSize = nGen;
+        for (auto buffer : { &fGenPt, &fGenEta, &fGenPhi, &fGenWTAEta, &fGenWTAPhi }) {
+            buffer->allocate( fGenBufferSize );
+        }
+        fGenFlavor.allocate( fGenBufferSize );
+        fGenFlavorForB.allocate( fGenBufferSize );
+        isResized = {true};
+    }
+    if ( isResized ) {
+        setArrayAddresses();
+    }
+}
+
+//_________________
+Event* DiJetTreeReader::returnEvent() {
+
+    if ( fEventsProcessed >= fEvents2Read ) {
+        std::cerr << "DiJetTreeReader::returnEvent() out of entry numbers\n";
+        fReaderStatus = 2; // End of input stream
+        return nullptr;
+    }
+
+    const Long64_t entry = entryNumber( fEventsProcessed );
+    fEventsProcessed++;
+    if ( fChain->LoadTree( entry ) < 0 ) {
+        fReaderStatus = 2;
+        return nullptr;
+    }
+    fitBuffers();
+    fChain->GetEntry( entry );
+    if ( static_cast<size_t>( fNRecoJets ) > fRecoBufferSize || static_cast<size_t>( fNGenJets ) > fGenBufferSize ) {
+        std::cerr << Form("[ERROR] DiJetTreeReader::returnEvent - %d reco or %d gen jets exceed buffers of %zu and %zu jets. Terminating\n",
+                          fNRecoJets, fNGenJets, fRecoBufferSize, fGenBufferSize);
+        exit(1);
+    }
+
+    fEvent = fEventPool->get();
+    fEvent->setRunId( fRunId );
+    fEvent->setEventId( fEventId );
+    fEvent->setLumi( fLumi );
+    fEvent->setVz( fVz );
+    fEvent->setHiBin( fHiBin );
+    fEvent->setCentralityWeight( fCentralityWeight );
+    fEvent->setPtHat( fPtHat );
+    fEvent->setPtHatWeight( fPtHatWeight );
+    fEvent->setMultiplicity( fMult );
+    fEvent->trigAndSkim()->setMask( fTriggerMask );
+
+    if ( fEventCut && !fEventCut->pass( fEvent ) ) {
+        fEventPool->put( fEvent );
+        fEvent = nullptr;
+        return fEvent;
+    }
+
+    for (Int_t iJet{0}; iJet<fNGenJets; iJet++) {
+        GenJet *jet = fEvent->newGenJet();
+        jet->setId( iJet );
+        jet->setPt( fGenPt[iJet] );
+        jet->setEta( fGenEta[iJet] );
+        jet->setPhi( fGenPhi[iJet] );
+        if ( fReadWTAAxes ) {
+            jet->setWTAEta( fGenWTAEta[iJet] );
+            jet->setWTAPhi( fGenWTAPhi[iJet] );
+        }
+        if ( fReadFlavor ) {
+            jet->setFlavor( fGenFlavor[iJet] );
+            jet->setFlavorForB( fGenFlavorForB[iJet] );
+        }
+        jet->setPtWeight( 1. );
+        fEvent->genJetCollection()->push_back( jet );
+    }
+    if ( fIsGenJetCollectionFilled ) {
+        fEvent->setGenJetCollectionIsFilled();
+    }
+
+    for (Int_t iJet{0}; iJet<fNRecoJets; iJet++) {
+        RecoJet *jet = fEvent->newRecoJet();
+        jet->setId( iJet );
+        jet->setRawPt( fRecoRawPt[iJet] );
+        jet->setPtJECCorr( fRecoPt[iJet] );
+        jet->setEta( fRecoEta[iJet] );
+        jet->setPhi( fRecoPhi[iJet] );
+        if ( fReadWTAAxes ) {
+            jet->setWTAEta( fRecoWTAEta[iJet] );
+            jet->setWTAPhi( fRecoWTAPhi[iJet] );
+        }
+        jet->setTrackMaxPt( fRecoTrackMaxPt[iJet] );
+        jet->setGenJetId( fRecoGenJetId[iJet] );
+        jet->setJetIdFlags( fRecoJetId[iJet] );
+        if ( fReadPFContent ) {
+            jet->setJtPfNHF( fRecoPfNHF[iJet] );
+            jet->setJtPfNEF( fRecoPfNEF[iJet] );
+            jet->setJtPfCHF( fRecoPfCHF[iJet] );
+            jet->setJtPfMUF( fRecoPfMUF[iJet] );
+            jet->setJtPfCEF( fRecoPfCEF[iJet] );
+            jet->setJtPfCHM( fRecoPfCHM[iJet] );
+            jet->setJtPfCEM( fRecoPfCEM[iJet] );
+            jet->setJtPfNHM( fRecoPfNHM[iJet] );
+            jet->setJtPfNEM( fRecoPfNEM[iJet] );
+            jet->setJtPfMUM( fRecoPfMUM[iJet] );
+        }
+        if ( fJetCut && !fJetCut->pass( jet, false, false, false ) ) continue;
+        fEvent->recoJetCollection()->push_back( jet );
+    }
+    fEvent->setRecoJetCollectionName( fJetCollectionName );
+
+    if ( fVerbose ) {
+        std::cout << Form("DiJetTreeReader: entry %lld reco jets: %d gen jets: %d\n", 
+                          entry, (int)fEvent->numberOfRecoJets(), (int)fEvent->numberOfGenJets());
+    }
+    return fEvent;
+}
+
+//_________________
+void DiJetTreeReader::finish() {
+    std::cout << Form("DiJetTreeReader: %lld events are read. Buffers are allocated for %zu reco and %zu gen jets\n",
+                      fEventsProcessed, fRecoBufferSize, fGenBufferSize);
+}
+
+//_________________
+void DiJetTreeReader::report() {
+    if ( fEventCut ) fEventCut->report();
+    if ( fJetCut ) fJetCut->report();
+}
+
+//_________________
+void DiJetTreeReader::setSampling(const Long64_t& step, const Long64_t& blockSize) {
+    BaseReader::setSampling(step, blockSize);
+    if ( fChain ) applyEntryRange();
+}
+
+//_________________
+void DiJetTreeReader::setEntryRange(const Long64_t& first, const Long64_t& last) {
+    BaseReader::setEntryRange(first, last);
+    if ( fChain ) applyEntryRange();
+}
+
+//_________________
+void DiJetTreeReader::setShard(const int& index, const int& nShards) {
+    BaseReader::setShard(index, nShards);
+    if ( fChain ) applyEntryRange();
+}
+
+//_________________
+void DiJetTreeReader::startTask(const EntryTask& task) {
+    BaseReader::setEntryRange(task.first, task.last);
+    applyEntryRange( false );
+}
+
+//_________________
+void DiJetTreeReader::entryTasks(std::vector<EntryTask>& tasks) const {
+
+    const Long64_t last = fFirstEntry + fEntriesInRange;
+    std::vector<Long64_t> clusterEnds;
+    fileClusterEnds( fChain, fChain, fFirstEntry, last, clusterEnds );
+    clusterTasks( clusterEnds, last, tasks );
+}
+
+//_________________
+void DiJetTreeReader::applyEntryRange(const bool& verbose) {
+    const Long64_t last = resolveEntryRange( fEntriesInChain );
+    fEntriesInRange = last - fFirstEntry;
+    fEvents2Read = nSampledEntries( fEntriesInRange );
+    fEventsProcessed = 0;
+    fReaderStatus = 0;
+
+    if ( verbose && fEvents2Read != fEntriesInChain ) {
+        std::cout << Form("Entry range to read: [%lld, %lld). Number of events to read: %lld\n", 
+                          fFirstEntry, last, fEvents2Read );
+    }
+}
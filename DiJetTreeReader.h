@@ -0,0 +1,165 @@
+/**
+ * @file DiJetTreeReader.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Reader of the slim calibrated dijet tree written by DiJetTreeWriter
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef DiJetTreeReader_h
+#define DiJetTreeReader_h
+
+// ROOT headers
+#include "Rtypes.h"
+#include "TChain.h"
+#include "TString.h"
+
+// JetAnalysis headers
+#include "BaseReader.h"
+#include "BranchBuffer.h"
+#include "Event.h"
+#include "EventPool.h"
+#include "EventCut.h"
+#include "JetCut.h"
+
+// C++ headers
+#include <string>
+#include <vector>
+
+//_________________
+class DiJetTreeReader : public BaseReader {
+
+  public:
+    /// @brief Default constructor
+    DiJetTreeReader();
+    /// @brief Constructor
+    /// @param inputStream Input file (.root) or list of ROOT files written by DiJetTreeWriter
+    /// @param treeName Tree name (with the directory of the jet collection if it was set)
+    DiJetTreeReader(const char *inputStream, const char *treeName = "dijetTree");
+    /// @brief Destructor
+    virtual ~DiJetTreeReader();
+
+    /// @brief Initialize input
+    int init();
+    /// @brief Finish (print final information)
+    void finish();
+    /// @brief Read event and fill objects. Jets are already calibrated
+    Event* returnEvent();
+    /// @brief Report cuts
+    void report();
+    /// @brief Return event to the pool of events for reuse
+    void recycleEvent(Event *event) { fEventPool->put( event ); }
+
+    /// @brief Set tree name
+    void setTreeName(const char *name) { fTreeName = name; }
+    /// @brief Set name the reco jets are stored under in the event (as by ForestAODReader)
+    void setJetCollectionName(const char *name) { fJetCollectionName = ( name ) ? name : ""; }
+    /// @brief Set event cut (owned). Applied on top of the selection of the written events
+    void setEventCut(EventCut *cut) { fEventCut = {cut}; }
+    /// @brief Set jet cut (owned). Applied on top of the selection of the written jets
+    void setJetCut(JetCut *cut) { fJetCut = {cut}; }
+    /// @brief Set verbose mode
+    void setVerbose() { fVerbose = {true}; }
+
+    /// @brief Return amount of events to read
+    Long64_t nEventsTotal() const { return fEvents2Read; }
+    /// @brief Return number of entries in the whole chain
+    Long64_t nEntriesInChain() const { return fEntriesInChain; }
+    /// @brief Return number of entries in the entry range (before sampling)
+    Long64_t nEntriesInRange() const { return fEntriesInRange; }
+    /// @brief Read only the first of every step blocks of blockSize consecutive entries
+    void setSampling(const Long64_t& step, const Long64_t& blockSize = 1);
+    /// @brief Read only entries [first, last) of the chain. Negative last means till the end of chain
+    void setEntryRange(const Long64_t& first, const Long64_t& last = -1);
+    /// @brief Read only shard index of nShards equal parts of the entry range
+    void setShard(const int& index, const int& nShards);
+    /// @brief Split the entry range into tasks at cluster boundaries (aligned to the sampling blocks)
+    void entryTasks(std::vector<EntryTask>& tasks) const;
+    /// @brief Read entries of the task [task.first, task.last)
+    void startTask(const EntryTask& task);
+
+  private:
+    /// @brief Add input files to the chain
+    int setupChain();
+    /// @brief Set branch addresses and disable branches that are not required
+    void setupBranches();
+    /// @brief Point array branches to the current buffers
+    void setArrayAddresses();
+    /// @brief Grow jet buffers if the current file has longer arrays
+    void fitBuffers();
+    /// @brief Keep the entry range inside the chain and count events to read
+    void applyEntryRange(const bool& verbose = true);
+
+    /// @brief Current event
+    Event *fEvent;
+    /// @brief Events reused by the reader
+    EventPool *fEventPool;
+    /// @brief Input file or file list
+    TString fInFileName;
+    /// @brief Tree name
+    TString fTreeName;
+    /// @brief Name of the reco jet collection
+    std::string fJetCollectionName;
+    /// @brief Input chain
+    TChain *fChain;
+    /// @brief Tree number the buffers were fitted to
+    int fBufferTreeNumber;
+
+    /// @brief Number of entries in the chain
+    Long64_t fEntriesInChain;
+    /// @brief Number of entries in the entry range
+    Long64_t fEntriesInRange;
+    /// @brief Number of events to read
+    Long64_t fEvents2Read;
+    /// @brief Number of events read
+    Long64_t fEventsProcessed;
+
+    /// @brief Event cut (owned)
+    EventCut *fEventCut;
+    /// @brief Jet cut (owned)
+    JetCut *fJetCut;
+    /// @brief Verbose mode
+    bool fVerbose;
+    /// @brief PF content of reco jets is read
+    bool fReadPFContent;
+    /// @brief WTA axes of reco and gen jets are read
+    bool fReadWTAAxes;
+    /// @brief Parton flavor of gen jets is read
+    bool fReadFlavor;
+
+    /// @brief Event quantities
+    UInt_t    fRunId;
+    UInt_t    fLumi;
+    ULong64_t fEventId;
+    Float_t   fVz;
+    Short_t   fHiBin;
+    Float_t   fPtHat;
+    Float_t   fPtHatWeight;
+    Float_t   fCentralityWeight;
+    UShort_t  fMult;
+    ULong64_t fTriggerMask;
+    Bool_t    fIsGenJetCollectionFilled;
+
+    /// @brief Reco jets
+    Int_t fNRecoJets;
+    BranchBuffer<Float_t> fRecoRawPt, fRecoPt, fRecoEta, fRecoPhi, fRecoWTAEta, fRecoWTAPhi, fRecoTrackMaxPt; //!
+    BranchBuffer<Short_t> fRecoGenJetId; //!
+    BranchBuffer<UChar_t> fRecoJetId; //!
+    BranchBuffer<Float_t> fRecoPfNHF, fRecoPfNEF, fRecoPfCHF, fRecoPfMUF, fRecoPfCEF; //!
+    BranchBuffer<UChar_t> fRecoPfCHM, fRecoPfCEM, fRecoPfNHM, fRecoPfNEM, fRecoPfMUM; //!
+    /// @brief Gen jets
+    Int_t fNGenJets;
+    BranchBuffer<Float_t> fGenPt, fGenEta, fGenPhi, fGenWTAEta, fGenWTAPhi; //!
+    BranchBuffer<Short_t> fGenFlavor; //!
+    BranchBuffer<Char_t>  fGenFlavorForB; //!
+    /// @brief Size of the jet buffers
+    size_t fRecoBufferSize;
+    size_t fGenBufferSize;
+
+    ClassDef(DiJetTreeReader, 0)
+};
+
+#endif // #define DiJetTreeReader_h
@@ -0,0 +1,331 @@
+/**
+ * @file DiJetTreeWriter.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Analysis that writes calibrated jets into a slim per-event tree
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "DiJetTreeWriter.h"
+#include "Event.h"
+#include "TriggerAndSkim.h"
+
+// ROOT headers
+#include "TFile.h"
+#include "TTree.h"
+#include "TDirectory.h"
+#include "TSystem.h"
+
+// C++ headers
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+
+//________________
+DiJetTreeWriter::DiJetTreeWriter() : BaseAnalysis(), fTreeName{defaultTreeName()}, fJetCollectionName{},
+    fWritePFContent{false}, fCompression{ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault},
+    fTmpFile{nullptr}, fTmpFileName{}, fTree{nullptr},
+    fRunId{0}, fLumi{0}, fEventId{0}, fVz{0}, fHiBin{0}, fPtHat{0}, fPtHatWeight{0}, fCentralityWeight{0},
+    fMult{0}, fTriggerMask{0}, fIsGenJetCollectionFilled{kFALSE},
+    fNRecoJets{0}, fNGenJets{0}, fRecoBufferSize{0}, fGenBufferSize{0} {
+    /* empty */
+}
+
+//________________
+DiJetTreeWriter::~DiJetTreeWriter() {
+    // Tree is owned by the temporary file
+    if ( fTmpFile ) {
+        fTmpFile->Close();
+        delete fTmpFile;
+        gSystem->Unlink( fTmpFileName.Data() );
+    }
+}
+
+//________________
+void DiJetTreeWriter::init() {
+
+    // Baskets are written to a temporary file during the event loop and copied
+    // (without recompression) to the output by writeOutput()
+    fTmpFileName = Form("%s_", fTreeName.Data());
+    FILE *tmpFile = gSystem->TempFileName( fTmpFileName, nullptr, ".root" );
+    if ( !tmpFile ) {
+        std::cerr << "[ERROR] DiJetTreeWriter::init - cannot create temporary file. Terminating" << std::endl;
+        exit(1);
+    }
+    fclose( tmpFile );
+
+    TDirectory::TContext context;
+    fTmpFile = new TFile( fTmpFileName.Data(), "recreate", "", fCompression );
+    if ( fTmpFile->IsZombie() ) {
+        std::cerr << Form("[ERROR] DiJetTreeWriter::init - cannot open temporary file %s. Terminating\n", 
+                          fTmpFileName.Data());
+        exit(1);
+    }
+    fTree = new TTree( fTreeName.Data(), "Calibrated dijet tree" );
+
+    fitBuffers( 64, 64 );
+    createBranches();
+}
+
+//________________
+void DiJetTreeWriter::createBranches() {
+
+    fTree->Branch("run", &fRunId, "run/i");
+    fTree->Branch("lumi", &fLumi, "lumi/i");
+    fTree->Branch("evt", &fEventId, "evt/l");
+    fTree->Branch("vz", &fVz, "vz/F");
+    fTree->Branch("hiBin", &fHiBin, "hiBin/S");
+    fTree->Branch("pthat", &fPtHat, "pthat/F");
+    fTree->Branch("weight", &fPtHatWeight, "weight/F");
+    fTree->Branch("centWeight", &fCentralityWeight, "centWeight/F");
+    fTree->Branch("mult", &fMult, "mult/s");
+    fTree->Branch("trigMask", &fTriggerMask, "trigMask/l");
+    fTree->Branch("isGenJetsFilled", &fIsGenJetCollectionFilled, "isGenJetsFilled/O");
+
+    fTree->Branch("nref", &fNRecoJets, "nref/I");
+    fTree->Branch("rawpt", fRecoRawPt.data(), "rawpt[nref]/F");
+    fTree->Branch("jtpt", fRecoPt.data(), "jtpt[nref]/F");
+    fTree->Branch("jteta", fRecoEta.data(), "jteta[nref]/F");
+    fTree->Branch("jtphi", fRecoPhi.data(), "jtphi[nref]/F");
+    fTree->Branch("WTAeta", fRecoWTAEta.data(), "WTAeta[nref]/F");
+    fTree->Branch("WTAphi", fRecoWTAPhi.data(), "WTAphi[nref]/F");
+    fTree->Branch("trackMax", fRecoTrackMaxPt.data(), "trackMax[nref]/F");
+    fTree->Branch("genJetId", fRecoGenJetId.data(), "genJetId[nref]/S");
+    fTree->Branch("refpt", fRefPt.data(), "refpt[nref]/F");
+    fTree->Branch("refeta", fRefEta.data(), "refeta[nref]/F");
+    fTree->Branch("refphi", fRefPhi.data(), "refphi[nref]/F");
+    fTree->Branch("jetId", fRecoJetId.data(), "jetId[nref]/b");
+    if ( fWritePFContent ) {
+        fTree->Branch("jtPfNHF", fRecoPfNHF.data(), "jtPfNHF[nref]/F");
+        fTree->Branch("jtPfNEF", fRecoPfNEF.data(), "jtPfNEF[nref]/F");
+        fTree->Branch("jtPfCHF", fRecoPfCHF.data(), "jtPfCHF[nref]/F");
+        fTree->Branch("jtPfMUF", fRecoPfMUF.data(), "jtPfMUF[nref]/F");
+        fTree->Branch("jtPfCEF", fRecoPfCEF.data(), "jtPfCEF[nref]/F");
+        fTree->Branch("jtPfCHM", fRecoPfCHM.data(), "jtPfCHM[nref]/b");
+        fTree->Branch("jtPfCEM", fRecoPfCEM.data(), "jtPfCEM[nref]/b");
+        fTree->Branch("jtPfNHM", fRecoPfNHM.data(), "jtPfNHM[nref]/b");
+        fTree->Branch("jtPfNEM", fRecoPfNEM.data(), "jtPfNEM[nref]/b");
+        fTree->Branch("jtPfMUM", fRecoPfMUM.data(), "jtPfMUM[nref]/b");
+    }
+
+    fTree->Branch("ngen", &fNGenJets, "ngen/I");
+    fTree->Branch("genpt", fGenPt.data(), "genpt[ngen]/F");
+    fTree->Branch("geneta", fGenEta.data(), "geneta[ngen]/F");
+    fTree->Branch("genphi", fGenPhi.data(), "genphi[ngen]/F");
+    fTree->Branch("WTAgeneta", fGenWTAEta.data(), "WTAgeneta[ngen]/F");
+    fTree->Branch("WTAgenphi", fGenWTAPhi.data(), "WTAgenphi[ngen]/F");
+    fTree->Branch("genFlavor", fGenFlavor.data(), "genFlavor[ngen]/S");
+    fTree->Branch("genFlavorForB", fGenFlavorForB.data(), "genFlavorForB[ngen]/B");
+}
+
+//________________
+void DiJetTreeWriter::fitBuffers(const int& nRecoJets, const int& nGenJets) {
+
+    // Buffers only grow: the branch addresses change rarely
+    bool isResized{false};
+    if ( static_cast<size_t>( nRecoJets ) > fRecoBufferSize ) {
+        fRecoBufferSize = std::max( static_cast<size_t>( nRecoJets ), 2 * fRecoBufferSize );
+        for (auto buffer : { &fRecoRawPt, &fRecoPt, &fRecoEta, &fRecoPhi, &fRecoWTAEta, &fRecoWTAPhi,
+                             &fRecoTrackMaxPt, &fRefPt, &fRefEta, &fRefPhi, &fRecoPfNHF, &fRecoPfNEF, &fRecoPfCHF, &fRecoPfMUF, &fRecoPfCEF }) {
+            buffer->allocate( fRecoBufferSize );
+        }
+        for (auto buffer : { &fRecoJetId, &fRecoPfCHM, &fRecoPfCEM, &fRecoPfNHM, &fRecoPfNEM, &fRecoPfMUM }) {
+            buffer->allocate( fRecoBufferSize );
+        }
+        fRecoGenJetId.allocate( fRecoBufferSize );
+        isResized = {true};
+    }
+    if ( static_cast<size_t>( nGenJets ) > fGenBufferSize ) {
+        fGenBufferSize = std::max( static_cast<size_t>( nGenJets ), 2 * fGenBufferSize );
+        for (auto buffer : { &fGenPt, &fGenEta, &fGenPhi, &fGenWTAEta, &fGenWTAPhi }) {
+            buffer->allocate( fGenBufferSize );
+        }
+        fGenFlavor.allocate( fGenBufferSize );
+        fGenFlavorForB.allocate( fGenBufferSize );
+        isResized = {true};
+    }
+
+    if ( isResized && fTree && fTree->GetListOfBranches()->GetEntries() > 0 ) {
+        setArrayAddresses();
+    }
+}
+
+//________________
+void DiJetTreeWriter::setArrayAddresses() {
+    fTree->SetBranchAddress("rawpt", fRecoRawPt.data());
+    fTree->SetBranchAddress("jtpt", fRecoPt.data());
+    fTree->SetBranchAddress("jteta", fRecoEta.data());
+    fTree->SetBranchAddress("jtphi", fRecoPhi.data());
+    fTree->SetBranchAddress("WTAeta", fRecoWTAEta.data());
+    fTree->SetBranchAddress("WTAphi", fRecoWTAPhi.data());
+    fTree->SetBranchAddress("trackMax", fRecoTrackMaxPt.data());
+    fTree->SetBranchAddress("genJetId", fRecoGenJetId.data());
+    fTree->SetBranchAddress("refpt", fRefPt.data());
+    fTree->SetBranchAddress("refeta", fRefEta.data());
+    fTree->SetBranchAddress("refphi", fRefPhi.data());
+    fTree->SetBranchAddress("jetId", fRecoJetId.data());
+    if ( fWritePFContent ) {
+        fTree->SetBranchAddress("jtPfNHF", fRecoPfNHF.data());
+        fTree->SetBranchAddress("jtPfNEF", fRecoPfNEF.data());
+        fTree->SetBranchAddress("jtPfCHF", fRecoPfCHF.data());
+        fTree->SetBranchAddress("jtPfMUF", fRecoPfMUF.data());
+        fTree->SetBranchAddress("jtPfCEF", fRecoPfCEF.data());
+        fTree->SetBranchAddress("jtPfCHM", fRecoPfCHM.data());
+        fTree->SetBranchAddress("jtPfCEM", fRecoPfCEM.data());
+        fTree->SetBranchAddress("jtPfNHM", fRecoPfNHM.data());
+        fTree->SetBranchAddress("jtPfNEM", fRecoPfNEM.data());
+        fTree->SetBranchAddress("jtPfMUM", fRecoPfMUM.data());
+    }
+    fTree->SetBranchAddress("genpt", fGenPt.data());
+    fTree->SetBranchAddress("geneta", fGenEta.data());
+    fTree->SetBranchAddress("genphi", fGenPhi.data());
+    fTree->SetBranchAddress("WTAgeneta", fGenWTAEta.data());
+    fTree->SetBranchAddress("WTAgenphi", fGenWTAPhi.data());
+    fTree->SetBranchAddress("genFlavor", fGenFlavor.data());
+    fTree->SetBranchAddress("genFlavorForB", fGenFlavorForB.data());
+}
+
+//________________
+void DiJetTreeWriter::processEvent(const Event *event) {
+
+    const RecoJetCollection *recoJets = event->recoJetCollection( fJetCollectionName );
+    const GenJetCollection *genJets = event->genJetCollection( fJetCollectionName );
+    if ( !recoJets || !genJets ) {
+        std::cerr << Form("[ERROR] DiJetTreeWriter::processEvent - jet collection %s is not read. Terminating\n",
+                          fJetCollectionName.c_str());
+        exit(1);
+    }
+
+    fNRecoJets = static_cast<Int_t>( recoJets->size() );
+    fNGenJets = static_cast<Int_t>( genJets->size() );
+    fitBuffers( fNRecoJets, fNGenJets );
+
+    fRunId = event->runId();
+    fLumi = event->lumi();
+    fEventId = event->eventId();
+    fVz = event->vz();
+    fHiBin = static_cast<Short_t>( event->hiBin() );
+    fPtHat = event->ptHat();
+    fPtHatWeight = event->ptHatWeight();
+    fCentralityWeight = static_cast<Float_t>( event->centralityWeight() );
+    fMult = static_cast<UShort_t>( event->multiplicity() );
+    fTriggerMask = event->trigAndSkim()->mask();
+    fIsGenJetCollectionFilled = event->isGenJetCollectionFilled();
+
+    for (Int_t iJet{0}; iJet<fNRecoJets; iJet++) {
+        const RecoJet *jet = recoJets->at( iJet );
+        fRecoRawPt[iJet] = jet->rawPt();
+        fRecoPt[iJet] = jet->ptJECCorr();
+        fRecoEta[iJet] = jet->eta();
+        fRecoPhi[iJet] = jet->phi();
+        fRecoWTAEta[iJet] = jet->WTAEta();
+        fRecoWTAPhi[iJet] = jet->WTAPhi();
+        fRecoTrackMaxPt[iJet] = jet->trackMaxPt();
+        fRecoGenJetId[iJet] = static_cast<Short_t>( jet->genJetId() );
+        // Ref jet kinematics as in the forest (-999 for jets without a matched gen jet)
+        const int iGenJet = jet->genJetId();
+        if ( iGenJet >= 0 && iGenJet < fNGenJets ) {
+            const GenJet *refJet = genJets->at( iGenJet );
+            fRefPt[iJet] = refJet->pt();
+            fRefEta[iJet] = refJet->eta();
+            fRefPhi[iJet] = refJet->phi();
+        }
+        else {
+            fRefPt[iJet] = -999.f;
+            fRefEta[iJet] = -999.f;
+            fRefPhi[iJet] = -999.f;
+        }
+        fRecoJetId[iJet] = static_cast<UChar_t>( jet->jetIdFlags() );
+        if ( fWritePFContent ) {
+            fRecoPfNHF[iJet] = jet->jtPfNHF();
+            fRecoPfNEF[iJet] = jet->jtPfNEF();
+            fRecoPfCHF[iJet] = jet->jtPfCHF();
+            fRecoPfMUF[iJet] = jet->jtPfMUF();
+            fRecoPfCEF[iJet] = jet->jtPfCEF();
+            fRecoPfCHM[iJet] = static_cast<UChar_t>( jet->jtPfCHM() );
+            fRecoPfCEM[iJet] = static_cast<UChar_t>( jet->jtPfCEM() );
+            fRecoPfNHM[iJet] = static_cast<UChar_t>( jet->jtPfNHM() );
+            fRecoPfNEM[iJet] = static_cast<UChar_t>( jet->jtPfNEM() );
+            fRecoPfMUM[iJet] = static_cast<UChar_t>( jet->jtPfMUM() );
+        }
+    }
+
+    // Gen jets are written in the collection order: genJetId of reco jets stays valid
+    for (Int_t iJet{0}; iJet<fNGenJets; iJet++) {
+        const GenJet *jet = genJets->at( iJet );
+        fGenPt[iJet] = jet->pt();
+        fGenEta[iJet] = jet->eta();
+        fGenPhi[iJet] = jet->phi();
+        fGenWTAEta[iJet] = jet->WTAEta();
+        fGenWTAPhi[iJet] = jet->WTAPhi();
+        fGenFlavor[iJet] = static_cast<Short_t>( jet->flavor() );
+        fGenFlavorForB[iJet] = static_cast<Char_t>( jet->flavorForB() );
+    }
+
+    fTree->Fill();
+}
+
+//________________
+void DiJetTreeWriter::finish() {
+    if ( fTree ) {
+        std::cout << Form("DiJetTreeWriter: %lld events are written to %s\n", fTree->GetEntries(), fTreeName.Data());
+    }
+}
+
+//________________
+void DiJetTreeWriter::writeOutput() {
+    if ( !fTree ) return;
+
+    // Baskets still in memory must be in the file to be copied
+    fTree->FlushBaskets();
+
+    // Trees of other jet collections go to the directory named after the collection
+    TDirectory *current = gDirectory;
+    TDirectory *dir = current;
+    if ( !fJetCollectionName.empty() ) {
+        dir = current->GetDirectory( fJetCollectionName.c_str() );
+        if ( !dir ) dir = current->mkdir( fJetCollectionName.c_str() );
+    }
+    dir->cd();
+    // Compressed baskets are copied as they are
+    TTree *copy = fTree->CloneTree( -1, "fast" );
+    copy->Write();
+    delete copy;
+    current->cd();
+}
+
+//________________
+void DiJetTreeWriter::report() {
+    std::cout << Form("DiJetTreeWriter: tree %s, jet collection: %s, PF content: %s\n", fTreeName.Data(),
+                      ( fJetCollectionName.empty() ) ? "main" : fJetCollectionName.c_str(),
+                      ( fWritePFContent ) ? "yes" : "no");
+}
+
+//________________
+TList* DiJetTreeWriter::getOutputList() {
+    TList *outputList = new TList();
+    return outputList;
+}
+
+//________________
+void DiJetTreeWriter::addRequiredInputs(InputRequirements& inputs) const {
+    // jetId flags are evaluated from the PF content
+    inputs.requireJetContent( InputRequirements::kJetTrackMax |
+                              InputRequirements::kJetPFFractions | 
+                              InputRequirements::kJetPFMultiplicities |
+                              InputRequirements::kJetWTAAxes |
+                              InputRequirements::kJetPartonFlavor );
+    // Full trigger mask is written: selections can be changed when the tree is read back
+    for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+        if ( TriggerAndSkim::isSkimFilter( iFlag ) ) {
+            inputs.requireSkimFilter( TriggerAndSkim::flagName( iFlag ) );
+        }
+        else {
+            inputs.requireTrigger( TriggerAndSkim::flagName( iFlag ) );
+        }
+    }
+}
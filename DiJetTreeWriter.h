@@ -0,0 +1,138 @@
+/**
+ * @file DiJetTreeWriter.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Analysis that writes calibrated jets into a slim per-event tree
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef DiJetTreeWriter_h
+#define DiJetTreeWriter_h
+
+// ROOT headers
+#include "Rtypes.h"
+#include "TString.h"
+#include "Compression.h"
+
+// Jet analysis headers
+#include "BaseAnalysis.h"
+#include "BranchBuffer.h"
+
+// C++ headers
+#include <string>
+
+// Forward declarations
+class TFile;
+class TTree;
+
+//________________
+/// @brief Writes calibrated jets of the events that passed the reader cuts into a slim tree.
+/// Reco jets: raw and calibrated pT, eta, phi, WTA axis, trackMax, jetId flags, PF content
+/// (on request) and kinematics of the matched (ref) gen jet with its index genJetId in the
+/// gen jet arrays (refpt = -999 for jets without a match). Gen jets: pT, eta, phi, WTA axis
+/// and parton flavor. Tracks and other jet collections are not written.
+///
+/// Usage: add to the manager next to (or instead of) the histogramming analysis
+///   manager->addAnalysis( new DiJetTreeWriter{} );
+/// and to each worker analysis collection in multithreaded runs. Trees of the threads and
+/// processes are merged into the output file, so the entry order follows the workers,
+/// not the input. The output is read back with DiJetTreeReader
+class DiJetTreeWriter : public BaseAnalysis {
+  public:
+    /// @brief Default constructor
+    DiJetTreeWriter();
+    /// @brief Destructor
+    virtual ~DiJetTreeWriter();
+
+    /// @brief Create the tree (in a temporary file until the output is written)
+    void init();
+    /// @brief Add event and its jets to the tree
+    void processEvent(const Event *event);
+    /// @brief Finish analysis
+    void finish();
+    /// @brief Copy the tree to the current directory (into the directory
+    /// named after the jet collection if the collection is set)
+    void writeOutput();
+    /// @brief Report number of written events
+    void report();
+    /// @brief Return a TList of objects to be written as output
+    TList *getOutputList();
+    /// @brief Jet trackMax, the PF content (for the jetId flags), WTA axes and flavor are read
+    void addRequiredInputs(InputRequirements& inputs) const;
+
+    /// @brief Set name of the output tree (default: dijetTree)
+    void setTreeName(const char *name) { fTreeName = name; }
+    /// @brief Set name of the reco jet collection to write (empty - main collection)
+    void setJetCollectionName(const char *name) { fJetCollectionName = ( name ) ? name : ""; }
+    /// @brief Write PF energy fractions and multiplicities of reco jets (default: false).
+    /// The jetId decisions are always written
+    void setWritePFContent(const bool& write = true) { fWritePFContent = write; }
+    /// @brief Set compression of the tree baskets (kept when the tree is copied to the output)
+    void setCompression(const int& compression) { fCompression = compression; }
+
+    /// @brief Default name of the output tree
+    static const char *defaultTreeName() { return "dijetTree"; }
+
+  private:
+    /// @brief Create branches of the tree
+    void createBranches();
+    /// @brief Grow jet buffers to hold the given number of jets
+    void fitBuffers(const int& nRecoJets, const int& nGenJets);
+    /// @brief Point array branches to the current buffers
+    void setArrayAddresses();
+
+    /// @brief Name of the output tree
+    TString fTreeName;
+    /// @brief Name of the reco jet collection to write
+    std::string fJetCollectionName;
+    /// @brief Write PF content of reco jets
+    bool fWritePFContent;
+    /// @brief Compression of the tree baskets
+    int fCompression;
+
+    /// @brief Temporary file the tree is written to during the event loop
+    TFile *fTmpFile; //!
+    /// @brief Name of the temporary file
+    TString fTmpFileName;
+    /// @brief Output tree
+    TTree *fTree; //!
+
+    /// @brief Event quantities
+    UInt_t    fRunId;
+    UInt_t    fLumi;
+    ULong64_t fEventId;
+    Float_t   fVz;
+    Short_t   fHiBin;
+    Float_t   fPtHat;
+    Float_t   fPtHatWeight;
+    Float_t   fCentralityWeight;
+    UShort_t  fMult;
+    ULong64_t fTriggerMask;
+    Bool_t    fIsGenJetCollectionFilled;
+
+    /// @brief Reco jets: raw and calibrated pT, direction, WTA axis, trackMax, kinematics
+    /// and index of the matched (ref) gen jet in the gen jet arrays and jetId flags
+    Int_t fNRecoJets;
+    BranchBuffer<Float_t> fRecoRawPt, fRecoPt, fRecoEta, fRecoPhi, fRecoWTAEta, fRecoWTAPhi, fRecoTrackMaxPt; //!
+    BranchBuffer<Float_t> fRefPt, fRefEta, fRefPhi; //!
+    BranchBuffer<Short_t> fRecoGenJetId; //!
+    BranchBuffer<UChar_t> fRecoJetId; //!
+    /// @brief Reco jet PF content (written on request)
+    BranchBuffer<Float_t> fRecoPfNHF, fRecoPfNEF, fRecoPfCHF, fRecoPfMUF, fRecoPfCEF; //!
+    BranchBuffer<UChar_t> fRecoPfCHM, fRecoPfCEM, fRecoPfNHM, fRecoPfNEM, fRecoPfMUM; //!
+    /// @brief Gen jets (MC only)
+    Int_t fNGenJets;
+    BranchBuffer<Float_t> fGenPt, fGenEta, fGenPhi, fGenWTAEta, fGenWTAPhi; //!
+    BranchBuffer<Short_t> fGenFlavor; //!
+    BranchBuffer<Char_t>  fGenFlavorForB; //!
+    /// @brief Size of the jet buffers
+    size_t fRecoBufferSize;
+    size_t fGenBufferSize;
+
+    ClassDef(DiJetTreeWriter, 0)
+};
+
+#endif // #define DiJetTreeWriter_h
@@ -23,7 +23,8 @@ Event::Event() : TObject(), fRunId{0}, fEventId{0}, fLumi{0},
                  fVx{0}, fVy{0}, fVz{0}, fHiBin{-1}, fCentralityWeight{1.}, 
                  fPtHat{-1}, fPtHatWeight{-1}, 
                  fNBadRecoJets{0},  fMult{0},
-                 fGenJetsCollectionIsFilled{kFALSE} {
+                 fGenJetsCollectionIsFilled{kFALSE}, fTrackView{}, fGenTrackView{},
+                 fRecoJetPool{}, fGenJetPool{}, fRecoJetCollectionName{}, fExtraRecoJets{} {
     fRecoJetCollection = new RecoJetCollection{};
     fGenJetCollection = new GenJetCollection{};
     fTrackCollection = new TrackCollection{};
@@ -40,7 +41,9 @@ Event::Event(const UInt_t& runId, const ULong64_t& eventId, const UInt_t& lumi,
     fVx{vx}, fVy{vy}, fVz{vz},
     fHiBin{(Short_t)hiBin}, fCentralityWeight{centW}, fPtHat{ptHat}, fPtHatWeight{w}, 
     fNBadRecoJets{(UChar_t)nBadRecoJets},
-    fMult{(UShort_t)mult}, fGenJetsCollectionIsFilled{kFALSE} {
+    fMult{(UShort_t)mult}, fGenJetsCollectionIsFilled{kFALSE}, 
+    fTrackView{}, fGenTrackView{}, fRecoJetPool{}, fGenJetPool{}, 
+    fRecoJetCollectionName{}, fExtraRecoJets{} {
     
     // Create new collections 
     fRecoJetCollection = new RecoJetCollection{};
@@ -52,16 +55,24 @@ Event::Event(const UInt_t& runId, const ULong64_t& eventId, const UInt_t& lumi,
 
 //________________
 Event::~Event() {
-    // Clean collection of particle jets
-    for (RecoJetIterator iter=fRecoJetCollection->begin();
-         iter!=fRecoJetCollection->end(); iter++) {
+    // Jets in the collections belong to the jet pools
+    for (RecoJetIterator iter=fRecoJetPool.begin();
+         iter!=fRecoJetPool.end(); iter++) {
         delete *iter;
     }
-    // Clean collection of generated jets
-    for (GenJetIterator iter=fGenJetCollection->begin();
-         iter!=fGenJetCollection->end(); iter++) {
+    for (GenJetIterator iter=fGenJetPool.begin();
+         iter!=fGenJetPool.end(); iter++) {
         delete *iter;
     }
+    for (auto collection : fExtraRecoJets) {
+        for (auto jet : collection->pool) {
+            delete jet;
+        }
+        for (auto jet : collection->genPool) {
+            delete jet;
+        }
+        delete collection;
+    }
     // Clean track collection
     for (TrackIterator iter=fTrackCollection->begin();
          iter!=fTrackCollection->end(); iter++) {
@@ -74,6 +85,129 @@ Event::~Event() {
     }
     // Clear trigger and skim instance
     if (fTrigAndSkim) delete fTrigAndSkim;
+
+    delete fRecoJetCollection;
+    delete fGenJetCollection;
+    delete fTrackCollection;
+    delete fGenTrackCollection;
+}
+
+//________________
+void Event::clear() {
+    fRunId = 0; fEventId = 0; fLumi = 0;
+    fVx = 0; fVy = 0; fVz = 0;
+    fHiBin = -1; fCentralityWeight = 1.;
+    fPtHat = -1; fPtHatWeight = -1;
+    fNBadRecoJets = 0; fMult = 0;
+    fGenJetsCollectionIsFilled = kFALSE;
+
+    // Jets are kept in the pools
+    fRecoJetCollection->clear();
+    fGenJetCollection->clear();
+    for (auto collection : fExtraRecoJets) {
+        collection->jets.clear();
+        collection->genJets.clear();
+    }
+
+    // Tracks are not pooled
+    for (TrackIterator iter=fTrackCollection->begin();
+         iter!=fTrackCollection->end(); iter++) {
+        delete *iter;
+    }
+    fTrackCollection->clear();
+    for (GenTrackIterator iter=fGenTrackCollection->begin();
+         iter!=fGenTrackCollection->end(); iter++) {
+        delete *iter;
+    }
+    fGenTrackCollection->clear();
+    // Views keep their copies for the next event
+    fTrackView.clear();
+    fGenTrackView.clear();
+
+    *fTrigAndSkim = TriggerAndSkim{};
+}
+
+//________________
+RecoJet *Event::newRecoJet() {
+    // Jets of the pool after the last one in the collection are free
+    UInt_t index = fRecoJetCollection->size();
+    if ( index >= fRecoJetPool.size() ) {
+        fRecoJetPool.push_back( new RecoJet{} );
+    }
+    else {
+        *fRecoJetPool[index] = RecoJet{};
+    }
+    return fRecoJetPool[index];
+}
+
+//________________
+GenJet *Event::newGenJet() {
+    // Jets of the pool after the last one in the collection are free
+    UInt_t index = fGenJetCollection->size();
+    if ( index >= fGenJetPool.size() ) {
+        fGenJetPool.push_back( new GenJet{} );
+    }
+    else {
+        *fGenJetPool[index] = GenJet{};
+    }
+    return fGenJetPool[index];
+}
+
+//________________
+int Event::addRecoJetCollection(const std::string& name) {
+    for (unsigned int i{0}; i<fExtraRecoJets.size(); i++) {
+        if ( fExtraRecoJets[i]->name == name ) return static_cast<int>( i );
+    }
+    NamedRecoJets *collection = new NamedRecoJets{};
+    collection->name = name;
+    fExtraRecoJets.push_back( collection );
+    return static_cast<int>( fExtraRecoJets.size() ) - 1;
+}
+
+//________________
+RecoJet *Event::newRecoJet(const int& iCollection) {
+    // Same reuse scheme as for the main collection
+    NamedRecoJets *collection = fExtraRecoJets[iCollection];
+    UInt_t index = collection->jets.size();
+    if ( index >= collection->pool.size() ) {
+        collection->pool.push_back( new RecoJet{} );
+    }
+    else {
+        *collection->pool[index] = RecoJet{};
+    }
+    return collection->pool[index];
+}
+
+//________________
+GenJet *Event::newGenJet(const int& iCollection) {
+    // Same reuse scheme as for the main collection
+    NamedRecoJets *collection = fExtraRecoJets[iCollection];
+    UInt_t index = collection->genJets.size();
+    if ( index >= collection->genPool.size() ) {
+        collection->genPool.push_back( new GenJet{} );
+    }
+    else {
+        *collection->genPool[index] = GenJet{};
+    }
+    return collection->genPool[index];
+}
+
+//________________
+GenJetCollection *Event::genJetCollection(const std::string& name) const {
+    if ( name.empty() || name == fRecoJetCollectionName ) return fGenJetCollection;
+    for (auto collection : fExtraRecoJets) {
+        if ( collection->name == name ) return &collection->genJets;
+    }
+    return nullptr;
+}
+
+//________________
+RecoJetCollection *Event::recoJetCollection(const std::string& name) const {
+    if ( name.empty() || name == fRecoJetCollectionName ) return fRecoJetCollection;
+    for (auto collection : fExtraRecoJets) {
+        if ( collection->name == name ) return &collection->jets;
+    }
+    return nullptr;
 }
 
 //________________
@@ -16,6 +16,11 @@
 #include "TObject.h"
 #include "Collections.h"
 #include "TriggerAndSkim.h"
+#include "TrackView.h"
+
+// C++ headers
+#include <string>
+#include <vector>
 
 //________________
 class Event : public TObject {
@@ -65,6 +70,26 @@ class Event : public TObject {
     /// @brief  Print event information
     void print();
 
+    /// @brief Reset event to the default state. Jets stay allocated
+    /// and are reused by newRecoJet() and newGenJet()
+    void clear();
+    /// @brief Return a reset reco jet from the jet pool of the event. The jet
+    /// is considered as used only after it is added to recoJetCollection()
+    RecoJet *newRecoJet();
+    /// @brief Return a reset generated jet from the jet pool of the event. The jet
+    /// is considered as used only after it is added to genJetCollection()
+    GenJet *newGenJet();
+
+    /// @brief Set name of the main reco jet collection (jet tree it is read from)
+    void setRecoJetCollectionName(const std::string& name) { if ( fRecoJetCollectionName != name ) fRecoJetCollectionName = name; }
+    /// @brief Return index of the additional reco jet collection with the given name.
+    /// The collection is created if it does not exist
+    int addRecoJetCollection(const std::string& name);
+    /// @brief Return a reset reco jet from the jet pool of the additional collection (see newRecoJet())
+    RecoJet *newRecoJet(const int& iCollection);
+    /// @brief Return a reset generated jet from the jet pool of the additional collection (see newGenJet())
+    GenJet *newGenJet(const int& iCollection);
+
     //
     // Getters
     //
@@ -102,10 +127,30 @@ class Event : public TObject {
     TrackCollection *trackCollection() const { return fTrackCollection; }
     /// @brief Return pointer to a collection of MC tracks 
     GenTrackCollection *genTrackCollection() const { return fGenTrackCollection; }
+    /// @brief Return tracks that passed the track cut (viewed over the reader arrays)
+    const TrackView *trackView() const { return &fTrackView; }
+    TrackView *trackView() { return &fTrackView; }
+    /// @brief Return generated charged particles that passed the track cut
+    const GenTrackView *genTrackView() const { return &fGenTrackView; }
+    GenTrackView *genTrackView() { return &fGenTrackView; }
     /// @brief Return pointer to a collection of particle flow jets 
     RecoJetCollection *recoJetCollection() const { return fRecoJetCollection; }
+    /// @brief Return reco jet collection by name (nullptr - not read). Empty name
+    /// or the name of the main collection return recoJetCollection()
+    RecoJetCollection *recoJetCollection(const std::string& name) const;
+    /// @brief Return additional reco jet collection
+    RecoJetCollection *extraRecoJetCollection(const int& iCollection) const { return &fExtraRecoJets[iCollection]->jets; }
+    /// @brief Return number of additional reco jet collections
+    int numberOfExtraRecoJetCollections() const { return static_cast<int>( fExtraRecoJets.size() ); }
+    /// @brief Return name of the main reco jet collection
+    const std::string& recoJetCollectionName() const { return fRecoJetCollectionName; }
     /// @brief Return pointer to a collection of generated jets 
     GenJetCollection *genJetCollection() const { return fGenJetCollection; }
+    /// @brief Return generated jets of the reco jet collection (nullptr - not read). Reco jets
+    /// of a collection are matched to its own generated jets (genJetId is an index in this collection)
+    GenJetCollection *genJetCollection(const std::string& name) const;
+    /// @brief Return generated jets of the additional reco jet collection
+    GenJetCollection *extraGenJetCollection(const int& iCollection) const { return &fExtraRecoJets[iCollection]->genJets; }
     /// @brief Return pointer to a trigger and skimming information 
     TriggerAndSkim *trigAndSkim() const { return fTrigAndSkim; }
 
@@ -146,11 +191,32 @@ class Event : public TObject {
     TrackCollection *fTrackCollection;
     /// @brief MC track collection
     GenTrackCollection *fGenTrackCollection;
-
+    /// @brief Selected tracks
+    TrackView fTrackView; //!
+    /// @brief Selected generated particles
+    GenTrackView fGenTrackView; //!
 
     /// @brief Trigger and skimming information
     TriggerAndSkim *fTrigAndSkim;
 
+    /// @brief All reco jets allocated by the event (owned)
+    std::vector<RecoJet*> fRecoJetPool; //!
+    /// @brief All generated jets allocated by the event (owned)
+    std::vector<GenJet*> fGenJetPool; //!
+
+    /// @brief Additional reco jet collection and its generated jets with their own jet pools
+    struct NamedRecoJets {
+        std::string name{};
+        RecoJetCollection jets{};
+        std::vector<RecoJet*> pool{};
+        GenJetCollection genJets{};
+        std::vector<GenJet*> genPool{};
+    };
+    /// @brief Name of the main reco jet collection
+    std::string fRecoJetCollectionName; //!
+    /// @brief Additional reco jet collections (owned)
+    std::vector<NamedRecoJets*> fExtraRecoJets; //!
+
     ClassDef(Event, 1)
 };
 
@@ -17,6 +17,7 @@
 #include "TString.h"
 
 // C++ headers
+#include <cstdlib>
 #include <iostream>
 
 //________________
@@ -24,26 +25,7 @@ EventCut::EventCut() : fVx{-1e9, 1e9}, fVy{-1e9, 1e9}, fVz{-1e9, 1e9},
     fShiftVx{0}, fShiftVy{0}, fVR{1e9}, 
     fHiBin{-1000, 1000}, fCentVal{-1000., 1000.},
     fPtHat{-1e9, 1e9}, fPtHatWeight{-1e9, 1e9}, fVerbose{false},
-    fPPrimaryVertexFilter{false},
-    fHBHENoiseFilterResultRun2Loose{false},
-    fCollisionEventSelectionAODc2{false},
-    fPhfCoincFilter2Th4{false},
-    fPPAprimaryVertexFilter{false},
-    fPBeamScrapingFilter{false},
-    fPClusterCompatibilityFilter{false},
-    fPhfCoincFilter{false},
-    fPVertexFilterCutdz1p0{false},
-    fPVertexFilterCutGplus{false},
-    fPVertexFilterCutVtx1{false},
-    fHLT_HIAK4CaloJet60_v1{false},
-    fHLT_HIAK4CaloJet80_v1{false},
-    fHLT_HIPuAK4CaloJet80Eta5p1_v1{false},
-    fHLT_PAAK4PFJet60_Eta5p1_v4{false},
-    fHLT_PAAK4PFJet80_Eta5p1_v3{false},
-    fHLT_PAAK4PFJet100_Eta5p1_v3{false},
-    fHLT_PAAK4PFJet120_Eta5p1_v2{false},
-    fHLT_HIAK4PFJet60_v1{false},
-    fHLT_HIAK4PFJet80_v1{false},
+    fRequiredFlags{0},
     fRunIdsToSelect{},
     fRunIdsToExclude{},
     fEventsPassed{0}, fEventsFailed{0} {
@@ -71,6 +53,45 @@ void EventCut::report() {
     std::cout << report.Data() << std::endl;
 }
 
+//________________
+TString EventCut::settings() const {
+    TString settings = TString::Format( "vx=%.9g,%.9g vy=%.9g,%.9g vz=%.9g,%.9g shift=%.9g,%.9g vR=%.9g",
+                                        fVx[0], fVx[1], fVy[0], fVy[1], fVz[0], fVz[1], fShiftVx, fShiftVy, fVR );
+    settings += TString::Format( " hiBin=%d,%d cent=%.9g,%.9g lumi=%u,%u ptHat=%.9g,%.9g ptHatWeight=%.9g,%.9g flags=%llu",
+                                 fHiBin[0], fHiBin[1], fCentVal[0], fCentVal[1], fLumi[0], fLumi[1],
+                                 fPtHat[0], fPtHat[1], fPtHatWeight[0], fPtHatWeight[1],
+                                 static_cast<unsigned long long>( fRequiredFlags ) );
+    settings += " runs=";
+    for (const auto& runId : fRunIdsToSelect) settings += TString::Format( "%u,", runId );
+    settings += " excludedRuns=";
+    for (const auto& runId : fRunIdsToExclude) settings += TString::Format( "%u,", runId );
+    return settings;
+}
+
+//________________
+void EventCut::useFlag(const char *name) {
+    const int flag = TriggerAndSkim::flagIndex( name );
+    if ( flag < 0 ) {
+        std::cerr << Form("[ERROR] EventCut::useFlag - %s is not a known trigger or skimming filter. Terminating\n", name);
+        exit(1);
+    }
+    useFlag( flag );
+}
+
+//________________
+void EventCut::addRequiredInputs(InputRequirements& inputs) const {
+    // Branch names of the HLT or skimming tree
+    for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+        if ( ( fRequiredFlags & TriggerAndSkim::flagBit(iFlag) ) == 0 ) continue;
+        if ( TriggerAndSkim::isSkimFilter( iFlag ) ) {
+            inputs.requireSkimFilter( TriggerAndSkim::flagName( iFlag ) );
+        }
+        else {
+            inputs.requireTrigger( TriggerAndSkim::flagName( iFlag ) );
+        }
+    }
+}
+
 //________________
 bool EventCut::pass(const Event* ev) {
     
@@ -118,174 +139,18 @@ bool EventCut::pass(const Event* ev) {
                           fPtHatWeight[0], ev->ptHatWeight(), fPtHatWeight[1], ( goodPtHatWeight ) ? "true" : "false" );
     }
 
-    bool goodFilters{true};
-    if ( fPPrimaryVertexFilter ) {
-        if ( ev->trigAndSkim()->pprimaryVertexFilter() == 0 ) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad pprimaryVertexFilter\n");
-            }
-        }
-
-    }
-    if ( fHBHENoiseFilterResultRun2Loose ) {
-        if ( ev->trigAndSkim()->HBHENoiseFilterResultRun2Loose() == 0 ) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad HBHENoiseFilterResultRun2Loos\n");
-            }
-        }
-    }
-    if ( fCollisionEventSelectionAODc2 ) {
-        if ( ev->trigAndSkim()->collisionEventSelectionAODv2() == 0 ) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad collisionEventSelectionAODv2\n");
-            }
-        }
-    }
-    if ( fPhfCoincFilter2Th4 ) {
-        if ( ev->trigAndSkim()->phfCoincFilter2Th4() == 0 ) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad phfCoincFilter2Th4\n");
-            }
-        }
-    }
-    if ( fPPAprimaryVertexFilter ) {
-        if ( ev->trigAndSkim()->pPAprimaryVertexFilter() == 0 ) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad pPAprimaryVertexFilter\n");
-            }
-        }
-    }
-    if ( fPBeamScrapingFilter ) {
-        if ( ev->trigAndSkim()->pBeamScrapingFilter() == 0 ) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad pBeamScrapingFilter\n");
-            }
-        }
-    }
-    if ( fPClusterCompatibilityFilter ) {
-        if ( ev->trigAndSkim()->pClusterCompatibilityFilter() == 0 ) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad pClusterCompatibilityFilter\n");
-            }
-        }
-    }
-    if ( fPhfCoincFilter ) {
-        if ( ev->trigAndSkim()->phfCoincFilter() == 0) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad phfCoincFilter\n");
-            }
-        }
-    }
-    if ( fPVertexFilterCutdz1p0 ) {
-        if ( ev->trigAndSkim()->pVertexFilterCutdz1p0() == 0) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad pVertexFilterCutdz1p0\n");
-            }
-        }
-    }
-    if ( fPVertexFilterCutGplus ) {
-        if ( ev->trigAndSkim()->pVertexFilterCutGplus() == 0) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad pVertexFilterCutGplus\n");
-            }
-        }
-    }
-    if ( fPVertexFilterCutVtx1 ) {
-        if ( ev->trigAndSkim()->pVertexFilterCutVtx1() == 0) {
-            goodFilters = {false};
-            if ( fVerbose ) {
-                std::cout << Form("Bad pVertexFilterCutVtx1\n");
+    // Required triggers and skimming filters: one mask comparison
+    const ULong64_t missingFlags = fRequiredFlags & ~ev->trigAndSkim()->mask();
+    const bool goodFilters = ( missingFlags & TriggerAndSkim::skimFilterMask() ) == 0;
+    const bool goodTrigger = ( missingFlags & ~TriggerAndSkim::skimFilterMask() ) == 0;
+    if ( fVerbose ) {
+        for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+            if ( missingFlags & TriggerAndSkim::flagBit(iFlag) ) {
+                std::cout << Form("Bad %s: %s\n", ( TriggerAndSkim::isSkimFilter(iFlag) ) ? "filter" : "trigger",
+                                  TriggerAndSkim::flagName(iFlag));
             }
         }
-    }
-    if (fVerbose) {
         std::cout << Form("Event filters passed: %s\n", (goodFilters) ? "true" : "false");
-    }
-
-    bool goodTrigger{true};
-    if ( fHLT_HIAK4CaloJet60_v1 ) {
-        if ( ev->trigAndSkim()->HLT_HIAK4CaloJet60_v1() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_HIAK4CaloJet60_v1\n");
-            }
-        }
-    }
-    if ( fHLT_HIAK4CaloJet80_v1 ) {
-        if ( ev->trigAndSkim()->HLT_HIAK4CaloJet80_v1() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_HIAK4CaloJet80_v1\n");
-            }
-        }
-    }
-    if ( fHLT_HIPuAK4CaloJet80Eta5p1_v1 ) {
-        if ( ev->trigAndSkim()->HLT_HIPuAK4CaloJet80Eta5p1_v1() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_HIPuAK4CaloJet80Eta5p1_v1\n");
-            }
-        }
-    }
-    if ( fHLT_PAAK4PFJet60_Eta5p1_v4 ) {
-        if ( ev->trigAndSkim()->HLT_PAAK4PFJet60_Eta5p1_v4() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_PAAK4PFJet60_Eta5p1_v4\n");
-            }
-        }
-    }
-    if ( fHLT_PAAK4PFJet80_Eta5p1_v3 ) {
-        if ( ev->trigAndSkim()->HLT_PAAK4PFJet80_Eta5p1_v3() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_PAAK4PFJet80_Eta5p1_v3\n");
-            }
-        }
-    }
-    if ( fHLT_PAAK4PFJet100_Eta5p1_v3 ) {
-        if ( ev->trigAndSkim()->HLT_PAAK4PFJet100_Eta5p1_v3() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_PAAK4PFJet100_Eta5p1_v3\n");
-            }
-        }
-    }
-    if ( fHLT_PAAK4PFJet120_Eta5p1_v2 ) {
-        if ( ev->trigAndSkim()->HLT_PAAK4PFJet120_Eta5p1_v2() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_PAAK4PFJet120_Eta5p1_v2\n");
-            }
-        }
-    }
-    if ( fHLT_HIAK4PFJet60_v1) {
-        if ( ev->trigAndSkim()->HLT_HIAK4PFJet60_v1() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_HIAK4PFJet60_v1\n");
-            }
-        }
-    }
-    if ( fHLT_HIAK4PFJet80_v1) {
-        if ( ev->trigAndSkim()->HLT_HIAK4PFJet80_v1() == 0 ) {
-            goodTrigger = { false };
-            if ( fVerbose ) {
-                std::cout << Form("Bad trigger: HLT_HIAK4PFJet80_v1\n");
-            }
-        }
-    }
-    if ( fVerbose ) {
         std::cout << Form("Event triggers passed: %s\n", (goodTrigger) ? "true" : "false");
     }
 
@@ -14,9 +14,12 @@
 
 // Jet analysis headers
 #include "Event.h"
+#include "InputRequirements.h"
+#include "TriggerAndSkim.h"
 
 // ROOT headers
 #include "Rtypes.h"
+#include "TString.h"
 
 // C++ headers
 #include <limits>
@@ -58,36 +61,44 @@ class EventCut {
     void setPtHatWeight(const double& lo=-1e9, const double& hi=1e9) { fPtHatWeight[0]=lo; fPtHatWeight[1]=hi; }
     /// @brief Print information each event
     void setVerbose() { fVerbose = {true}; }
+    /// @brief Require trigger or skimming filter (TriggerAndSkim::Flag) to be set
+    void useFlag(const int& flag) { fRequiredFlags |= TriggerAndSkim::flagBit(flag); }
+    /// @brief Require trigger or skimming filter with the given branch name to be set
+    void useFlag(const char *name);
     // Skim selection criteria
-    void usePPrimaryVertexFilter()           { fPPrimaryVertexFilter = {true}; }
-    void useHBHENoiseFilterResultRun2Loose() { fHBHENoiseFilterResultRun2Loose = {true}; }
-    void useCollisionEventSelectionAODv2()   { fCollisionEventSelectionAODc2 = {true}; }
-    void usePhfCoincFilter2Th4()             { fPhfCoincFilter2Th4 = {true}; }
-    void usePPAprimaryVertexFilter()         { fPPAprimaryVertexFilter = {true}; }
-    void usePBeamScrapingFilter()            { fPBeamScrapingFilter = {true}; }
-    void usePClusterCompatibilityFilter()    { fPClusterCompatibilityFilter = {true}; }
-    void useHLT_HIPuAK4CaloJet80Eta5p1_v1()  { fHLT_HIPuAK4CaloJet80Eta5p1_v1 = {true}; }
-    void useHLT_PAAK4PFJet60_Eta5p1_v4()     { fHLT_PAAK4PFJet60_Eta5p1_v4 = {true}; }
-    void useHLT_PAAK4PFJet80_Eta5p1_v3()     { fHLT_PAAK4PFJet80_Eta5p1_v3 = {true}; }
-    void useHLT_PAAK4PFJet100_Eta5p1_v3()    { fHLT_PAAK4PFJet100_Eta5p1_v3 = {true}; }
-    void useHLT_PAAK4PFJet120_Eta5p1_v2()    { fHLT_PAAK4PFJet120_Eta5p1_v2 = {true}; }
-    void useHLT_HIAK4CaloJet60_v1()          { fHLT_HIAK4CaloJet60_v1 = {true}; }
-    void useHLT_HIAK4CaloJet80_v1()          { fHLT_HIAK4CaloJet80_v1 = {true}; }
-    void useHLT_HIAK4PFJet60_v1()            { fHLT_HIAK4PFJet60_v1 = {true}; }
-    void useHLT_HIAK4PFJet80_v1()            { fHLT_HIAK4PFJet80_v1 = {true}; }
-
-    void usePhfCoincFilter()                { fPhfCoincFilter = {true}; }
-    void usePVertexFilterCutdz1p0()         { fPVertexFilterCutdz1p0 = {true}; }
-    void usePVertexFilterCutGplus()         { fPVertexFilterCutGplus = {true}; }
-    void usePVertexFilterCutVtx1()          { fPVertexFilterCutVtx1 = {true}; }
+    void usePPrimaryVertexFilter()           { useFlag(TriggerAndSkim::kPprimaryVertexFilter); }
+    void useHBHENoiseFilterResultRun2Loose() { useFlag(TriggerAndSkim::kHBHENoiseFilterResultRun2Loose); }
+    void useCollisionEventSelectionAODv2()   { useFlag(TriggerAndSkim::kCollisionEventSelectionAODv2); }
+    void usePhfCoincFilter2Th4()             { useFlag(TriggerAndSkim::kPhfCoincFilter2Th4); }
+    void usePPAprimaryVertexFilter()         { useFlag(TriggerAndSkim::kPPAprimaryVertexFilter); }
+    void usePBeamScrapingFilter()            { useFlag(TriggerAndSkim::kPBeamScrapingFilter); }
+    void usePClusterCompatibilityFilter()    { useFlag(TriggerAndSkim::kPClusterCompatibilityFilter); }
+    void useHLT_HIPuAK4CaloJet80Eta5p1_v1()  { useFlag(TriggerAndSkim::kHLT_HIPuAK4CaloJet80Eta5p1_v1); }
+    void useHLT_PAAK4PFJet60_Eta5p1_v4()     { useFlag(TriggerAndSkim::kHLT_PAAK4PFJet60_Eta5p1_v4); }
+    void useHLT_PAAK4PFJet80_Eta5p1_v3()     { useFlag(TriggerAndSkim::kHLT_PAAK4PFJet80_Eta5p1_v3); }
+    void useHLT_PAAK4PFJet100_Eta5p1_v3()    { useFlag(TriggerAndSkim::kHLT_PAAK4PFJet100_Eta5p1_v3); }
+    void useHLT_PAAK4PFJet120_Eta5p1_v2()    { useFlag(TriggerAndSkim::kHLT_PAAK4PFJet120_Eta5p1_v2); }
+    void useHLT_HIAK4CaloJet60_v1()          { useFlag(TriggerAndSkim::kHLT_HIAK4CaloJet60_v1); }
+    void useHLT_HIAK4CaloJet80_v1()          { useFlag(TriggerAndSkim::kHLT_HIAK4CaloJet80_v1); }
+    void useHLT_HIAK4PFJet60_v1()            { useFlag(TriggerAndSkim::kHLT_HIAK4PFJet60_v1); }
+    void useHLT_HIAK4PFJet80_v1()            { useFlag(TriggerAndSkim::kHLT_HIAK4PFJet80_v1); }
+
+    void usePhfCoincFilter()                { useFlag(TriggerAndSkim::kPhfCoincFilter); }
+    void usePVertexFilterCutdz1p0()         { useFlag(TriggerAndSkim::kPVertexFilterCutdz1p0); }
+    void usePVertexFilterCutGplus()         { useFlag(TriggerAndSkim::kPVertexFilterCutGplus); }
+    void usePVertexFilterCutVtx1()          { useFlag(TriggerAndSkim::kPVertexFilterCutVtx1); }
 
     void addRunIdToSelect(const unsigned int& runId) { fRunIdsToSelect.push_back(runId); }
     void addRunIdToExclude(const unsigned int& runId) { fRunIdsToExclude.push_back(runId); }
 
     /// @brief Report information about
     void report();
+    /// @brief Return cut limits as a single line (statistics are not included)
+    TString settings() const;
     /// @brief Check if evn 
     virtual bool pass(const Event* ev);
+    /// @brief Add triggers and skimming filters used by the cut
+    void addRequiredInputs(InputRequirements& inputs) const;
 
   private:
     /// @brief Vertex x interval
@@ -116,32 +127,8 @@ class EventCut {
     /// @brief  Print information each time
     bool fVerbose;
 
-    // Skim flags 
-    bool fPPrimaryVertexFilter;
-    bool fHBHENoiseFilterResultRun2Loose;
-    bool fCollisionEventSelectionAODc2;
-    bool fPhfCoincFilter2Th4;
-
-    bool fPPAprimaryVertexFilter;
-    bool fPBeamScrapingFilter;
-    bool fPClusterCompatibilityFilter;
-    bool fPhfCoincFilter;
-    bool fPVertexFilterCutdz1p0;
-    bool fPVertexFilterCutGplus;
-    bool fPVertexFilterCutVtx1;
-
-    // Triggers
-    bool fHLT_HIAK4CaloJet60_v1; // pp5020
-    bool fHLT_HIAK4CaloJet80_v1; // pp5020
-
-    bool fHLT_HIPuAK4CaloJet80Eta5p1_v1;
-    bool fHLT_PAAK4PFJet60_Eta5p1_v4;  // pPb 8160
-    bool fHLT_PAAK4PFJet80_Eta5p1_v3;  // pPb 8160
-    bool fHLT_PAAK4PFJet100_Eta5p1_v3; // pPb 8160
-    bool fHLT_PAAK4PFJet120_Eta5p1_v2; // pPb 8160
-
-    bool fHLT_HIAK4PFJet60_v1;         // pp 5020
-    bool fHLT_HIAK4PFJet80_v1;         // pp 5020
+    /// @brief Triggers and skimming filters that must be set (bits of TriggerAndSkim::Flag)
+    ULong64_t fRequiredFlags;
 
     // Include next runIds
     std::vector<unsigned int> fRunIdsToSelect;
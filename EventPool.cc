@@ -0,0 +1,48 @@
+/**
+ * @file EventPool.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Pool of events reused by the event reader
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "EventPool.h"
+
+//________________
+EventPool::EventPool() : fFreeEvents{}, fNCreated{0} {
+    /* empty */
+}
+
+//________________
+EventPool::~EventPool() {
+    for (auto event : fFreeEvents) {
+        delete event;
+    }
+}
+
+//________________
+Event *EventPool::get() {
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if ( !fFreeEvents.empty() ) {
+            Event *event = fFreeEvents.back();
+            fFreeEvents.pop_back();
+            return event;
+        }
+        fNCreated++;
+    }
+    return new Event{};
+}
+
+//________________
+void EventPool::put(Event *event) {
+    if ( !event ) return;
+    // Clear outside the lock: jets stay allocated
+    event->clear();
+    std::lock_guard<std::mutex> lock(fMutex);
+    fFreeEvents.push_back( event );
+}
@@ -0,0 +1,51 @@
+/**
+ * @file EventPool.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Pool of events reused by the event reader
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef EventPool_h
+#define EventPool_h
+
+// Jet analysis headers
+#include "Event.h"
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <mutex>
+#include <vector>
+
+//________________
+class EventPool {
+  public:
+    /// @brief Constructor
+    EventPool();
+    /// @brief Destructor. Deletes all events returned to the pool
+    virtual ~EventPool();
+
+    /// @brief Return a cleared event (a new one is created if the pool is empty)
+    Event *get();
+    /// @brief Return event to the pool
+    void put(Event *event);
+
+    /// @brief Number of events created by the pool
+    UInt_t nCreated() const { return fNCreated; }
+
+  private:
+
+    /// @brief Events ready to be reused
+    std::vector<Event*> fFreeEvents;
+    /// @brief Events may be returned from another thread (read-ahead mode)
+    std::mutex fMutex;
+    /// @brief Number of events created by the pool
+    UInt_t fNCreated;
+};
+
+#endif // #define EventPool_h
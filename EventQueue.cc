@@ -0,0 +1,84 @@
+/**
+ * @file EventQueue.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Bounded queue of events read ahead by a reader thread
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "EventQueue.h"
+
+// ROOT headers
+#include "TString.h"
+
+// C++ headers
+#include <chrono>
+#include <iostream>
+
+//________________
+EventQueue::EventQueue(const unsigned int& depth) : fDepth{ (depth < 1) ? 1 : depth }, fEvents{}, fIsClosed{false},
+    fNPushStalls{0}, fPushStallTime{0.}, fNPopStalls{0}, fPopStallTime{0.}, fNEvents{0} {
+    /* empty */
+}
+
+//________________
+bool EventQueue::push(Event *event, const Int_t& status) {
+    std::unique_lock<std::mutex> lock(fMutex);
+    if ( fEvents.size() >= fDepth && !fIsClosed ) {
+        // Reader is ahead of the analysis
+        auto start = std::chrono::steady_clock::now();
+        fNotFull.wait(lock, [this] { return fEvents.size() < fDepth || fIsClosed; });
+        fNPushStalls++;
+        fPushStallTime += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    }
+    if ( fIsClosed ) return false;
+    fEvents.emplace_back( event, status );
+    fNEvents++;
+    lock.unlock();
+    fNotEmpty.notify_one();
+    return true;
+}
+
+//________________
+void EventQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fIsClosed = true;
+    }
+    fNotFull.notify_all();
+}
+
+//________________
+unsigned int EventQueue::size() {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fEvents.size();
+}
+
+//________________
+Event *EventQueue::pop(Int_t& status) {
+    std::unique_lock<std::mutex> lock(fMutex);
+    if ( fEvents.empty() ) {
+        // Analysis waits for input
+        auto start = std::chrono::steady_clock::now();
+        fNotEmpty.wait(lock, [this] { return !fEvents.empty(); });
+        fNPopStalls++;
+        fPopStallTime += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    }
+    Event *event = fEvents.front().first;
+    status = fEvents.front().second;
+    fEvents.pop_front();
+    lock.unlock();
+    fNotFull.notify_one();
+    return event;
+}
+
+//________________
+void EventQueue::report(const char *name) const {
+    std::cout << Form("%s (depth: %u) events passed: %lld\n", name, fDepth, fNEvents)
+              << Form("  reader waited for analysis: %lld times, %.2f sec\n", fNPushStalls, fPushStallTime)
+              << Form("  analysis waited for reader: %lld times, %.2f sec\n", fNPopStalls, fPopStallTime);
+}
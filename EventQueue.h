@@ -0,0 +1,95 @@
+/**
+ * @file EventQueue.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Bounded queue of events read ahead by a reader thread
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef EventQueue_h
+#define EventQueue_h
+
+// Jet analysis headers
+#include "Event.h"
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+//________________
+class EventQueue {
+  public:
+    /// @brief Constructor
+    /// @param depth Maximal number of events stored in the queue
+    EventQueue(const unsigned int& depth = 16);
+    /// @brief Destructor
+    virtual ~EventQueue() { /* empty */ }
+
+    /// @brief Add event to the queue (waits if the queue is full). Event
+    /// may be nullptr if it did not pass the event selection
+    /// @param event Event returned by the reader
+    /// @param status Reader status after the event was read
+    /// @return false if the queue is closed (event is not added)
+    bool push(Event *event, const Int_t& status);
+    /// @brief Take event from the queue (waits if the queue is empty)
+    /// @param status Reader status after the event was read
+    /// @return Event returned by the reader
+    Event *pop(Int_t& status);
+
+    /// @brief Stop accepting events: the analysis does not need more events
+    void close();
+    /// @brief Return number of events in the queue
+    unsigned int size();
+
+    /// @brief Return maximal number of events in the queue
+    unsigned int depth() const            { return fDepth; }
+    /// @brief Number of times the reader waited for the analysis (queue was full)
+    Long64_t nPushStalls() const          { return fNPushStalls; }
+    /// @brief Time (in seconds) the reader waited for the analysis
+    double pushStallTime() const          { return fPushStallTime; }
+    /// @brief Number of times the analysis waited for the reader (queue was empty)
+    Long64_t nPopStalls() const           { return fNPopStalls; }
+    /// @brief Time (in seconds) the analysis waited for the reader
+    double popStallTime() const           { return fPopStallTime; }
+    /// @brief Number of events passed through the queue
+    Long64_t nEvents() const              { return fNEvents; }
+
+    /// @brief Print stall statistics
+    void report(const char *name = "EventQueue") const;
+
+  private:
+
+    /// @brief Maximal number of events in the queue
+    unsigned int fDepth;
+    /// @brief Events (and reader status) read ahead
+    std::deque< std::pair<Event*, Int_t> > fEvents;
+    /// @brief Mutex that guards the queue
+    std::mutex fMutex;
+    /// @brief Signals that the queue is not full
+    std::condition_variable fNotFull;
+    /// @brief Signals that the queue is not empty
+    std::condition_variable fNotEmpty;
+    /// @brief Queue does not accept events
+    bool fIsClosed;
+
+    /// @brief Number of times the reader waited for the analysis
+    Long64_t fNPushStalls;
+    /// @brief Time (in seconds) the reader waited for the analysis
+    double fPushStallTime;
+    /// @brief Number of times the analysis waited for the reader
+    Long64_t fNPopStalls;
+    /// @brief Time (in seconds) the analysis waited for the reader
+    double fPopStallTime;
+    /// @brief Number of events passed through the queue
+    Long64_t fNEvents;
+};
+
+#endif // #define EventQueue_h
@@ -11,17 +11,33 @@
 
 // Jet analysis headers
 #include "ForestAODReader.h"
+#include "ForestRNTupleInput.h"
 
 // ROOT headers
+#include "TBranch.h"
+#include "TEnv.h"
 #include "TFile.h"
+#include "TLeaf.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
 
 // C++ headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 //_________________
-ForestAODReader::ForestAODReader() : fEvent{nullptr}, fInFileName{nullptr}, fEvents2Read{0}, fEventsProcessed{0},
+ForestAODReader::ForestAODReader() : fEvent{nullptr}, fEventPool{nullptr}, fInFileName{nullptr}, fEvents2Read{0}, fEventsProcessed{0},
+    fEntriesInChain{0}, fEntriesInRange{0},
+    fCurrentEntry{0}, fEntriesRead{0}, fEntriesRejectedEarly{0},
     fIsMc{false}, fCorrectCentMC{false}, fUseHltBranch{kTRUE}, fUseSkimmingBranch{kTRUE}, 
     fUseRecoJetBranch{kTRUE}, 
     fUseTrackBranch{false}, fUseGenTrackBranch{false},
@@ -31,17 +47,28 @@ ForestAODReader::ForestAODReader() : fEvent{nullptr}, fInFileName{nullptr}, fEve
     fJEC{nullptr}, fJECFiles{}, fJECPath{}, fJEU{nullptr}, fJEUInputFileName{},
     fCollisionSystemName{Form("PbPb")}, fCollisionSystem{1}, fCollisionEnergyGeV{5020},
     fYearOfDataTaking{2018}, fDoJetPtSmearing{false}, 
-    fFixJetArrays{false}, fEventCut{nullptr}, fJetCut{nullptr},
+    fFixJetArrays{false}, fEventCut{nullptr}, fJetCut{nullptr}, fTrackCut{nullptr},
     fRecoJet2GenJetId{}, fGenJet2RecoJet{}, 
     fUseExtraJECforAk4Cs{false}, fJECScaleCorr{nullptr}, fUseJEU{0},
     fUseJERSystematics{0}, fAlphaJER{0.0415552}, fBetaJER{0.960013},
     fJERSmearFunc{nullptr}, fRndm{nullptr},
-    fEtaShift{0}, fVerbose{false} {
+    fEtaShift{0}, fVerbose{false}, fStageGetEntry{-1}, fStageEventConstruction{-1}, 
+    fStageJetCorrections{-1}, fStageJetCut{-1}, fStageEventCut{-1}, fStageClearVariables{-1},
+    fTreeCacheSize{-1}, fChainTreeCacheSize{}, fTreeCacheLearnEntries{0}, fUseAsyncPrefetch{false}, fChainIO{},
+    fUseFriendChain{false}, fUseEventIndex{false}, fAlignmentCheck{1}, fAlignmentTreeNumber{-1}, fCheckObjectAlignment{false},
+    fNValidationThreads{8}, fEntryManifest{}, fUseEntryManifest{false}, fInputFileEntries{}, fIsInputPrepared{false},
+    fJetBufferSize{0}, fTrackBufferSize{0}, fJetBufferTreeNumber{-1}, fTrackBufferTreeNumber{-1},
+    fJetCollectionInputs{}, fUseRNTupleInput{false}, fRNTupleInput{nullptr} {
     if ( fVerbose ) {
         std::cout << "ForestAODReader::ForestAODReader()" << std::endl;
     }
     // Initialize many variables
     fRndm = new TRandom3(0);
+    fEventPool = new EventPool{};
+    // Buffers are allocated from the input at init()
+    fNRecoJets = 0;
+    fNGenJets = 0;
+    fNTracks = 0;
     clearVariables();
     setJERSystParams();
 }
@@ -52,22 +79,36 @@ ForestAODReader::ForestAODReader(const char* inputStream,
                                  const bool& useRecoJetBranch, 
                                  const bool& useTrackBranch, const bool& useGenTrackBranch, 
                                  const bool& isMc) : 
-    fEvent{nullptr}, fInFileName{inputStream}, fEvents2Read{0}, 
-    fEventsProcessed{0}, fIsMc{isMc}, fCorrectCentMC{false}, 
+    fEvent{nullptr}, fEventPool{nullptr}, fInFileName{inputStream}, fEvents2Read{0}, 
+    fEventsProcessed{0}, fEntriesInChain{0}, fEntriesInRange{0},
+    fCurrentEntry{0}, fEntriesRead{0}, fEntriesRejectedEarly{0}, fIsMc{isMc}, fCorrectCentMC{false}, 
     fUseManualJEC{false}, fIsPbGoingDir{true},
     fUseHltBranch{useHltBranch}, fUseSkimmingBranch{useSkimmingBranch}, 
     fUseRecoJetBranch{useRecoJetBranch}, 
     fUseTrackBranch{useTrackBranch}, fUseGenTrackBranch{useGenTrackBranch},
+    fHltTree{nullptr}, fSkimTree{nullptr}, fEventTree{nullptr},
+    fRecoJetTree{nullptr}, fTrkTree{nullptr}, fGenTrkTree{nullptr},
     fRecoJetTreeName{"akCs4PFJetAnalyzer"},
     fJEC{nullptr}, fJECFiles{}, fJECPath{}, fJEU{nullptr}, fJEUInputFileName{},
     fCollisionSystemName{Form("PbPb")}, fCollisionEnergyGeV{5020},
     fYearOfDataTaking{2018}, fDoJetPtSmearing{false}, 
-    fFixJetArrays{false}, fEventCut{nullptr}, fJetCut{nullptr},
+    fFixJetArrays{false}, fEventCut{nullptr}, fJetCut{nullptr}, fTrackCut{nullptr},
     fJECScaleCorr{nullptr}, fUseJEU{0}, fUseJERSystematics{0}, 
     fAlphaJER{0.0415552}, fBetaJER{0.960013}, fJERSmearFunc{nullptr}, 
-    fVerbose{false} {
+    fVerbose{false}, fStageGetEntry{-1}, fStageEventConstruction{-1}, 
+    fStageJetCorrections{-1}, fStageJetCut{-1}, fStageEventCut{-1}, fStageClearVariables{-1},
+    fTreeCacheSize{-1}, fChainTreeCacheSize{}, fTreeCacheLearnEntries{0}, fUseAsyncPrefetch{false}, fChainIO{},
+    fUseFriendChain{false}, fUseEventIndex{false}, fAlignmentCheck{1}, fAlignmentTreeNumber{-1}, fCheckObjectAlignment{false},
+    fNValidationThreads{8}, fEntryManifest{}, fUseEntryManifest{false}, fInputFileEntries{}, fIsInputPrepared{false},
+    fJetBufferSize{0}, fTrackBufferSize{0}, fJetBufferTreeNumber{-1}, fTrackBufferTreeNumber{-1},
+    fJetCollectionInputs{}, fUseRNTupleInput{false}, fRNTupleInput{nullptr} {
     // Initialize many variables
     fRndm = new TRandom3(0);
+    fEventPool = new EventPool{};
+    // Buffers are allocated from the input at init()
+    fNRecoJets = 0;
+    fNGenJets = 0;
+    fNTracks = 0;
     clearVariables();
 
     if ( fVerbose ) {
@@ -81,17 +122,24 @@ ForestAODReader::~ForestAODReader() {
     if ( fVerbose ) {
         std::cout << "ForestAODReader::~ForestAODReader()";
     }
-    if (fEvent) delete fEvent;
+    // Events handed out are returned to the pool by the user
+    if (fEventPool) delete fEventPool;
     if (fHltTree) delete fHltTree;
     if (fSkimTree) delete fSkimTree;
     if (fEventTree) delete fEventTree;
     if (fRecoJetTree) delete fRecoJetTree;
+    for (auto& input : fJetCollectionInputs) {
+        if (input.chain) delete input.chain;
+        if (input.jec) delete input.jec;
+    }
     if (fTrkTree) delete fTrkTree;
     if (fGenTrkTree) delete fGenTrkTree;
+    if (fRNTupleInput) delete fRNTupleInput;
     if (fJEC) delete fJEC;
     if (fJEU) delete fJEU;
     if (fEventCut) delete fEventCut;
     if (fJetCut) delete fJetCut;
+    if (fTrackCut) delete fTrackCut;
     if (fJECScaleCorr) delete fJECScaleCorr;
     if (fJERSmearFunc) delete fJERSmearFunc;
 }
@@ -458,6 +506,496 @@ double ForestAODReader::jecManualCorrection(const double &pt, const double &eta)
     return retVal;
 }
 
+//_________________
+void ForestAODReader::clearArrays(const int& nRecoJets, const int& nGenJets, const int& nTracks) {
+
+    // Counters may be broken if the entry could not be read
+    const size_t nReco = std::min( static_cast<size_t>( std::max( nRecoJets, 0 ) ), fJetBufferSize );
+    const size_t nGen = std::min( static_cast<size_t>( std::max( nGenJets, 0 ) ), fJetBufferSize );
+    const size_t nTrk = std::min( static_cast<size_t>( std::max( nTracks, 0 ) ), fTrackBufferSize );
+
+    // Reco jet variables
+    std::fill_n( fRecoJetPt.data(), nReco, 0.f );
+    std::fill_n( fRecoJetEta.data(), nReco, 0.f );
+    std::fill_n( fRecoJetPhi.data(), nReco, 0.f );
+    std::fill_n( fRecoJetWTAEta.data(), nReco, 0.f );
+    std::fill_n( fRecoJetWTAPhi.data(), nReco, 0.f );
+    std::fill_n( fRecoJetTrackMax.data(), nReco, 0.f );
+
+    // Ref jet variables
+    std::fill_n( fRefJetPt.data(), nReco, 0.f );
+    std::fill_n( fRefJetEta.data(), nReco, 0.f );
+    std::fill_n( fRefJetPhi.data(), nReco, 0.f );
+    std::fill_n( fRefJetWTAEta.data(), nReco, 0.f );
+    std::fill_n( fRefJetWTAPhi.data(), nReco, 0.f );
+    std::fill_n( fRefJetPartonFlavor.data(), nReco, -999 );
+    std::fill_n( fRefJetPartonFlavorForB.data(), nReco, -99 );
+
+    // Gen jet variables
+    std::fill_n( fGenJetPt.data(), nGen, 0.f );
+    std::fill_n( fGenJetEta.data(), nGen, 0.f );
+    std::fill_n( fGenJetPhi.data(), nGen, 0.f );
+    std::fill_n( fGenJetWTAEta.data(), nGen, 0.f );
+    std::fill_n( fGenJetWTAPhi.data(), nGen, 0.f );
+
+    // Track variables
+    std::fill_n( fTrackPt.data(), nTrk, 0.f );
+    std::fill_n( fTrackEta.data(), nTrk, 0.f );
+    std::fill_n( fTrackPhi.data(), nTrk, 0.f );
+    std::fill_n( fTrackPtErr.data(), nTrk, 0.f );
+    std::fill_n( fTrackDcaXY.data(), nTrk, 0.f );
+    std::fill_n( fTrackDcaZ.data(), nTrk, 0.f );
+    std::fill_n( fTrackDcaXYErr.data(), nTrk, 0.f );
+    std::fill_n( fTrackDcaZErr.data(), nTrk, 0.f );
+    std::fill_n( fTrackChi2.data(), nTrk, 0.f );
+    std::fill_n( fTrackNDOF.data(), nTrk, 0 );
+    std::fill_n( fTrackPartFlowEcal.data(), nTrk, 0.f );
+    std::fill_n( fTrackPartFlowHcal.data(), nTrk, 0.f );
+    std::fill_n( fTrackMVA.data(), nTrk, 0.f );
+    std::fill_n( fTrackAlgo.data(), nTrk, 0 );
+    std::fill_n( fTrackCharge.data(), nTrk, 0 );
+    std::fill_n( fTrackNHits.data(), nTrk, 0 );
+    std::fill_n( fTrackNLayers.data(), nTrk, 0 );
+    std::fill_n( fTrackHighPurity.data(), nTrk, false );
+}
+
+//_________________
+void ForestAODReader::allocateJetBuffers(const size_t& n) {
+    fRecoJetPt.allocate( n );
+    fRecoJetTrackMax.allocate( n );
+    fRecoJetEta.allocate( n );
+    fRecoJetPhi.allocate( n );
+    fRecoJetWTAEta.allocate( n );
+    fRecoJetWTAPhi.allocate( n );
+    fRecoJtPfNHF.allocate( n );
+    fRecoJtPfNEF.allocate( n );
+    fRecoJtPfCHF.allocate( n );
+    fRecoJtPfMUF.allocate( n );
+    fRecoJtPfCEF.allocate( n );
+    fRecoJtPfCHM.allocate( n );
+    fRecoJtPfCEM.allocate( n );
+    fRecoJtPfNHM.allocate( n );
+    fRecoJtPfNEM.allocate( n );
+    fRecoJtPfMUM.allocate( n );
+    fGenJetPt.allocate( n );
+    fGenJetEta.allocate( n );
+    fGenJetPhi.allocate( n );
+    fGenJetWTAEta.allocate( n );
+    fGenJetWTAPhi.allocate( n );
+    fRefJetPt.allocate( n );
+    fRefJetEta.allocate( n );
+    fRefJetPhi.allocate( n );
+    fRefJetWTAEta.allocate( n );
+    fRefJetWTAPhi.allocate( n );
+    fRefJetPartonFlavor.allocate( n );
+    fRefJetPartonFlavorForB.allocate( n );
+    fJetBufferSize = n;
+}
+
+//_________________
+void ForestAODReader::allocateTrackBuffers(const size_t& n) {
+    fTrackPt.allocate( n );
+    fTrackEta.allocate( n );
+    fTrackPhi.allocate( n );
+    fTrackPtErr.allocate( n );
+    fTrackDcaXY.allocate( n );
+    fTrackDcaXYErr.allocate( n );
+    fTrackDcaZ.allocate( n );
+    fTrackDcaZErr.allocate( n );
+    fTrackChi2.allocate( n );
+    fTrackNDOF.allocate( n );
+    fTrackCharge.allocate( n );
+    fTrackNHits.allocate( n );
+    fTrackNLayers.allocate( n );
+    fTrackHighPurity.allocate( n );
+    fTrackPartFlowEcal.allocate( n );
+    fTrackPartFlowHcal.allocate( n );
+    fTrackMVA.allocate( n );
+    fTrackAlgo.allocate( n );
+    fTrackBufferSize = n;
+}
+
+//_________________
+void ForestAODReader::setJetBranchAddresses() {
+    fRecoJetTree->SetBranchAddress("rawpt", fRecoJetPt.data());
+    fRecoJetTree->SetBranchAddress("trackMax", fRecoJetTrackMax.data());
+    fRecoJetTree->SetBranchAddress("jteta", fRecoJetEta.data());
+    fRecoJetTree->SetBranchAddress("jtphi", fRecoJetPhi.data());
+    fRecoJetTree->SetBranchAddress("WTAeta", fRecoJetWTAEta.data());
+    fRecoJetTree->SetBranchAddress("WTAphi", fRecoJetWTAPhi.data());
+    fRecoJetTree->SetBranchAddress("jtPfNHF", fRecoJtPfNHF.data());
+    fRecoJetTree->SetBranchAddress("jtPfNEF", fRecoJtPfNEF.data());
+    fRecoJetTree->SetBranchAddress("jtPfCHF", fRecoJtPfCHF.data());
+    fRecoJetTree->SetBranchAddress("jtPfMUF", fRecoJtPfMUF.data());
+    fRecoJetTree->SetBranchAddress("jtPfCEF", fRecoJtPfCEF.data());
+    fRecoJetTree->SetBranchAddress("jtPfCHM", fRecoJtPfCHM.data());
+    fRecoJetTree->SetBranchAddress("jtPfCEM", fRecoJtPfCEM.data());
+    fRecoJetTree->SetBranchAddress("jtPfNHM", fRecoJtPfNHM.data());
+    fRecoJetTree->SetBranchAddress("jtPfNEM", fRecoJtPfNEM.data());
+    fRecoJetTree->SetBranchAddress("jtPfMUM", fRecoJtPfMUM.data());
+
+    if ( fIsMc ) {
+        fRecoJetTree->SetBranchAddress("genpt", fGenJetPt.data());
+        fRecoJetTree->SetBranchAddress("geneta", fGenJetEta.data());
+        fRecoJetTree->SetBranchAddress("genphi", fGenJetPhi.data());
+        fRecoJetTree->SetBranchAddress("WTAgeneta", fGenJetWTAEta.data());
+        fRecoJetTree->SetBranchAddress("WTAgenphi", fGenJetWTAPhi.data());
+        fRecoJetTree->SetBranchAddress("refpt", fRefJetPt.data());
+        fRecoJetTree->SetBranchAddress("refeta", fRefJetEta.data());
+        fRecoJetTree->SetBranchAddress("refphi", fRefJetPhi.data());
+        fRecoJetTree->SetBranchAddress("refWTAeta", fRefJetWTAEta.data());
+        fRecoJetTree->SetBranchAddress("refWTAphi", fRefJetWTAPhi.data());
+        fRecoJetTree->SetBranchAddress("refparton_flavor", fRefJetPartonFlavor.data());
+        fRecoJetTree->SetBranchAddress("refparton_flavorForB", fRefJetPartonFlavorForB.data());
+    }
+}
+
+//_________________
+void ForestAODReader::setTrackBranchAddresses() {
+    fTrkTree->SetBranchAddress("trkPt", fTrackPt.data());
+    fTrkTree->SetBranchAddress("trkEta", fTrackEta.data());
+    fTrkTree->SetBranchAddress("trkPhi", fTrackPhi.data());
+    fTrkTree->SetBranchAddress("trkPtError", fTrackPtErr.data());
+    fTrkTree->SetBranchAddress("trkDxy1", fTrackDcaXY.data());
+    fTrkTree->SetBranchAddress("trkDxyError1", fTrackDcaXYErr.data());
+    fTrkTree->SetBranchAddress("trkDz1", fTrackDcaZ.data());
+    fTrkTree->SetBranchAddress("trkDzError1", fTrackDcaZErr.data());
+    fTrkTree->SetBranchAddress("trkChi2", fTrackChi2.data());
+    fTrkTree->SetBranchAddress("trkNdof", fTrackNDOF.data());
+    fTrkTree->SetBranchAddress("trkCharge", fTrackCharge.data());
+    fTrkTree->SetBranchAddress("trkNHit", fTrackNHits.data());
+    fTrkTree->SetBranchAddress("trkNlayer", fTrackNLayers.data());
+    fTrkTree->SetBranchAddress("highPurity", fTrackHighPurity.data());
+    fTrkTree->SetBranchAddress("pfEcal", fTrackPartFlowEcal.data());
+    fTrkTree->SetBranchAddress("pfHcal", fTrackPartFlowHcal.data());
+    fTrkTree->SetBranchAddress("trkMVA", fTrackMVA.data());
+    fTrkTree->SetBranchAddress("trkAlgo", fTrackAlgo.data());
+}
+
+//_________________
+size_t ForestAODReader::maximalArrayLength(TTree *tree, const char *counterName) const {
+    TLeaf *leaf = ( tree ) ? tree->GetLeaf( counterName ) : nullptr;
+    if ( !leaf ) return 0;
+    // Counter leaves keep the maximal value written into the file
+    Long64_t maximum = leaf->GetMaximum();
+    if ( maximum <= 0 && tree->GetEntries() > 0 ) {
+        // Not stored by some writers: the counter branch is scanned once
+        maximum = static_cast<Long64_t>( tree->GetMaximum( counterName ) );
+    }
+    return ( maximum > 0 ) ? static_cast<size_t>( maximum ) : 0;
+}
+
+//_________________
+void ForestAODReader::fitBuffers(const int& iChain) {
+    TChain *chain = ( iChain == kJetChain ) ? fRecoJetTree : fTrkTree;
+    int &bufferTreeNumber = ( iChain == kJetChain ) ? fJetBufferTreeNumber : fTrackBufferTreeNumber;
+    if ( !chain ) return;
+    // Checked once per file
+    const int treeNumber = chain->GetTreeNumber();
+    if ( treeNumber == bufferTreeNumber && treeNumber >= 0 ) return;
+    bufferTreeNumber = treeNumber;
+    TTree *tree = chain->GetTree();
+
+    if ( iChain == kJetChain ) {
+        size_t n = maximalArrayLength( tree, "nref" );
+        if ( fIsMc ) {
+            n = std::max( n, maximalArrayLength( tree, "ngen" ) );
+        }
+        // Buffers only grow: the addresses are kept for the files with shorter arrays
+        if ( n <= fJetBufferSize && fJetBufferSize > 0 ) return;
+        allocateJetBuffers( std::max( n, fJetBufferSize + 1 ) );
+        setJetBranchAddresses();
+        if ( fVerbose || treeNumber > 0 ) {
+            std::cout << Form("ForestAODReader: jet buffers are allocated for %zu jets (file %d)\n", fJetBufferSize, treeNumber);
+        }
+    }
+    else {
+        const size_t n = maximalArrayLength( tree, "nTrk" );
+        if ( n <= fTrackBufferSize && fTrackBufferSize > 0 ) return;
+        allocateTrackBuffers( std::max( n, fTrackBufferSize + 1 ) );
+        setTrackBranchAddresses();
+        if ( fVerbose || treeNumber > 0 ) {
+            std::cout << Form("ForestAODReader: track buffers are allocated for %zu tracks (file %d)\n", fTrackBufferSize, treeNumber);
+        }
+    }
+}
+
+//_________________
+void ForestAODReader::checkBufferOverflow() const {
+    // Counters above the maximum stored in the file mean the arrays were written past the buffers
+    const bool jetOverflow = fUseRecoJetBranch && ( static_cast<size_t>( std::max( fNRecoJets, 0 ) ) > fJetBufferSize ||
+                                                    ( fIsMc && static_cast<size_t>( std::max( fNGenJets, 0 ) ) > fJetBufferSize ) );
+    const bool trackOverflow = fUseTrackBranch && static_cast<size_t>( std::max( fNTracks, 0 ) ) > fTrackBufferSize;
+    if ( jetOverflow || trackOverflow ) {
+        std::cerr << Form("[ERROR] ForestAODReader::checkBufferOverflow - entry %lld: nref/ngen/nTrk = %d/%d/%d exceed buffer sizes %zu/%zu. Terminating\n",
+                          fCurrentEntry, fNRecoJets, fNGenJets, fNTracks, fJetBufferSize, fTrackBufferSize);
+        exit(1);
+    }
+}
+
+//________________
+void ForestAODReader::fillTrackViews() {
+    // Views point to the reader arrays: no object is created per track
+    if ( fUseTrackBranch ) {
+        TrackColumns columns;
+        columns.pt = fTrackPt.data();
+        columns.eta = fTrackEta.data();
+        columns.phi = fTrackPhi.data();
+        columns.ptErr = fTrackPtErr.data();
+        columns.dcaXY = fTrackDcaXY.data();
+        columns.dcaXYErr = fTrackDcaXYErr.data();
+        columns.dcaZ = fTrackDcaZ.data();
+        columns.dcaZErr = fTrackDcaZErr.data();
+        columns.chi2 = fTrackChi2.data();
+        columns.pfEcal = fTrackPartFlowEcal.data();
+        columns.pfHcal = fTrackPartFlowHcal.data();
+        columns.mva = fTrackMVA.data();
+        columns.nDOF = fTrackNDOF.data();
+        columns.nHits = fTrackNHits.data();
+        columns.nLayers = fTrackNLayers.data();
+        columns.algo = fTrackAlgo.data();
+        columns.charge = fTrackCharge.data();
+        columns.highPurity = fTrackHighPurity.data();
+
+        TrackView *tracks = fEvent->trackView();
+        tracks->setColumns( columns, fNTracks );
+        for (int iTrack{0}; iTrack<tracks->nTracksInput(); iTrack++) {
+            if ( !fTrackCut || fTrackCut->pass( columns, iTrack ) ) {
+                tracks->select( iTrack );
+            }
+        }
+        // Arrays are overwritten by the next entry before a queued event is used
+        if ( fEventsAreQueued ) tracks->detach();
+    } // if ( fUseTrackBranch )
+
+    if ( fIsMc && fUseGenTrackBranch ) {
+        // Vectors of a broken entry may have different lengths
+        const size_t nGen = std::min( { fGenTrackPt.size(), fGenTrackEta.size(), fGenTrackPhi.size(),
+                                        fGenTrackCharge.size(), fGenTrackPid.size(), fGenTrackSube.size() } );
+        GenTrackColumns columns;
+        columns.pt = fGenTrackPt.data();
+        columns.eta = fGenTrackEta.data();
+        columns.phi = fGenTrackPhi.data();
+        columns.charge = fGenTrackCharge.data();
+        columns.pdg = fGenTrackPid.data();
+        columns.sube = fGenTrackSube.data();
+
+        GenTrackView *particles = fEvent->genTrackView();
+        particles->setColumns( columns, static_cast<int>( nGen ) );
+        for (int iTrack{0}; iTrack<particles->nTracksInput(); iTrack++) {
+            if ( !fTrackCut || fTrackCut->pass( columns, iTrack ) ) {
+                particles->select( iTrack );
+            }
+        }
+        if ( fEventsAreQueued ) particles->detach();
+    } // if ( fIsMc && fUseGenTrackBranch )
+}
+
+//________________
+void ForestAODReader::addJetCollection(const char *treeName, const std::vector<std::string>& jecFiles) {
+    if ( fRecoJetTreeName == treeName ) {
+        std::cout << Form("[WARNING] ForestAODReader::addJetCollection - %s is the main jet tree\n", treeName);
+        return;
+    }
+    for (auto& input : fJetCollectionInputs) {
+        if ( input.name == treeName ) {
+            std::cout << Form("[WARNING] ForestAODReader::addJetCollection - %s is already added\n", treeName);
+            return;
+        }
+    }
+    JetCollectionInput input;
+    input.name = treeName;
+    input.jecFiles = jecFiles;
+    fJetCollectionInputs.push_back( std::move( input ) );
+}
+
+//________________
+void ForestAODReader::setupJetCollections() {
+    for (auto& input : fJetCollectionInputs) {
+        if ( !input.chain ) continue;
+        TChain *chain = input.chain;
+        chain->SetBranchStatus("*", 0);
+        std::vector<const char*> names{ "nref", "rawpt", "jteta", "jtphi", "trackMax", "WTAeta", "WTAphi",
+                                        "jtPfNHF", "jtPfNEF", "jtPfCHF", "jtPfMUF", "jtPfCEF",
+                                        "jtPfCHM", "jtPfCEM", "jtPfNHM", "jtPfNEM", "jtPfMUM" };
+        if ( fIsMc ) {
+            for (auto name : { "refeta", "refphi", "refparton_flavor", "refparton_flavorForB",
+                               "ngen", "genpt", "geneta", "genphi", "WTAgeneta", "WTAgenphi" }) {
+                names.push_back( name );
+            }
+        }
+        for (auto name : names) {
+            chain->SetBranchStatus( name, 1 );
+        }
+        chain->SetBranchAddress( "nref", &input.nJets );
+        if ( fIsMc ) chain->SetBranchAddress( "ngen", &input.nGenJets );
+
+        // Array addresses are set when buffers are sized from the first file
+        chain->LoadTree( 0 );
+        fitBuffers( input );
+        std::cout << Form("Jet tree %s is read in addition to %s\n", input.name.c_str(), fRecoJetTreeName.Data());
+    }
+}
+
+//________________
+void ForestAODReader::fitBuffers(JetCollectionInput& input) {
+    // Checked once per file
+    const int treeNumber = input.chain->GetTreeNumber();
+    if ( treeNumber == input.bufferTreeNumber && treeNumber >= 0 ) return;
+    input.bufferTreeNumber = treeNumber;
+    size_t n = maximalArrayLength( input.chain->GetTree(), "nref" );
+    if ( fIsMc ) n = std::max( n, maximalArrayLength( input.chain->GetTree(), "ngen" ) );
+    if ( n <= input.bufferSize && input.bufferSize > 0 ) return;
+    allocateJetCollectionBuffers( input, std::max( n, input.bufferSize + 1 ) );
+    if ( fVerbose || treeNumber > 0 ) {
+        std::cout << Form("ForestAODReader: %s buffers are allocated for %zu jets (file %d)\n", 
+                          input.name.c_str(), input.bufferSize, treeNumber);
+    }
+}
+
+//________________
+void ForestAODReader::allocateJetCollectionBuffers(JetCollectionInput& input, const size_t& n) {
+    input.bufferSize = n;
+    std::vector< std::pair<const char*, BranchBuffer<float>*> > floats{ 
+        {"rawpt", &input.rawPt}, {"jteta", &input.eta}, {"jtphi", &input.phi}, 
+        {"WTAeta", &input.wtaEta}, {"WTAphi", &input.wtaPhi}, {"trackMax", &input.trackMax},
+        {"jtPfNHF", &input.pfNHF}, {"jtPfNEF", &input.pfNEF}, {"jtPfCHF", &input.pfCHF}, 
+        {"jtPfMUF", &input.pfMUF}, {"jtPfCEF", &input.pfCEF}, 
+        {"refeta", &input.refEta}, {"refphi", &input.refPhi},
+        {"genpt", &input.genPt}, {"geneta", &input.genEta}, {"genphi", &input.genPhi},
+        {"WTAgeneta", &input.genWTAEta}, {"WTAgenphi", &input.genWTAPhi} };
+    std::vector< std::pair<const char*, BranchBuffer<int>*> > ints{ 
+        {"jtPfCHM", &input.pfCHM}, {"jtPfCEM", &input.pfCEM}, {"jtPfNHM", &input.pfNHM}, 
+        {"jtPfNEM", &input.pfNEM}, {"jtPfMUM", &input.pfMUM},
+        {"refparton_flavor", &input.refFlavor}, {"refparton_flavorForB", &input.refFlavorForB} };
+    for (auto& column : floats) {
+        column.second->allocate( input.bufferSize );
+        if ( input.chain && input.chain->GetBranch( column.first ) ) input.chain->SetBranchAddress( column.first, column.second->data() );
+    }
+    for (auto& column : ints) {
+        column.second->allocate( input.bufferSize );
+        if ( input.chain && input.chain->GetBranch( column.first ) ) input.chain->SetBranchAddress( column.first, column.second->data() );
+    }
+}
+
+//________________
+void ForestAODReader::readJetCollection(JetCollectionInput& input) {
+    if ( input.fromRNTuple ) {
+        input.nJets = 0;
+        input.nGenJets = 0;
+        fRNTupleInput->readEntry( input.name, fCurrentEntry );
+        return;
+    }
+    if ( !input.chain ) return;
+    // Jet trees of the forest have the same entries as the event tree
+    input.nJets = 0;
+    input.nGenJets = 0;
+    input.chain->LoadTree( fCurrentEntry );
+    fitBuffers( input );
+    input.chain->GetEntry( fCurrentEntry );
+    const size_t nJets = static_cast<size_t>( std::max( std::max( input.nJets, input.nGenJets ), 0 ) );
+    if ( nJets > input.bufferSize ) {
+        std::cerr << Form("[ERROR] ForestAODReader::readJetCollection - entry %lld: %d reco and %d gen %s jets exceed buffer size %zu. Terminating\n",
+                          fCurrentEntry, input.nJets, input.nGenJets, input.name.c_str(), input.bufferSize);
+        exit(1);
+    }
+}
+
+//________________
+void ForestAODReader::fillJetCollection(JetCollectionInput& input) {
+    if ( !input.chain && !input.fromRNTuple ) return;
+    const int iCollection = fEvent->addRecoJetCollection( input.name );
+    RecoJetCollection *jets = fEvent->extraRecoJetCollection( iCollection );
+    GenJetCollection *genJets = fEvent->extraGenJetCollection( iCollection );
+
+    // Reco jets are matched to the generated jets of the same tree: ref jets of a tree
+    // with another jet radius are not in the generated jets of the main tree
+    std::vector<int> recoJet2GenJet( std::max( input.nJets, 0 ), -1 );
+    std::vector<int> genJet2RecoJet( std::max( input.nGenJets, 0 ), -1 );
+    if ( fIsMc ) {
+        for (int iJet{0}; iJet<input.nJets; iJet++) {
+            for (int iGenJet{0}; iGenJet<input.nGenJets; iGenJet++) {
+                if ( fabs( input.refEta[iJet] - input.genEta[iGenJet] ) < 1e-5 &&
+                     fabs( input.refPhi[iJet] - input.genPhi[iGenJet] ) < 1e-5 ) {
+                    recoJet2GenJet[iJet] = iGenJet;
+                    genJet2RecoJet[iGenJet] = iJet;
+                    break;
+                }
+            }
+        }
+
+        // Gen jets are not allowed to be thrown away by any cuts
+        for (int iGenJet{0}; iGenJet<input.nGenJets; iGenJet++) {
+            GenJet *jet = fEvent->newGenJet( iCollection );
+            jet->setId( iGenJet );
+            jet->setPt( input.genPt[iGenJet] );
+            jet->setEta( input.genEta[iGenJet] );
+            jet->setPhi( input.genPhi[iGenJet] );
+            jet->setWTAEta( input.genWTAEta[iGenJet] );
+            jet->setWTAPhi( input.genWTAPhi[iGenJet] );
+            const int iRecoJet = genJet2RecoJet[iGenJet];
+            if ( iRecoJet >= 0 ) {
+                jet->setFlavor( input.refFlavor[iRecoJet] );
+                jet->setFlavorForB( input.refFlavorForB[iRecoJet] );
+            }
+            jet->setPtWeight( 1. );
+            genJets->push_back( jet );
+        }
+    }
+
+    for (int iJet{0}; iJet<input.nJets; iJet++) {
+
+        // Take a jet instance from the pool of the collection
+        RecoJet *jet = fEvent->newRecoJet( iCollection );
+        jet->setId( iJet );
+        jet->setRawPt( input.rawPt[iJet] );
+        jet->setEta( input.eta[iJet] );
+        jet->setPhi( input.phi[iJet] );
+        jet->setWTAEta( input.wtaEta[iJet] );
+        jet->setWTAPhi( input.wtaPhi[iJet] );
+        jet->setTrackMaxPt( input.trackMax[iJet] );
+
+        if ( fIsMc ) jet->setGenJetId( recoJet2GenJet[iJet] );
+
+        StageTimer jecTimer(fStageStats, fStageJetCorrections);
+        if ( input.jec ) {
+            input.jec->SetJetPT( input.rawPt[iJet] );
+            input.jec->SetJetEta( input.eta[iJet] );
+            input.jec->SetJetPhi( input.phi[iJet] );
+            double pTcorr = input.jec->GetCorrectedPT();
+            if ( fIsMc && ( TMath::Abs( fUseJERSystematics ) <= 1 ) && jet->hasMatching() ) {
+                pTcorr *= extraJERCorr( genJets->at( jet->genJetId() )->pt(), input.eta[iJet] );
+            }
+            jet->setPtJECCorr( pTcorr );
+        }
+        else {
+            jet->setPtJECCorr( -999.f );
+        }
+        jecTimer.stop();
+
+        jet->setJtPfNHF( input.pfNHF[iJet] );
+        jet->setJtPfNEF( input.pfNEF[iJet] );
+        jet->setJtPfCHF( input.pfCHF[iJet] );
+        jet->setJtPfMUF( input.pfMUF[iJet] );
+        jet->setJtPfCEF( input.pfCEF[iJet] );
+        jet->setJtPfCHM( input.pfCHM[iJet] );
+        jet->setJtPfCEM( input.pfCEM[iJet] );
+        jet->setJtPfNHM( input.pfNHM[iJet] );
+        jet->setJtPfNEM( input.pfNEM[iJet] );
+        jet->setJtPfMUM( input.pfMUM[iJet] );
+
+        bool isGoodJet{true};
+        {
+            StageTimer timer(fStageStats, fStageJetCut);
+            isGoodJet = ( !fJetCut || fJetCut->pass(jet, false, false, false) );
+        }
+        // Jet stays in the pool and is reused by the next one
+        if ( !isGoodJet ) continue;
+
+        jets->push_back( jet );
+    } // for (int iJet{0}; iJet<input.nJets; iJet++)
+}
+
 //_________________
 void ForestAODReader::clearVariables() {
     if ( fVerbose ) {
@@ -473,124 +1011,18 @@ void ForestAODReader::clearVariables() {
 
     // bad jets and multiplicity to be added
 
+    // Arrays are filled only up to the number of jets and tracks read, the
+    // rest stays cleared: only the part filled by the previous entry is reset
+    {
+        StageTimer timer(fStageStats, fStageClearVariables);
+        clearArrays( fNRecoJets, fNGenJets, fNTracks );
+    }
+
     fNRecoJets = {0};
     fNGenJets = {0};
     fNTracks = {0};
 
-    fHLT_HIAK4CaloJet60_v1 = {0};
-    fHLT_HIAK4CaloJet80_v1 = {0};
-    fHLT_PAAK4CaloJet60_Eta5p1_v3 = {0};
-    fHLT_PAAK4CaloJet80_Eta5p1_v3 = {0};
-    fHLT_PAAK4CaloJet100_Eta5p1_v3 = {0};
-    fHLT_PAAK4PFJet60_Eta5p1_v4 = {0};
-    fHLT_PAAK4PFJet80_Eta5p1_v3 = {0};
-    fHLT_PAAK4PFJet100_Eta5p1_v3 = {0};
-    fHLT_PAAK4PFJet120_Eta5p1_v2 = {0};
-
-    fHLT_HIAK4PFJet15_v1 = {0};
-    fHLT_HIAK4PFJet15_v1_Prescl = {0};
-    fHLT_HIAK4PFJet30_v1 = {0};
-    fHLT_HIAK4PFJet30_v1_Prescl = {0};
-    fHLT_HIAK4PFJet40_v1 = {0};
-    fHLT_HIAK4PFJet40_v1_Prescl = {0};
-    fHLT_HIAK4PFJet60_v1 = {0};
-    fHLT_HIAK4PFJet60_v1_Prescl = {0};
-    fHLT_HIAK4PFJet80_v1 = {0};
-    fHLT_HIAK4PFJet80_v1_Prescl = {0};
-    fHLT_HIAK4PFJet120_v1 = {0};
-    fHLT_HIAK4PFJet120_v1_Prescl = {0};
-
-    fHLT_HIAK8PFJet15_v1 = {0};
-    fHLT_HIAK8PFJet15_v1_Prescl = {0};
-    fHLT_HIAK8PFJet25_v1 = {0};
-    fHLT_HIAK8PFJet25_v1_Prescl = {0};
-    fHLT_HIAK8PFJet40_v1 = {0};
-    fHLT_HIAK8PFJet40_v1_Prescl = {0};
-    fHLT_HIAK8PFJet60_v1 = {0};
-    fHLT_HIAK8PFJet60_v1_Prescl = {0};
-    fHLT_HIAK8PFJet80_v1 = {0};
-    fHLT_HIAK8PFJet80_v1_Prescl = {0};
-    fHLT_HIAK8PFJet140_v1 = {0};
-    fHLT_HIAK8PFJet140_v1_Prescl = {0};
-
-    fHLT_HIPFJet25_v1 = {0};
-    fHLT_HIPFJet25_v1_Prescl = {0};
-    fHLT_HIPFJet140_v1 = {0};
-    fHLT_HIPFJet140_v1_Prescl = {0};
-
-    fHLT_HIPuAK4CaloJet80Eta5p1_v1 = {0};
-    fHLT_HIPuAK4CaloJet100Eta5p1_v1 = {0};
-
-    fHBHENoiseFilterResultRun2Loose = {0};
-    fHBHENoiseFilterResultRun2Tight = {0};
-    fHBHEIsoNoiseFilterResult = {0};
-    fCollisionEventSelectionAODv2 = {0};
-    fPhfCoincFilter2Th4 = {0};
-    fPPAprimaryVertexFilter = {0};
-    fPBeamScrapingFilter = {0};
-    fPprimaryVertexFilter = {0};
-    fPVertexFilterCutG = {0};
-    fPVertexFilterCutGloose = {0};
-    fPVertexFilterCutGtight = {0};
-    fPVertexFilterCutE = {0};
-    fPVertexFilterCutEandG = {0};
-    fPClusterCompatibilityFilter = {0};
-
-    fPhfCoincFilter = {0};
-    fPVertexFilterCutdz1p0 = {0};
-    fPVertexFilterCutGplus = {0};
-    fPVertexFilterCutVtx1 = {0};
-
-    // Loop over jets and tracks
-    for (size_t i{0}; i<TRACK_ARRAY_SIZE; i++) {
-
-        // Jet variables
-        if (i<JET_ARRAY_SIZE) {
-            // Reco jet variables
-            fRecoJetPt[i] = {0.f};
-            fRecoJetEta[i] = {0.f};
-            fRecoJetPhi[i] = {0.f};
-            fRecoJetWTAEta[i] = {0.f};
-            fRecoJetWTAPhi[i] = {0.f};
-            fRecoJetTrackMax[i] = {0.f};
-
-            // Ref jet variables
-            fRefJetPt[i] = {0.f};
-            fRefJetEta[i] = {0.f};
-            fRefJetPhi[i] = {0.f};
-            fRefJetWTAEta[i] = {0.f};
-            fRefJetWTAPhi[i] = {0.f};
-            fRefJetPartonFlavor[i] = {-999};
-            fRefJetPartonFlavorForB[i] = {-99};
-
-            // Gen jet variables
-            fGenJetPt[i] = {0.f};
-            fGenJetEta[i] = {0.f};
-            fGenJetPhi[i] = {0.f};
-            fGenJetWTAEta[i] = {0.f};
-            fGenJetWTAPhi[i] = {0.f};
-        } // if (i<100)
-        
-        // Track variables
-        fTrackPt[i] = {0.f};
-        fTrackEta[i] = {0.f};
-        fTrackPhi[i] = {0.f};
-        fTrackPtErr[i] = {0.f};
-        fTrackDcaXY[i] = {0.f};
-        fTrackDcaZ[i] = {0.f};
-        fTrackDcaXYErr[i] = {0.f};
-        fTrackDcaZErr[i] = {0.f};
-        fTrackChi2[i] = {0.f};
-        fTrackNDOF[i] = {0};
-        fTrackPartFlowEcal[i] = {0.f};
-        fTrackPartFlowHcal[i] = {0.f};
-        fTrackMVA[i] = {0.f};
-        fTrackAlgo[i] = {0};
-        fTrackCharge[i] = {0};
-        fTrackNHits[i] = {0};
-        fTrackNLayers[i] = {0};
-        fTrackHighPurity[i] = {false};
-    } // for (short i{0}; i<9999; i++)
+    std::fill_n( fTriggerAndSkim, static_cast<int>( TriggerAndSkim::kNFlags ), 0 );
 
     if ( fIsMc && fUseGenTrackBranch ) {
         fGenTrackPt.clear();
@@ -617,10 +1049,37 @@ int ForestAODReader::init() {
         std::cout << "ForestAODReader::init()" << std::endl;
     }
     int status = 0;
-    // Setup chains to read
-    status = setupChains();
-    // Setup branches to read
-    setupBranches();
+    // Must be set before any file is opened
+    if ( fUseAsyncPrefetch ) {
+        gEnv->SetValue("TFile.AsyncPrefetching", 1);
+    }
+    if ( fUseRNTupleInput ) {
+        // Fields are read into the buffers of the trees
+        status = setupRNTupleInput();
+        applyEntryRange();
+    }
+    else {
+        // Setup chains to read
+        status = setupChains();
+        // Restrict reading to the requested entry range
+        applyEntryRange();
+        // Setup branches to read
+        setupBranches();
+        // Additional jet trees read in the same pass
+        setupJetCollections();
+        // Skip branches that are not used
+        applyRequiredInputs();
+        // Chains used for reading
+        setupChainIO();
+        // Check that entries of all trees belong to the same event
+        setupAlignmentCheck();
+        // Read all trees through the event tree
+        if ( fUseFriendChain ) {
+            setupFriendChain();
+        }
+        // Cache only branches that are read
+        setupTreeCache();
+    }
     // Setup jet energy correction files and pointer
     setupJEC();
     // Setup jet energy uncertainty files and pointer
@@ -656,15 +1115,17 @@ void ForestAODReader::setupJEC() {
     }
 
     // Need to add path in front of the file name
-    std::vector< std::string > tmp;
-    for (unsigned int i{0}; i<fJECFiles.size(); i++) {
-        tmp.push_back( Form( "%s/aux_files/%s_%i/JEC/%s", 
-                             fJECPath.Data(), fCollisionSystemName.Data(),
-                             fCollisionEnergyGeV, fJECFiles.at(i).c_str() ) );
-    }
+    auto addPath = [this](const std::vector< std::string >& files) {
+        std::vector< std::string > tmp;
+        for (unsigned int i{0}; i<files.size(); i++) {
+            tmp.push_back( Form( "%s/aux_files/%s_%i/JEC/%s", 
+                                 fJECPath.Data(), fCollisionSystemName.Data(),
+                                 fCollisionEnergyGeV, files.at(i).c_str() ) );
+        }
+        return tmp;
+    };
         
-    fJECFiles.clear();
-    fJECFiles = tmp;
+    fJECFiles = addPath( fJECFiles );
 
     std::cout << "JEC files added: " << std::endl;
     for (unsigned int i{0}; i<fJECFiles.size(); i++) {
@@ -673,6 +1134,20 @@ void ForestAODReader::setupJEC() {
 	
 	fJEC = new JetCorrector( fJECFiles );
 
+    // Each additional jet tree has its own corrections
+    for (auto& input : fJetCollectionInputs) {
+        if ( !input.chain || input.jecFiles.empty() ) {
+            std::cout << Form("[WARNING] No JEC files for %s jets: corrected pT is not set\n", input.name.c_str());
+            continue;
+        }
+        input.jecFiles = addPath( input.jecFiles );
+        std::cout << "JEC files of " << input.name << ": " << std::endl;
+        for (unsigned int i{0}; i<input.jecFiles.size(); i++) {
+            std::cout << i << " " << input.jecFiles.at(i) << std::endl;
+        }
+        input.jec = new JetCorrector( input.jecFiles );
+    }
+
     if ( fUseExtraJECforAk4Cs ) {
         createExtraJECScaleCorrFunction();
     }
@@ -744,7 +1219,30 @@ double ForestAODReader::evalCentralityWeight(const double& x) {
 
 //_________________
 void ForestAODReader::finish() {
-    // Nothing to do here
+    // Report I/O of all chains (the current files are not collected yet)
+    for (int iChain{0}; iChain<static_cast<int>( fChainIO.size() ); iChain++) {
+        ChainIO &io = fChainIO.at(iChain);
+        if ( !io.chain ) continue;
+        collectIOStats( iChain );
+        Long64_t cachedBytes = io.cacheBytesRead + io.noCacheBytesRead;
+        std::cout << Form("I/O of %-8s chain: cache %6.1f MB, read %9.1f MB in %lld calls, cache hit ratio %5.1f%%\n",
+                          io.name.c_str(), ( io.cacheSize > 0 ) ? io.cacheSize / 1024. / 1024. : 0.,
+                          io.bytesRead / 1024. / 1024., io.readCalls, 
+                          ( cachedBytes > 0 ) ? 100. * io.cacheBytesRead / cachedBytes : 0. );
+        // Statistics of the current file are not collected twice
+        io.chain = nullptr;
+    }
+    if ( fRNTupleInput ) {
+        fRNTupleInput->report();
+    }
+    if ( fUseRecoJetBranch || fUseTrackBranch ) {
+        std::cout << Form("ForestAODReader: buffers are allocated for %zu jets and %zu tracks\n",
+                          fJetBufferSize, fTrackBufferSize);
+    }
+    if ( fEntriesRead > 0 ) {
+        std::cout << Form("ForestAODReader: %lld of %lld entries were rejected before jets and tracks were read\n",
+                          fEntriesRejectedEarly, fEntriesRead);
+    }
 }
 
 //_________________
@@ -775,6 +1273,9 @@ int ForestAODReader::setupChains() {
     // Use particle flow jet branch
     if ( fUseRecoJetBranch ) {
         fRecoJetTree = new TChain( Form( "%s/t", fRecoJetTreeName.Data() ) );
+        for (auto& input : fJetCollectionInputs) {
+            input.chain = new TChain( Form( "%s/t", input.name.c_str() ) );
+        }
     }
     // Use reconstructed track branch
     if ( fUseTrackBranch ) {
@@ -804,59 +1305,45 @@ int ForestAODReader::setupChains() {
             if ( fUseHltBranch ) fHltTree->Add( input.Data() );
             if ( fUseSkimmingBranch ) fSkimTree->Add( input.Data() );
             if ( fUseRecoJetBranch ) fRecoJetTree->Add( input.Data() );
+            for (auto& jets : fJetCollectionInputs) {
+                if ( jets.chain ) jets.chain->Add( input.Data() );
+            }
             if ( fUseTrackBranch ) fTrkTree->Add( input.Data() );
             if ( fIsMc && fUseGenTrackBranch ) fGenTrkTree->Add( input.Data() );
 
-            fEvents2Read = fEventTree->GetEntries();
-            std::cout << Form("Total number of events to read: %lld\n", fEvents2Read );
+            fEntriesInChain = fEventTree->GetEntries();
+            std::cout << Form("Total number of events to read: %lld\n", fEntriesInChain );
             Long64_t fEvents2Read2 = fRecoJetTree->GetEntries();
             std::cout << Form("Total number of events to read2: %lld\n", fEvents2Read2 );
         }
         // Assuming that list of files is provided instead of a single file
         else {
-            std::ifstream inputStream( input.Data() );
+            // Files are validated once (forked processes reuse the list of the parent)
+            prepareInput();
 
-            if ( !inputStream ) std::cout << Form( "ERROR: Cannot open file list: %s\n", input.Data() );
             int nFiles = 0;
-            std::string file;
-            size_t pos;
-            while ( getline( inputStream, file ) ) {
-                // NOTE: our external formatters may pass "file NumEvents"
-                //       Take only the first part
-                //cout << "DEBUG found " <<  file << endl;
-                pos = file.find_first_of(" ");
-                if ( pos != std::string::npos ) file.erase( pos, file.length() - pos );
-                //cout << "DEBUG found [" <<  file << "]" << endl;
-
-                // Check that file is of a correct name
-                if ( file.find(".root") != std::string::npos /* && file.find("Forest") != std::string::npos &&
-                     file.find("AOD") != std::string::npos */ ) {
-                    
-                    // Open file
-                    TFile* ftmp = TFile::Open(file.c_str());
-
-                    // Check file is not zombie and contains information
-                    if ( ftmp && !ftmp->IsZombie() && ftmp->GetNkeys() ) {
-                        std::cout << Form("Adding file to chain: %s\n", file.c_str() );
-                        // Adding file to chains
-                        fEventTree->Add( file.c_str() );
-                        if ( fUseHltBranch ) fHltTree->Add( file.c_str() );
-                        if ( fUseSkimmingBranch ) fSkimTree->Add( file.c_str() );
-                        if ( fUseRecoJetBranch ) fRecoJetTree->Add( file.c_str() );
-                        if ( fUseTrackBranch ) fTrkTree->Add( file.c_str() );
-                        if ( fIsMc && fUseGenTrackBranch ) fGenTrkTree->Add( file.c_str() );
-                        ++nFiles;
-                    } //if(ftmp && !ftmp->IsZombie() && ftmp->GetNkeys())
-
-                    if (ftmp) {
-                        ftmp->Close();
-                    } //if (ftmp)
-                } //if ( file.find(".root") != std::string::npos && file.find("Forest") != std::string::npos && file.find("AOD") != std::string::npos )
-            } //while ( getline( inputStream, file ) )
+            for (const auto& file : fInputFileEntries) {
+                const std::string& name = file.first;
+                const Long64_t entries = file.second;
+                // Zombie files, files without keys and empty trees are skipped
+                if ( entries <= 0 ) continue;
+                std::cout << Form("Adding file to chain: %s\n", name.c_str() );
+                // Known number of entries: the event tree files are not opened
+                fEventTree->Add( name.c_str(), entries );
+                if ( fUseHltBranch ) fHltTree->Add( name.c_str() );
+                if ( fUseSkimmingBranch ) fSkimTree->Add( name.c_str() );
+                if ( fUseRecoJetBranch ) fRecoJetTree->Add( name.c_str() );
+                for (auto& jets : fJetCollectionInputs) {
+                    if ( jets.chain ) jets.chain->Add( name.c_str() );
+                }
+                if ( fUseTrackBranch ) fTrkTree->Add( name.c_str() );
+                if ( fIsMc && fUseGenTrackBranch ) fGenTrkTree->Add( name.c_str() );
+                ++nFiles;
+            }
 
             std::cout << Form("Total number of files in chain: %d\n", nFiles);
-            fEvents2Read = fEventTree->GetEntries();
-            std::cout << Form("Total number of events to read: %lld\n", fEvents2Read );
+            fEntriesInChain = fEventTree->GetEntries();
+            std::cout << Form("Total number of events to read: %lld\n", fEntriesInChain );
         } // else {   if file list
         returnStatus = 0;
     } // else {   if normal input
@@ -867,6 +1354,358 @@ int ForestAODReader::setupChains() {
     return returnStatus;
 }
 
+//_________________
+void ForestAODReader::prepareInput() {
+
+    if ( fIsInputPrepared ) return;
+    fIsInputPrepared = {true};
+    // Single files and RNTuples are opened by init()
+    TString input( ( fInFileName ) ? fInFileName : "" );
+    if ( fUseRNTupleInput || input.Length() <= 0 || input.Index(".root") > 0 ) return;
+
+    std::vector<std::string> files;
+    readInputFiles( files );
+
+    // Unchanged valid files listed in the manifest are not opened again
+    TString manifest = ( fEntryManifest.Length() > 0 ) ? fEntryManifest : TString( Form("%s.manifest", input.Data()) );
+    std::map<std::string, InputFileInfo> knownEntries;
+    if ( fUseEntryManifest ) {
+        readEntryManifest( manifest, knownEntries );
+    }
+    std::vector<std::string> newFiles;
+    for (const auto& name : files) {
+        auto known = knownEntries.find( name );
+        if ( known == knownEntries.end() || !isEntryUpToDate( name, known->second ) ) {
+            newFiles.push_back( name );
+        }
+    }
+    std::vector<InputFileInfo> newEntries;
+    validateFiles( newFiles, newEntries );
+    for (size_t iFile{0}; iFile<newFiles.size(); iFile++) {
+        knownEntries[ newFiles.at(iFile) ] = newEntries.at(iFile);
+    }
+    std::cout << Form("Files in list: %zu, taken from the entry manifest: %zu, opened: %zu\n",
+                      files.size(), files.size() - newFiles.size(), newFiles.size());
+    if ( fUseEntryManifest && !newFiles.empty() ) {
+        writeEntryManifest( manifest, knownEntries );
+    }
+
+    fInputFileEntries.clear();
+    for (const auto& name : files) {
+        fInputFileEntries.emplace_back( name, knownEntries[ name ].entries );
+    }
+}
+
+//_________________
+void ForestAODReader::readInputFiles(std::vector<std::string>& files) const {
+    TString input(fInFileName);
+    // Single ROOT file
+    if ( input.Index(".root") > 0 ) {
+        files.push_back( input.Data() );
+        return;
+    }
+
+    std::ifstream inputStream( input.Data() );
+
+    if ( !inputStream ) std::cout << Form( "ERROR: Cannot open file list: %s\n", input.Data() );
+    std::string file;
+    size_t pos;
+    while ( getline( inputStream, file ) ) {
+        // NOTE: our external formatters may pass "file NumEvents"
+        //       Take only the first part
+        pos = file.find_first_of(" ");
+        if ( pos != std::string::npos ) file.erase( pos, file.length() - pos );
+
+        // Check that file is of a correct name
+        if ( file.find(".root") != std::string::npos ) {
+            files.push_back( file );
+        }
+    } //while ( getline( inputStream, file ) )
+}
+
+//_________________
+int ForestAODReader::setupRNTupleInput() {
+
+    if ( !ForestRNTupleInput::isAvailable() ) {
+        std::cerr << "[ERROR] ForestAODReader::setupRNTupleInput - RNTuple support is not compiled in (ROOT 6.36 or newer is needed). Terminating\n";
+        exit(1);
+    }
+    if ( fInFileName == nullptr || TString(fInFileName).Length() <= 0 ) {
+        std::cerr << "No normal inputfile. Terminating." << std::endl;
+        exit(0);
+    }
+    // Track trees are not converted
+    if ( fUseTrackBranch || fUseGenTrackBranch ) {
+        std::cout << "[WARNING] ForestAODReader::setupRNTupleInput - tracks are not in the RNTuple input and are not read\n";
+        fUseTrackBranch = false;
+        fUseGenTrackBranch = false;
+    }
+    // All RNTuples are positioned by the entry number
+    fUseFriendChain = false;
+    fUseEventIndex = false;
+
+    fRNTupleInput = new ForestRNTupleInput{};
+    std::vector<std::string> files;
+    readInputFiles( files );
+    for (const auto& name : files) {
+        if ( fRNTupleInput->addFile( name ) ) {
+            std::cout << Form("Adding file to RNTuple input: %s\n", name.c_str() );
+        }
+    }
+    fEntriesInChain = fRNTupleInput->nEntries();
+    std::cout << Form("Total number of files in RNTuple input: %zu\n", fRNTupleInput->files().size());
+    std::cout << Form("Total number of events to read: %lld\n", fEntriesInChain );
+
+    // Cuts applied by the reader need their inputs as well. Columns of the
+    // fields without addresses are not read
+    InputRequirements inputs = fRequiredInputs;
+    if ( fEventCut ) fEventCut->addRequiredInputs( inputs );
+    if ( fJetCut ) fJetCut->addRequiredInputs( inputs );
+
+    // Event quantities
+    const std::string eventName = ForestRNTupleInput::kEventNTuple;
+    fRNTupleInput->setFieldAddress( eventName, "run", &fRunId );
+    fRNTupleInput->setFieldAddress( eventName, "evt", &fEventId );
+    fRNTupleInput->setFieldAddress( eventName, "lumi", &fLumi );
+    fRNTupleInput->setFieldAddress( eventName, "vz", &fVertexZ );
+    fRNTupleInput->setFieldAddress( eventName, "hiBin", &fHiBin );
+    if ( fIsMc ) {
+        fRNTupleInput->setFieldAddress( eventName, "weight", &fPtHatWeight );
+        fRNTupleInput->setFieldAddress( eventName, "pthat", &fPtHat );
+    }
+
+    // Triggers and skimming filters of the registry
+    for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+        const bool isSkimFilter = TriggerAndSkim::isSkimFilter( iFlag );
+        if ( ( isSkimFilter && !fUseSkimmingBranch ) || ( !isSkimFilter && !fUseHltBranch ) ) continue;
+        const char *name = TriggerAndSkim::flagName( iFlag );
+        if ( ( isSkimFilter && !inputs.isSkimFilterRequired( name ) ) || 
+             ( !isSkimFilter && !inputs.isTriggerRequired( name ) ) ) continue;
+        fRNTupleInput->setFieldAddress( ( isSkimFilter ) ? ForestRNTupleInput::kSkimNTuple : ForestRNTupleInput::kHltNTuple,
+                                        name, &fTriggerAndSkim[iFlag] );
+    }
+
+    // Jet quantities: kinematics are always read, the rest only if required
+    const bool readTrackMax = inputs.isJetContentRequired( InputRequirements::kJetTrackMax );
+    const bool readWTAAxes = inputs.isJetContentRequired( InputRequirements::kJetWTAAxes );
+    const bool readPFFractions = inputs.isJetContentRequired( InputRequirements::kJetPFFractions );
+    const bool readPFMultiplicities = inputs.isJetContentRequired( InputRequirements::kJetPFMultiplicities );
+    const bool readPartonFlavor = inputs.isJetContentRequired( InputRequirements::kJetPartonFlavor );
+    if ( fUseRecoJetBranch ) {
+        const std::string jetName = fRecoJetTreeName.Data();
+        if ( !fRNTupleInput->hasNTuple( jetName ) ) {
+            std::cerr << Form("[ERROR] ForestAODReader::setupRNTupleInput - RNTuple input has no %s jets. Terminating\n", jetName.c_str());
+            exit(1);
+        }
+        fRNTupleInput->setFieldAddress( jetName, "nref", &fNRecoJets );
+        fRNTupleInput->setFieldAddress( jetName, "rawpt", &fRecoJetPt );
+        fRNTupleInput->setFieldAddress( jetName, "jteta", &fRecoJetEta );
+        fRNTupleInput->setFieldAddress( jetName, "jtphi", &fRecoJetPhi );
+        if ( readTrackMax ) {
+            fRNTupleInput->setFieldAddress( jetName, "trackMax", &fRecoJetTrackMax );
+        }
+        if ( readWTAAxes ) {
+            fRNTupleInput->setFieldAddress( jetName, "WTAeta", &fRecoJetWTAEta );
+            fRNTupleInput->setFieldAddress( jetName, "WTAphi", &fRecoJetWTAPhi );
+        }
+        if ( readPFFractions ) {
+            fRNTupleInput->setFieldAddress( jetName, "jtPfNHF", &fRecoJtPfNHF );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfNEF", &fRecoJtPfNEF );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfCHF", &fRecoJtPfCHF );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfMUF", &fRecoJtPfMUF );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfCEF", &fRecoJtPfCEF );
+        }
+        if ( readPFMultiplicities ) {
+            fRNTupleInput->setFieldAddress( jetName, "jtPfCHM", &fRecoJtPfCHM );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfCEM", &fRecoJtPfCEM );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfNHM", &fRecoJtPfNHM );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfNEM", &fRecoJtPfNEM );
+            fRNTupleInput->setFieldAddress( jetName, "jtPfMUM", &fRecoJtPfMUM );
+        }
+        if ( fIsMc ) {
+            fRNTupleInput->setFieldAddress( jetName, "ngen", &fNGenJets );
+            fRNTupleInput->setFieldAddress( jetName, "genpt", &fGenJetPt );
+            fRNTupleInput->setFieldAddress( jetName, "geneta", &fGenJetEta );
+            fRNTupleInput->setFieldAddress( jetName, "genphi", &fGenJetPhi );
+            fRNTupleInput->setFieldAddress( jetName, "refpt", &fRefJetPt );
+            fRNTupleInput->setFieldAddress( jetName, "refeta", &fRefJetEta );
+            fRNTupleInput->setFieldAddress( jetName, "refphi", &fRefJetPhi );
+            if ( readWTAAxes ) {
+                fRNTupleInput->setFieldAddress( jetName, "WTAgeneta", &fGenJetWTAEta );
+                fRNTupleInput->setFieldAddress( jetName, "WTAgenphi", &fGenJetWTAPhi );
+                fRNTupleInput->setFieldAddress( jetName, "refWTAeta", &fRefJetWTAEta );
+                fRNTupleInput->setFieldAddress( jetName, "refWTAphi", &fRefJetWTAPhi );
+            }
+            if ( readPartonFlavor ) {
+                fRNTupleInput->setFieldAddress( jetName, "refparton_flavor", &fRefJetPartonFlavor );
+                fRNTupleInput->setFieldAddress( jetName, "refparton_flavorForB", &fRefJetPartonFlavorForB );
+            }
+        }
+        // Buffers grow with the longest array read: the buffers are not reused by the trees
+        fRNTupleInput->setBufferGrowth( jetName, [this](const size_t& n) {
+            allocateJetBuffers( std::max( n, 2 * fJetBufferSize ) );
+            return fJetBufferSize;
+        } );
+
+        // Additional jet trees
+        for (auto& input : fJetCollectionInputs) {
+            if ( !fRNTupleInput->hasNTuple( input.name ) ) {
+                std::cout << Form("[WARNING] ForestAODReader::setupRNTupleInput - RNTuple input has no %s jets. Collection is not read\n",
+                                  input.name.c_str());
+                continue;
+            }
+            input.fromRNTuple = true;
+            fRNTupleInput->setFieldAddress( input.name, "nref", &input.nJets );
+            fRNTupleInput->setFieldAddress( input.name, "rawpt", &input.rawPt );
+            fRNTupleInput->setFieldAddress( input.name, "jteta", &input.eta );
+            fRNTupleInput->setFieldAddress( input.name, "jtphi", &input.phi );
+            fRNTupleInput->setFieldAddress( input.name, "trackMax", &input.trackMax );
+            fRNTupleInput->setFieldAddress( input.name, "WTAeta", &input.wtaEta );
+            fRNTupleInput->setFieldAddress( input.name, "WTAphi", &input.wtaPhi );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfNHF", &input.pfNHF );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfNEF", &input.pfNEF );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfCHF", &input.pfCHF );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfMUF", &input.pfMUF );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfCEF", &input.pfCEF );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfCHM", &input.pfCHM );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfCEM", &input.pfCEM );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfNHM", &input.pfNHM );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfNEM", &input.pfNEM );
+            fRNTupleInput->setFieldAddress( input.name, "jtPfMUM", &input.pfMUM );
+            if ( fIsMc ) {
+                fRNTupleInput->setFieldAddress( input.name, "refeta", &input.refEta );
+                fRNTupleInput->setFieldAddress( input.name, "refphi", &input.refPhi );
+                fRNTupleInput->setFieldAddress( input.name, "refparton_flavor", &input.refFlavor );
+                fRNTupleInput->setFieldAddress( input.name, "refparton_flavorForB", &input.refFlavorForB );
+                fRNTupleInput->setFieldAddress( input.name, "ngen", &input.nGenJets );
+                fRNTupleInput->setFieldAddress( input.name, "genpt", &input.genPt );
+                fRNTupleInput->setFieldAddress( input.name, "geneta", &input.genEta );
+                fRNTupleInput->setFieldAddress( input.name, "genphi", &input.genPhi );
+                fRNTupleInput->setFieldAddress( input.name, "WTAgeneta", &input.genWTAEta );
+                fRNTupleInput->setFieldAddress( input.name, "WTAgenphi", &input.genWTAPhi );
+            }
+            JetCollectionInput *collection = &input;
+            fRNTupleInput->setBufferGrowth( input.name, [this, collection](const size_t& n) {
+                allocateJetCollectionBuffers( *collection, std::max( n, 2 * collection->bufferSize ) );
+                return collection->bufferSize;
+            } );
+            std::cout << Form("Jet tree %s is read in addition to %s\n", input.name.c_str(), fRecoJetTreeName.Data());
+        }
+    } // if ( fUseRecoJetBranch )
+
+    inputs.print();
+    return ( fEntriesInChain > 0 ) ? 0 : 1;
+}
+
+//_________________
+void ForestAODReader::validateFiles(const std::vector<std::string>& files, std::vector<InputFileInfo>& infos) const {
+    infos.assign( files.size(), InputFileInfo{} );
+    if ( files.empty() ) return;
+
+    const int nThreads = std::min( fNValidationThreads, static_cast<int>( files.size() ) );
+    if ( nThreads > 1 ) {
+        // Files are opened from several threads
+        ROOT::EnableThreadSafety();
+    }
+    std::cout << Form("Validating %zu files with %d threads... ", files.size(), nThreads) << std::flush;
+
+    // Threads take the next file to open until the list is done
+    std::atomic<size_t> next{0};
+    auto validate = [&]() {
+        for (size_t iFile = next++; iFile < files.size(); iFile = next++) {
+            // File state is taken before opening: a file replaced meanwhile is counted again next time
+            FileStat_t stat;
+            if ( gSystem->GetPathInfo( files.at(iFile).c_str(), stat ) == 0 ) {
+                infos.at(iFile).size = stat.fSize;
+                infos.at(iFile).modTime = stat.fMtime;
+            }
+            TFile *file = TFile::Open( files.at(iFile).c_str() );
+            // Check file is not zombie and contains information
+            if ( file && !file->IsZombie() && file->GetNkeys() ) {
+                TTree *tree = dynamic_cast<TTree*>( file->Get("hiEvtAnalyzer/HiTree") );
+                infos.at(iFile).entries = ( tree ) ? tree->GetEntries() : -1;
+            }
+            delete file;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int iThread{1}; iThread<nThreads; iThread++) {
+        threads.emplace_back( validate );
+    }
+    validate();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::cout << "\t[DONE]" << std::endl;
+
+    for (size_t iFile{0}; iFile<files.size(); iFile++) {
+        if ( infos.at(iFile).entries < 0 ) {
+            std::cout << Form("[WARNING] ForestAODReader::validateFiles - file %s is not valid and is skipped\n", files.at(iFile).c_str());
+        }
+    }
+}
+
+//_________________
+bool ForestAODReader::readEntryManifest(const TString& name, std::map<std::string, InputFileInfo>& infos) const {
+    std::ifstream manifest( name.Data() );
+    if ( !manifest ) return false;
+
+    // Lines: "file entries size modTime". Negative entries mark files that are not valid.
+    // File names may contain spaces: the numbers are taken from the end of the line
+    std::string line;
+    while ( getline( manifest, line ) ) {
+        if ( line.empty() || line[0] == '#' ) continue;
+        size_t pos[3];
+        size_t end = line.size();
+        bool isGood{true};
+        for (int iField{2}; iField>=0; iField--) {
+            pos[iField] = ( end > 0 ) ? line.find_last_of( ' ', end - 1 ) : std::string::npos;
+            if ( pos[iField] == std::string::npos ) { isGood = false; break; }
+            end = pos[iField];
+        }
+        // Lines of other format are counted again
+        if ( !isGood ) continue;
+        InputFileInfo info;
+        info.entries = std::atoll( line.c_str() + pos[0] + 1 );
+        info.size = std::atoll( line.c_str() + pos[1] + 1 );
+        info.modTime = std::atol( line.c_str() + pos[2] + 1 );
+        infos[ line.substr( 0, pos[0] ) ] = info;
+    }
+    std::cout << Form("Entries of %zu files are read from the manifest %s\n", infos.size(), name.Data());
+    return true;
+}
+
+//_________________
+bool ForestAODReader::isEntryUpToDate(const std::string& file, const InputFileInfo& info) const {
+    // Files that could not be read may be fixed meanwhile: they are always checked again
+    if ( info.entries <= 0 || info.size < 0 ) return false;
+    FileStat_t stat;
+    if ( gSystem->GetPathInfo( file.c_str(), stat ) != 0 ) return false;
+    return ( stat.fSize == info.size && stat.fMtime == info.modTime );
+}
+
+//_________________
+void ForestAODReader::writeEntryManifest(const TString& name, const std::map<std::string, InputFileInfo>& infos) const {
+    // Several processes may write the same manifest: the complete file replaces the old one
+    TString tmpName = Form("%s.%d.tmp", name.Data(), gSystem->GetPid());
+    std::ofstream manifest( tmpName.Data() );
+    if ( !manifest ) {
+        std::cout << Form("[WARNING] ForestAODReader::writeEntryManifest - cannot write %s\n", tmpName.Data());
+        return;
+    }
+    manifest << "# File, number of hiEvtAnalyzer/HiTree entries (-1 - file is not valid), size and modification time\n";
+    for (const auto& file : infos) {
+        manifest << file.first << " " << file.second.entries << " " << file.second.size << " " << file.second.modTime << "\n";
+    }
+    manifest.close();
+    if ( !manifest || gSystem->Rename( tmpName.Data(), name.Data() ) != 0 ) {
+        std::cout << Form("[WARNING] ForestAODReader::writeEntryManifest - cannot write %s\n", name.Data());
+        gSystem->Unlink( tmpName.Data() );
+        return;
+    }
+    std::cout << Form("Entries of %zu files are written to the manifest %s\n", infos.size(), name.Data());
+}
+
 //_________________
 void ForestAODReader::setupBranches() {
 
@@ -904,144 +1743,17 @@ void ForestAODReader::setupBranches() {
         fEventTree->SetBranchAddress("pthat", &fPtHat);
     }
 
-    if ( fUseHltBranch ) {
-
-        // Status
-        fHltTree->SetBranchStatus("HLT_HIAK4CaloJet60_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4CaloJet80_v1", 1);
-        fHltTree->SetBranchStatus("HLT_PAAK4CaloJet60_Eta5p1_v3", 1);
-        fHltTree->SetBranchStatus("HLT_PAAK4CaloJet80_Eta5p1_v3", 1);
-        fHltTree->SetBranchStatus("HLT_PAAK4CaloJet100_Eta5p1_v3", 1);
-        fHltTree->SetBranchStatus("HLT_PAAK4PFJet60_Eta5p1_v4", 1);
-        fHltTree->SetBranchStatus("HLT_PAAK4PFJet80_Eta5p1_v3", 1);
-        fHltTree->SetBranchStatus("HLT_PAAK4PFJet100_Eta5p1_v3", 1);
-        fHltTree->SetBranchStatus("HLT_PAAK4PFJet120_Eta5p1_v2", 1);
-
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet15_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet15_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet30_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet30_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet40_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet40_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet60_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet60_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet80_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet80_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet120_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK4PFJet120_v1_Prescl", 1);
-
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet15_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet15_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet25_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet25_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet40_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet40_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet60_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet60_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet80_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet80_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet140_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIAK8PFJet140_v1_Prescl", 1);
-
-        fHltTree->SetBranchStatus("HLT_HIPFJet25_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIPFJet25_v1_Prescl", 1);
-        fHltTree->SetBranchStatus("HLT_HIPFJet140_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIPFJet140_v1_Prescl", 1);
-
-        fHltTree->SetBranchStatus("HLT_HIPuAK4CaloJet80Eta5p1_v1", 1);
-        fHltTree->SetBranchStatus("HLT_HIPuAK4CaloJet100Eta5p1_v1", 1);
-
-        // Address
-        fHltTree->SetBranchAddress("HLT_HIAK4CaloJet60_v1", &fHLT_HIAK4CaloJet60_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK4CaloJet80_v1", &fHLT_HIAK4CaloJet80_v1);
-        fHltTree->SetBranchAddress("HLT_PAAK4CaloJet60_Eta5p1_v3", &fHLT_PAAK4CaloJet60_Eta5p1_v3);
-        fHltTree->SetBranchAddress("HLT_PAAK4CaloJet80_Eta5p1_v3", &fHLT_PAAK4CaloJet80_Eta5p1_v3);
-        fHltTree->SetBranchAddress("HLT_PAAK4CaloJet100_Eta5p1_v3", &fHLT_PAAK4CaloJet100_Eta5p1_v3);
-        fHltTree->SetBranchAddress("HLT_PAAK4PFJet60_Eta5p1_v4", &fHLT_PAAK4PFJet60_Eta5p1_v4);
-        fHltTree->SetBranchAddress("HLT_PAAK4PFJet80_Eta5p1_v3", &fHLT_PAAK4PFJet80_Eta5p1_v3);
-        fHltTree->SetBranchAddress("HLT_PAAK4PFJet100_Eta5p1_v3", &fHLT_PAAK4PFJet100_Eta5p1_v3);
-        fHltTree->SetBranchAddress("HLT_PAAK4PFJet120_Eta5p1_v2", &fHLT_PAAK4PFJet120_Eta5p1_v2);
-
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet15_v1", &fHLT_HIAK4PFJet15_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet15_v1_Prescl", &fHLT_HIAK4PFJet15_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet30_v1", &fHLT_HIAK4PFJet30_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet30_v1_Prescl", &fHLT_HIAK4PFJet30_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet40_v1", &fHLT_HIAK4PFJet40_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet40_v1_Prescl", &fHLT_HIAK4PFJet40_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet60_v1", &fHLT_HIAK4PFJet60_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet60_v1_Prescl", &fHLT_HIAK4PFJet60_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet80_v1", &fHLT_HIAK4PFJet80_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet80_v1_Prescl", &fHLT_HIAK4PFJet80_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet120_v1", &fHLT_HIAK4PFJet120_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK4PFJet120_v1_Prescl", &fHLT_HIAK4PFJet120_v1_Prescl);
-
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet15_v1", &fHLT_HIAK8PFJet15_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet15_v1_Prescl", &fHLT_HIAK8PFJet15_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet25_v1", &fHLT_HIAK8PFJet25_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet25_v1_Prescl", &fHLT_HIAK8PFJet25_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet40_v1", &fHLT_HIAK8PFJet40_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet40_v1_Prescl", &fHLT_HIAK8PFJet40_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet60_v1", &fHLT_HIAK8PFJet60_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet60_v1_Prescl", &fHLT_HIAK8PFJet60_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet80_v1", &fHLT_HIAK8PFJet80_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet80_v1_Prescl", &fHLT_HIAK8PFJet80_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet140_v1", &fHLT_HIAK8PFJet140_v1);
-        fHltTree->SetBranchAddress("HLT_HIAK8PFJet140_v1_Prescl", &fHLT_HIAK8PFJet140_v1_Prescl);
-
-        fHltTree->SetBranchAddress("HLT_HIPFJet25_v1", &fHLT_HIPFJet25_v1);
-        fHltTree->SetBranchAddress("HLT_HIPFJet25_v1_Prescl", &fHLT_HIPFJet25_v1_Prescl);
-        fHltTree->SetBranchAddress("HLT_HIPFJet140_v1", &fHLT_HIPFJet140_v1);
-        fHltTree->SetBranchAddress("HLT_HIPFJet140_v1_Prescl", &fHLT_HIPFJet140_v1_Prescl);
-
-        fHltTree->SetBranchAddress("HLT_HIPuAK4CaloJet80Eta5p1_v1", &fHLT_HIPuAK4CaloJet80Eta5p1_v1);
-        fHltTree->SetBranchAddress("HLT_HIPuAK4CaloJet100Eta5p1_v1", &fHLT_HIPuAK4CaloJet100Eta5p1_v1);
-    } // if ( fUseHltBranch )
-
-    // Skimming quantities
-    if ( fUseSkimmingBranch ) {
-        // Status
-        fSkimTree->SetBranchStatus("HBHENoiseFilterResultRun2Loose", 1);
-        fSkimTree->SetBranchStatus("HBHENoiseFilterResultRun2Tight", 1);
-        fSkimTree->SetBranchStatus("HBHEIsoNoiseFilterResult", 1);
-        fSkimTree->SetBranchStatus("collisionEventSelectionAODv2", 1);
-        fSkimTree->SetBranchStatus("phfCoincFilter2Th4", 1);
-        fSkimTree->SetBranchStatus("pPAprimaryVertexFilter", 1);
-        fSkimTree->SetBranchStatus("pBeamScrapingFilter", 1);
-        fSkimTree->SetBranchStatus("pprimaryVertexFilter", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutG", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutGloose", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutGtight", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutE", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutEandG", 1);
-        fSkimTree->SetBranchStatus("pclusterCompatibilityFilter", 1);
-
-        fSkimTree->SetBranchStatus("phfCoincFilter", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutdz1p0", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutGplus", 1);
-        fSkimTree->SetBranchStatus("pVertexFilterCutVtx1", 1);
-
-
-        // Address
-        fSkimTree->SetBranchAddress("HBHENoiseFilterResultRun2Loose", &fHBHENoiseFilterResultRun2Loose);
-        fSkimTree->SetBranchAddress("HBHENoiseFilterResultRun2Tight", &fHBHENoiseFilterResultRun2Tight);
-        fSkimTree->SetBranchAddress("HBHEIsoNoiseFilterResult", &fHBHEIsoNoiseFilterResult);
-        fSkimTree->SetBranchAddress("collisionEventSelectionAODv2", &fCollisionEventSelectionAODv2);
-        fSkimTree->SetBranchAddress("phfCoincFilter2Th4", &fPhfCoincFilter2Th4);
-        fSkimTree->SetBranchAddress("pPAprimaryVertexFilter", &fPPAprimaryVertexFilter);
-        fSkimTree->SetBranchAddress("pBeamScrapingFilter", &fPBeamScrapingFilter);
-        fSkimTree->SetBranchAddress("pprimaryVertexFilter", &fPprimaryVertexFilter);
-        fSkimTree->SetBranchAddress("pVertexFilterCutG", &fPVertexFilterCutG);
-        fSkimTree->SetBranchAddress("pVertexFilterCutGloose", &fPVertexFilterCutGloose);
-        fSkimTree->SetBranchAddress("pVertexFilterCutGtight", &fPVertexFilterCutGtight);
-        fSkimTree->SetBranchAddress("pVertexFilterCutE", &fPVertexFilterCutE);
-        fSkimTree->SetBranchAddress("pVertexFilterCutEandG", &fPVertexFilterCutEandG);
-        fSkimTree->SetBranchAddress("pclusterCompatibilityFilter", &fPClusterCompatibilityFilter);
-
-        fSkimTree->SetBranchAddress("phfCoincFilter", &fPhfCoincFilter);
-        fSkimTree->SetBranchAddress("pVertexFilterCutdz1p0", &fPVertexFilterCutdz1p0);
-        fSkimTree->SetBranchAddress("pVertexFilterCutGplus", &fPVertexFilterCutGplus);
-        fSkimTree->SetBranchAddress("pVertexFilterCutVtx1", &fPVertexFilterCutVtx1);
-    } // if ( fUseSkimmingBranch )
+    // Triggers and skimming filters of the registry
+    for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+        const bool isSkimFilter = TriggerAndSkim::isSkimFilter( iFlag );
+        if ( ( isSkimFilter && !fUseSkimmingBranch ) || ( !isSkimFilter && !fUseHltBranch ) ) continue;
+        TChain *chain = ( isSkimFilter ) ? fSkimTree : fHltTree;
+        const char *name = TriggerAndSkim::flagName( iFlag );
+        // Menus differ between datasets: not all flags are in the input
+        if ( !chain->GetBranch( name ) ) continue;
+        chain->SetBranchStatus( name, 1 );
+        chain->SetBranchAddress( name, &fTriggerAndSkim[iFlag] );
+    }
 
     // Jet quantities
     if ( fUseRecoJetBranch ) {
@@ -1055,12 +1767,6 @@ void ForestAODReader::setupBranches() {
         fRecoJetTree->SetBranchStatus("WTAphi", 1);
 
         fRecoJetTree->SetBranchAddress("nref", &fNRecoJets);
-        fRecoJetTree->SetBranchAddress("rawpt", &fRecoJetPt);
-        fRecoJetTree->SetBranchAddress("trackMax", &fRecoJetTrackMax);
-        fRecoJetTree->SetBranchAddress("jteta", &fRecoJetEta);
-        fRecoJetTree->SetBranchAddress("jtphi", &fRecoJetPhi);
-        fRecoJetTree->SetBranchAddress("WTAeta", &fRecoJetWTAEta);
-        fRecoJetTree->SetBranchAddress("WTAphi", &fRecoJetWTAPhi);
 
         fRecoJetTree->SetBranchStatus("jtPfNHF", 1);
         fRecoJetTree->SetBranchStatus("jtPfNEF", 1);
@@ -1073,17 +1779,6 @@ void ForestAODReader::setupBranches() {
         fRecoJetTree->SetBranchStatus("jtPfNEM", 1);
         fRecoJetTree->SetBranchStatus("jtPfMUM", 1);
 
-      	fRecoJetTree->SetBranchAddress("jtPfNHF", &fRecoJtPfNHF);    
- 	    fRecoJetTree->SetBranchAddress("jtPfNEF", &fRecoJtPfNEF);
-      	fRecoJetTree->SetBranchAddress("jtPfCHF", &fRecoJtPfCHF);
-      	fRecoJetTree->SetBranchAddress("jtPfMUF", &fRecoJtPfMUF);
-      	fRecoJetTree->SetBranchAddress("jtPfCEF", &fRecoJtPfCEF);
-      	fRecoJetTree->SetBranchAddress("jtPfCHM", &fRecoJtPfCHM);
-      	fRecoJetTree->SetBranchAddress("jtPfCEM", &fRecoJtPfCEM);
-      	fRecoJetTree->SetBranchAddress("jtPfNHM", &fRecoJtPfNHM);
-      	fRecoJetTree->SetBranchAddress("jtPfNEM", &fRecoJtPfNEM);
-  	    fRecoJetTree->SetBranchAddress("jtPfMUM", &fRecoJtPfMUM);
-
         // Gen jet quantities
         if ( fIsMc ) {
             fRecoJetTree->SetBranchStatus("ngen", 1);
@@ -1093,11 +1788,6 @@ void ForestAODReader::setupBranches() {
             fRecoJetTree->SetBranchStatus("WTAgeneta", 1);
             fRecoJetTree->SetBranchStatus("WTAgenphi", 1);
             fRecoJetTree->SetBranchAddress("ngen", &fNGenJets);
-            fRecoJetTree->SetBranchAddress("genpt", &fGenJetPt);
-            fRecoJetTree->SetBranchAddress("geneta", &fGenJetEta);
-            fRecoJetTree->SetBranchAddress("genphi", &fGenJetPhi);
-            fRecoJetTree->SetBranchAddress("WTAgeneta", &fGenJetWTAEta);
-            fRecoJetTree->SetBranchAddress("WTAgenphi", &fGenJetWTAPhi);
         }
 
         // Jet-matching quantities
@@ -1109,15 +1799,11 @@ void ForestAODReader::setupBranches() {
             fRecoJetTree->SetBranchStatus("refWTAphi", 1);
             fRecoJetTree->SetBranchStatus("refparton_flavor", 1);
             fRecoJetTree->SetBranchStatus("refparton_flavorForB", 1);
-            fRecoJetTree->SetBranchAddress("refpt", &fRefJetPt);
-            fRecoJetTree->SetBranchAddress("refeta", &fRefJetEta);
-            fRecoJetTree->SetBranchAddress("refphi", &fRefJetPhi);
-            fRecoJetTree->SetBranchAddress("refWTAeta", &fRefJetWTAEta);
-            fRecoJetTree->SetBranchAddress("refWTAphi", &fRefJetWTAPhi);
-            fRecoJetTree->SetBranchAddress("refparton_flavor", &fRefJetPartonFlavor);
-            fRecoJetTree->SetBranchAddress("refparton_flavorForB", &fRefJetPartonFlavorForB);
         }
 
+        // Array addresses are set when buffers are sized from the first file
+        fRecoJetTree->LoadTree( 0 );
+        fitBuffers( kJetChain );
     } // if ( fUseRecoJetBranch )
 
     // Track quantities
@@ -1143,24 +1829,9 @@ void ForestAODReader::setupBranches() {
         fTrkTree->SetBranchStatus("trkAlgo", 1);
 
         fTrkTree->SetBranchAddress("nTrk", &fNTracks);
-        fTrkTree->SetBranchAddress("trkPt", &fTrackPt);
-        fTrkTree->SetBranchAddress("trkEta", &fTrackEta);
-        fTrkTree->SetBranchAddress("trkPhi", &fTrackPhi);
-        fTrkTree->SetBranchAddress("trkPtError", &fTrackPtErr);
-        fTrkTree->SetBranchAddress("trkDxy1", &fTrackDcaXY);
-        fTrkTree->SetBranchAddress("trkDxyError1", &fTrackDcaXYErr);
-        fTrkTree->SetBranchAddress("trkDz1", &fTrackDcaZ);
-        fTrkTree->SetBranchAddress("trkDzError1", &fTrackDcaZErr);
-        fTrkTree->SetBranchAddress("trkChi2", &fTrackChi2);
-        fTrkTree->SetBranchAddress("trkNdof", &fTrackNDOF);
-        fTrkTree->SetBranchAddress("trkCharge", &fTrackCharge);
-        fTrkTree->SetBranchAddress("trkNHit", &fTrackNHits);
-        fTrkTree->SetBranchAddress("trkNlayer", &fTrackNLayers);
-        fTrkTree->SetBranchAddress("highPurity", &fTrackHighPurity);
-        fTrkTree->SetBranchAddress("pfEcal", &fTrackPartFlowEcal);
-        fTrkTree->SetBranchAddress("pfHcal", &fTrackPartFlowHcal);
-        fTrkTree->SetBranchAddress("trkMVA", &fTrackMVA);
-        fTrkTree->SetBranchAddress("trkAlgo", &fTrackAlgo);
+
+        fTrkTree->LoadTree( 0 );
+        fitBuffers( kTrackChain );
     } // if ( fUseTrackBranch ) 
 
     // Gen particle quantities
@@ -1188,6 +1859,365 @@ void ForestAODReader::setupBranches() {
 //_________________
 void ForestAODReader::report() {
     std::cout << "ForestAODReader::reporting" << std::endl;
+    if ( fTrackCut ) fTrackCut->report();
+}
+
+//_________________
+void ForestAODReader::setEntryRange(const Long64_t& first, const Long64_t& last) {
+    BaseReader::setEntryRange(first, last);
+    // If chains are already set up then update number of events to read
+    if ( fEventTree || fRNTupleInput ) {
+        applyEntryRange();
+    }
+}
+
+//_________________
+void ForestAODReader::startTask(const EntryTask& task) {
+    BaseReader::setEntryRange(task.first, task.last);
+    // Tasks are many: do not print each range
+    applyEntryRange( false );
+}
+
+//_________________
+void ForestAODReader::entryTasks(std::vector<EntryTask>& tasks) const {
+
+    const Long64_t last = fFirstEntry + fEntriesInRange;
+
+    // Jet tree is the largest one: tasks do not split its clusters
+    std::vector<Long64_t> clusterEnds;
+    if ( fRNTupleInput ) {
+        fRNTupleInput->clusterEnds( ( fUseRecoJetBranch ) ? fRecoJetTreeName.Data() : ForestRNTupleInput::kEventNTuple,
+                                    fFirstEntry, last, clusterEnds );
+    }
+    else {
+        // Entries of the files are known from the file list validation: only large files are opened
+        fileClusterEnds( ( fUseRecoJetBranch ) ? fRecoJetTree : fEventTree, fEventTree, fFirstEntry, last, clusterEnds );
+    }
+    clusterTasks( clusterEnds, last, tasks );
+
+    std::cout << Form("Entry range [%lld, %lld) is split into %zu tasks\n", fFirstEntry, last, tasks.size());
+}
+
+//_________________
+void ForestAODReader::cacheKey(std::vector<std::string>& files, std::string& settings) const {
+
+    if ( fEventTree ) {
+        TIter next( fEventTree->GetListOfFiles() );
+        while ( TObject *element = next() ) {
+            files.push_back( element->GetTitle() );
+        }
+    }
+    if ( fRNTupleInput ) {
+        files.insert( files.end(), fRNTupleInput->files().begin(), fRNTupleInput->files().end() );
+    }
+    // File names carry the path after setupJEC() and setupJEU()
+    files.insert( files.end(), fJECFiles.begin(), fJECFiles.end() );
+    for (const auto& input : fJetCollectionInputs) {
+        files.insert( files.end(), input.jecFiles.begin(), input.jecFiles.end() );
+    }
+    if ( fUseJEU != 0 ) {
+        files.push_back( fJEUInputFileName.Data() );
+    }
+
+    settings += Form("jetTree=%s isMc=%d correctCentMC=%d manualJEC=%d extraJECforAk4Cs=%d JEU=%d JERSyst=%d smearing=%d fixJetArrays=%d etaShift=%.5f PbGoing=%d",
+                     fRecoJetTreeName.Data(), fIsMc, fCorrectCentMC, fUseManualJEC, fUseExtraJECforAk4Cs,
+                     fUseJEU, fUseJERSystematics, fDoJetPtSmearing, fFixJetArrays, fEtaShift, fIsPbGoingDir);
+
+    // Branches not required are not read and cuts of the reader drop events and jets,
+    // so a cache filled with other requirements or cuts is not valid
+    InputRequirements inputs = fRequiredInputs;
+    if ( fEventCut ) fEventCut->addRequiredInputs( inputs );
+    if ( fJetCut ) fJetCut->addRequiredInputs( inputs );
+    settings += " ";
+    settings += inputs.key();
+    settings += " eventCut=";
+    if ( fEventCut ) settings += fEventCut->settings().Data();
+    settings += " jetCut=";
+    if ( fJetCut ) settings += fJetCut->settings().Data();
+}
+
+//_________________
+void ForestAODReader::setStageStats(StageStats *stats) {
+    BaseReader::setStageStats(stats);
+    if ( !fStageStats ) return;
+    fStageGetEntry = fStageStats->stageId("ForestAODReader::GetEntry");
+    fStageEventConstruction = fStageStats->stageId("ForestAODReader::EventConstruction");
+    fStageJetCorrections = fStageStats->stageId("ForestAODReader::JEC/JEU/JER");
+    fStageJetCut = fStageStats->stageId("ForestAODReader::JetCut");
+    fStageEventCut = fStageStats->stageId("ForestAODReader::EventCut");
+    fStageClearVariables = fStageStats->stageId("ForestAODReader::clearVariables");
+}
+
+//_________________
+void ForestAODReader::setupChainIO() {
+
+    // Chains in the order of ChainIndex
+    fChainIO.assign( kNChains, ChainIO{} );
+    const char *names[kNChains] = { "event", "hlt", "skim", "jet", "track", "genTrack" };
+    TChain *chains[kNChains] = { fEventTree, 
+                                 ( fUseHltBranch ) ? fHltTree : nullptr, 
+                                 ( fUseSkimmingBranch ) ? fSkimTree : nullptr, 
+                                 ( fUseRecoJetBranch ) ? fRecoJetTree : nullptr, 
+                                 ( fUseTrackBranch ) ? fTrkTree : nullptr, 
+                                 ( fUseGenTrackBranch && fIsMc ) ? fGenTrkTree : nullptr };
+    // Run and event number branches of each tree (skimming tree has none)
+    const char *runNames[kNChains] = { "run", "Run", "", "run", "nRun", "run" };
+    const char *eventNames[kNChains] = { "evt", "Event", "", "evt", "nEv", "event" };
+
+    for (int iChain{0}; iChain<kNChains; iChain++) {
+        ChainIO &io = fChainIO.at(iChain);
+        io.name = names[iChain];
+        io.chain = chains[iChain];
+        io.runName = runNames[iChain];
+        io.eventName = eventNames[iChain];
+    }
+}
+
+//_________________
+void ForestAODReader::setupAlignmentCheck() {
+    if ( fAlignmentCheck <= 0 ) return;
+
+    TString checked{};
+    for (int iChain{kHltChain}; iChain<kNChains; iChain++) {
+        ChainIO &io = fChainIO.at(iChain);
+        if ( !io.chain || io.runName.empty() ) continue;
+        if ( !io.chain->GetBranch( io.runName.c_str() ) || !io.chain->GetBranch( io.eventName.c_str() ) ) {
+            std::cout << Form("[WARNING] ForestAODReader::setupAlignmentCheck - %s tree has no %s/%s branches and is not checked\n",
+                              io.name.c_str(), io.runName.c_str(), io.eventName.c_str());
+            continue;
+        }
+        // Branches stay disabled: they are read by checkAlignment() for the checked entries only
+        io.checkAlignment = true;
+        checked += Form(" %s", io.name.c_str());
+    }
+    std::cout << Form("Run and event numbers are compared to the event tree %s for trees:%s\n",
+                      ( fAlignmentCheck == 1 ) ? "once per file" : "for every entry", checked.Data());
+}
+
+//_________________
+void ForestAODReader::setupFriendChain() {
+
+    // Jets are matched by (run, evt). The other trees have differently named
+    // branches, so ROOT keeps matching them by entry number
+    if ( fUseEventIndex && fUseRecoJetBranch ) {
+        std::cout << "Building (run, evt) index of the jet tree... ";
+        if ( fRecoJetTree->BuildIndex("run", "evt") <= 0 ) {
+            std::cerr << "[ERROR] ForestAODReader::setupFriendChain - cannot build (run, evt) index of the jet tree. Terminating\n";
+            exit(1);
+        }
+        std::cout << "\t[DONE]\n";
+    }
+
+    for (int iChain{kHltChain}; iChain<kNChains; iChain++) {
+        ChainIO &io = fChainIO.at(iChain);
+        if ( !io.chain ) continue;
+        // Trees matched by entry number must have the same entries
+        const bool isIndexed = ( fUseEventIndex && iChain == kJetChain );
+        if ( !isIndexed && io.chain->GetEntries() != fEntriesInChain ) {
+            std::cerr << Form("[ERROR] ForestAODReader::setupFriendChain - %s tree has %lld entries while the event tree has %lld. Terminating\n",
+                              io.name.c_str(), io.chain->GetEntries(), fEntriesInChain);
+            exit(1);
+        }
+        fEventTree->AddFriend( io.chain );
+    }
+    std::cout << "Trees are read as friends of the event tree" << std::endl;
+}
+
+//_________________
+void ForestAODReader::setupTreeCache() {
+
+    for (int iChain{0}; iChain<kNChains; iChain++) {
+        ChainIO &io = fChainIO.at(iChain);
+        auto chainSize = fChainTreeCacheSize.find( io.name );
+        io.cacheSize = ( chainSize != fChainTreeCacheSize.end() ) ? chainSize->second : fTreeCacheSize;
+        // Negative size keeps the ROOT default
+        if ( !io.chain || io.cacheSize < 0 ) continue;
+
+        // Cache is attached to the file of the current tree
+        if ( !io.chain->GetTree() ) {
+            io.chain->LoadTree( fFirstEntry );
+        }
+        io.chain->SetCacheSize( io.cacheSize );
+        if ( io.cacheSize == 0 || !io.chain->GetTree() ) continue;
+
+        if ( fTreeCacheLearnEntries > 0 ) {
+            io.chain->SetCacheLearnEntries( fTreeCacheLearnEntries );
+        }
+        else {
+            // Branches to read are known: no need to learn them
+            TIter next( io.chain->GetTree()->GetListOfBranches() );
+            while ( TObject *branch = next() ) {
+                if ( io.chain->GetBranchStatus( branch->GetName() ) ) {
+                    io.chain->AddBranchToCache( branch->GetName(), kTRUE );
+                }
+            }
+            io.chain->StopCacheLearningPhase();
+        }
+    }
+
+    // Additional jet trees use the cache size of the main jet tree
+    const Long64_t jetCacheSize = fChainIO.at(kJetChain).cacheSize;
+    for (auto& input : fJetCollectionInputs) {
+        if ( !input.chain || jetCacheSize < 0 || !input.chain->GetTree() ) continue;
+        input.chain->SetCacheSize( jetCacheSize );
+        if ( jetCacheSize == 0 ) continue;
+        TIter next( input.chain->GetTree()->GetListOfBranches() );
+        while ( TObject *branch = next() ) {
+            if ( input.chain->GetBranchStatus( branch->GetName() ) ) {
+                input.chain->AddBranchToCache( branch->GetName(), kTRUE );
+            }
+        }
+        input.chain->StopCacheLearningPhase();
+    }
+
+    if ( fUseAsyncPrefetch ) {
+        std::cout << "Baskets are prefetched asynchronously" << std::endl;
+    }
+}
+
+//_________________
+void ForestAODReader::enabledBranchesSize(TChain *chain, int& nBranches, double& bytesPerEntry) const {
+    if ( !chain ) return;
+    // Branches are known only when the tree is loaded
+    if ( !chain->GetTree() ) {
+        chain->LoadTree( fFirstEntry );
+    }
+    TTree *tree = chain->GetTree();
+    if ( !tree || tree->GetEntries() <= 0 ) return;
+
+    TIter next( tree->GetListOfBranches() );
+    while ( TBranch *branch = static_cast<TBranch*>( next() ) ) {
+        if ( !chain->GetBranchStatus( branch->GetName() ) ) continue;
+        nBranches++;
+        bytesPerEntry += static_cast<double>( branch->GetTotBytes("*") ) / tree->GetEntries();
+    }
+}
+
+//_________________
+void ForestAODReader::applyRequiredInputs() {
+
+    // Cuts applied by the reader need their inputs as well
+    InputRequirements inputs = fRequiredInputs;
+    if ( fEventCut ) fEventCut->addRequiredInputs( inputs );
+    if ( fJetCut ) fJetCut->addRequiredInputs( inputs );
+    if ( inputs.isAllRequired() ) return;
+
+    std::vector<TChain*> chains{ fEventTree };
+    if ( fUseHltBranch ) chains.push_back( fHltTree );
+    if ( fUseSkimmingBranch ) chains.push_back( fSkimTree );
+    if ( fUseRecoJetBranch ) chains.push_back( fRecoJetTree );
+    for (auto& input : fJetCollectionInputs) {
+        if ( input.chain ) chains.push_back( input.chain );
+    }
+    if ( fUseTrackBranch ) chains.push_back( fTrkTree );
+    if ( fUseGenTrackBranch && fIsMc ) chains.push_back( fGenTrkTree );
+
+    int nBranchesBefore{0};
+    double bytesBefore{0};
+    for (auto chain : chains) {
+        enabledBranchesSize( chain, nBranchesBefore, bytesBefore );
+    }
+
+    // Triggers (decision and prescale) and skimming filters
+    if ( fUseHltBranch && fHltTree->GetTree() ) {
+        TIter next( fHltTree->GetTree()->GetListOfBranches() );
+        while ( TObject *branch = next() ) {
+            if ( fHltTree->GetBranchStatus( branch->GetName() ) && 
+                 !inputs.isTriggerRequired( branch->GetName() ) ) {
+                fHltTree->SetBranchStatus( branch->GetName(), 0 );
+            }
+        }
+    }
+    if ( fUseSkimmingBranch && fSkimTree->GetTree() ) {
+        TIter next( fSkimTree->GetTree()->GetListOfBranches() );
+        while ( TObject *branch = next() ) {
+            if ( fSkimTree->GetBranchStatus( branch->GetName() ) && 
+                 !inputs.isSkimFilterRequired( branch->GetName() ) ) {
+                fSkimTree->SetBranchStatus( branch->GetName(), 0 );
+            }
+        }
+    }
+
+    // Optional jet content. Jet kinematics are always read
+    if ( fUseRecoJetBranch ) {
+        std::vector<TChain*> jetChains{ fRecoJetTree };
+        for (auto& input : fJetCollectionInputs) {
+            if ( input.chain ) jetChains.push_back( input.chain );
+        }
+        auto disable = [&jetChains](const std::vector<const char*>& names) {
+            for (auto chain : jetChains) {
+                for (auto name : names) {
+                    if ( chain->GetBranch( name ) && chain->GetBranchStatus( name ) ) {
+                        chain->SetBranchStatus( name, 0 );
+                    }
+                }
+            }
+        };
+        if ( !inputs.isJetContentRequired( InputRequirements::kJetTrackMax ) ) {
+            disable( { "trackMax" } );
+        }
+        if ( !inputs.isJetContentRequired( InputRequirements::kJetWTAAxes ) ) {
+            disable( { "WTAeta", "WTAphi", "WTAgeneta", "WTAgenphi", "refWTAeta", "refWTAphi" } );
+        }
+        if ( !inputs.isJetContentRequired( InputRequirements::kJetPFFractions ) ) {
+            disable( { "jtPfNHF", "jtPfNEF", "jtPfCHF", "jtPfMUF", "jtPfCEF" } );
+        }
+        if ( !inputs.isJetContentRequired( InputRequirements::kJetPFMultiplicities ) ) {
+            disable( { "jtPfCHM", "jtPfCEM", "jtPfNHM", "jtPfNEM", "jtPfMUM" } );
+        }
+        if ( !inputs.isJetContentRequired( InputRequirements::kJetPartonFlavor ) ) {
+            disable( { "refparton_flavor", "refparton_flavorForB" } );
+        }
+    }
+
+    int nBranchesAfter{0};
+    double bytesAfter{0};
+    for (auto chain : chains) {
+        enabledBranchesSize( chain, nBranchesAfter, bytesAfter );
+    }
+
+    inputs.print();
+    std::cout << Form("Branches read: %d -> %d. Uncompressed size per entry: %.1f -> %.1f bytes (%.1f%% less)\n",
+                      nBranchesBefore, nBranchesAfter, bytesBefore, bytesAfter, 
+                      ( bytesBefore > 0 ) ? 100. * (bytesBefore - bytesAfter) / bytesBefore : 0. );
+}
+
+//_________________
+double ForestAODReader::subStageTime() const {
+    return fStageStats->time(fStageJetCorrections) + fStageStats->time(fStageJetCut) + 
+           fStageStats->time(fStageEventCut) + fStageStats->time(fStageGetEntry);
+}
+
+//_________________
+void ForestAODReader::setShard(const int& index, const int& nShards) {
+    BaseReader::setShard(index, nShards);
+    // If chains are already set up then update number of events to read
+    if ( fEventTree || fRNTupleInput ) {
+        applyEntryRange();
+    }
+}
+
+//_________________
+void ForestAODReader::applyEntryRange(const bool& verbose) {
+    const Long64_t last = resolveEntryRange( fEntriesInChain );
+    fEntriesInRange = last - fFirstEntry;
+    fEvents2Read = nSampledEntries( fEntriesInRange );
+    fEventsProcessed = 0;
+    fReaderStatus = 0;
+
+    if ( verbose && fEvents2Read != fEntriesInChain ) {
+        std::cout << Form("Entry range to read: [%lld, %lld). Number of events to read: %lld\n", 
+                          fFirstEntry, last, fEvents2Read );
+    }
+}
+
+//_________________
+void ForestAODReader::setSampling(const Long64_t& step, const Long64_t& blockSize) {
+    BaseReader::setSampling(step, blockSize);
+    // If chains are already set up then update number of events to read
+    if ( fEventTree || fRNTupleInput ) {
+        applyEntryRange();
+    }
 }
 
 //_________________
@@ -1201,13 +2231,27 @@ void ForestAODReader::readEvent() {
         std::cerr << "ForestAODReader::readEvent() out of entry numbers\n"; 
         fReaderStatus = 2; // End of input stream
     }
-    fEventTree->GetEntry( fEventsProcessed );
-    if (fUseHltBranch) fHltTree->GetEntry(fEventsProcessed);
-    if (fUseSkimmingBranch) fSkimTree->GetEntry(fEventsProcessed);
-    if (fUseRecoJetBranch) fRecoJetTree->GetEntry(fEventsProcessed);
-    if (fUseTrackBranch) fTrkTree->GetEntry(fEventsProcessed);
-    if (fUseGenTrackBranch) fGenTrkTree->GetEntry(fEventsProcessed);
+    // Entry number in the chain
+    fCurrentEntry = entryNumber( fEventsProcessed );
+    // Friends follow the event tree: a single call positions all trees
+    if ( fUseFriendChain ) {
+        loadFriendChain( fCurrentEntry );
+    }
+    readChainEntry( kEventChain, fCurrentEntry );
+    if (fUseHltBranch) readChainEntry( kHltChain, fCurrentEntry );
+    if (fUseSkimmingBranch) readChainEntry( kSkimChain, fCurrentEntry );
     fEventsProcessed++;
+    fEntriesRead++;
+
+    // Trees are checked when the event tree moves to another file. RNTuples
+    // were checked when they were converted
+    const int treeNumber = ( fEventTree ) ? fEventTree->GetTreeNumber() : -1;
+    if ( fEventTree && 
+         ( fAlignmentCheck > 1 || ( fAlignmentCheck == 1 && treeNumber != fAlignmentTreeNumber ) ) ) {
+        fAlignmentTreeNumber = treeNumber;
+        checkAlignment( kHltChain );
+        fCheckObjectAlignment = true;
+    }
 
     if ( fVerbose ) {
         std::cout << "Events processed: " << fEventsProcessed << std::endl;
@@ -1215,6 +2259,193 @@ void ForestAODReader::readEvent() {
     }
 }
 
+//________________
+Long64_t ForestAODReader::readBatch(JetBatch& batch, const Long64_t& nEvents) {
+    batch.clear();
+    if ( !fUseRecoJetBranch ) {
+        std::cout << "[WARNING] ForestAODReader::readBatch - jet tree is not read\n";
+        return 0;
+    }
+    // PF fractions are read only if required by the analyses
+    batch.setHasPFFractions( ( fRNTupleInput ) ? fRNTupleInput->isFieldRead( fRecoJetTreeName.Data(), "jtPfCHF" ) :
+                                                 fRecoJetTree->GetBranchStatus("jtPfCHF") );
+    const Long64_t nBatch = std::min( nEvents, fEvents2Read - fEventsProcessed );
+    if ( nBatch <= 0 ) {
+        fReaderStatus = 2; // End of input stream
+        return 0;
+    }
+    batch.reserve( nBatch, nBatch * 8 );
+
+    for (Long64_t iEvent{0}; iEvent<nBatch; iEvent++) {
+        fCurrentEntry = entryNumber( fEventsProcessed );
+        {
+            StageTimer timer(fStageStats, fStageGetEntry);
+            if ( fUseFriendChain ) {
+                loadFriendChain( fCurrentEntry );
+            }
+            readChainEntry( kEventChain, fCurrentEntry );
+            readChainEntry( kJetChain, fCurrentEntry );
+        }
+        fEventsProcessed++;
+        fEntriesRead++;
+
+        // Jet arrays are filled directly by ROOT: whole ranges are appended to the columns
+        checkBufferOverflow();
+        const int nJets = std::max( fNRecoJets, 0 );
+        batch.addEvent( fCurrentEntry, fVertexZ, ( fIsMc ) ? fPtHatWeight : 1.f );
+        batch.addJets( nJets, fRecoJetPt.data(), fRecoJetEta.data(), fRecoJetPhi.data() );
+        if ( batch.hasPFFractions() ) {
+            batch.addPFFractions( nJets, fRecoJtPfCHF.data(), fRecoJtPfNHF.data(), fRecoJtPfCEF.data(), 
+                                  fRecoJtPfNEF.data(), fRecoJtPfMUF.data() );
+        }
+    }
+    return static_cast<Long64_t>( batch.nEvents() );
+}
+
+//________________
+void ForestAODReader::readObjects() {
+    // Jet and track trees are the largest ones: their baskets are
+    // decompressed only for entries that passed the event selection
+    if (fUseRecoJetBranch) readChainEntry( kJetChain, fCurrentEntry );
+    for (auto& input : fJetCollectionInputs) {
+        readJetCollection( input );
+    }
+    if (fUseTrackBranch) readChainEntry( kTrackChain, fCurrentEntry );
+    if (fUseGenTrackBranch) readChainEntry( kGenTrackChain, fCurrentEntry );
+    checkBufferOverflow();
+
+    // First entry that passed the selection after the check of the event-level trees
+    if ( fCheckObjectAlignment ) {
+        checkAlignment( kJetChain );
+        checkAlignment( kTrackChain );
+        checkAlignment( kGenTrackChain );
+        fCheckObjectAlignment = false;
+    }
+}
+
+//________________
+void ForestAODReader::readChainEntry(const int& iChain, const Long64_t& entry) {
+    // RNTuples of the converted trees fill the same variables
+    if ( fRNTupleInput ) {
+        const char *names[kNChains] = { ForestRNTupleInput::kEventNTuple, ForestRNTupleInput::kHltNTuple, 
+                                        ForestRNTupleInput::kSkimNTuple, fRecoJetTreeName.Data(), nullptr, nullptr };
+        if ( names[iChain] ) fRNTupleInput->readEntry( names[iChain], entry );
+        return;
+    }
+    TChain *chain = fChainIO.at(iChain).chain;
+    if ( !chain ) return;
+    // Trees are already positioned by loadFriendChain()
+    if ( fUseFriendChain ) {
+        readLoadedBranches( iChain );
+        return;
+    }
+    // Statistics are kept by the file: collect them before the chain moves to another file
+    const int treeNumber = chain->GetTreeNumber();
+    if ( treeNumber >= 0 ) {
+        const Long64_t *offsets = chain->GetTreeOffset();
+        if ( entry < offsets[treeNumber] || entry >= offsets[treeNumber + 1] ) {
+            collectIOStats( iChain );
+        }
+    }
+    // Buffers are fitted to the file before its arrays are read
+    if ( iChain == kJetChain || iChain == kTrackChain ) {
+        chain->LoadTree( entry );
+        fitBuffers( iChain );
+    }
+    chain->GetEntry( entry );
+}
+
+//________________
+void ForestAODReader::loadFriendChain(const Long64_t& entry) {
+    // Friends move to another file together with the event tree
+    const int treeNumber = fEventTree->GetTreeNumber();
+    if ( treeNumber >= 0 ) {
+        const Long64_t *offsets = fEventTree->GetTreeOffset();
+        if ( entry < offsets[treeNumber] || entry >= offsets[treeNumber + 1] ) {
+            for (int iChain{0}; iChain<kNChains; iChain++) {
+                collectIOStats( iChain );
+            }
+        }
+    }
+    if ( fEventTree->LoadTree( entry ) < 0 ) {
+        std::cerr << Form("[ERROR] ForestAODReader::loadFriendChain - cannot load entry %lld. Terminating\n", entry);
+        exit(1);
+    }
+}
+
+//________________
+void ForestAODReader::readLoadedBranches(const int& iChain) {
+    ChainIO &io = fChainIO.at(iChain);
+    TTree *tree = io.chain->GetTree();
+    const Long64_t localEntry = ( tree ) ? tree->GetReadEntry() : -1;
+    if ( localEntry < 0 ) {
+        std::cerr << Form("[ERROR] ForestAODReader::readLoadedBranches - entry %lld is not found in %s tree. Terminating\n",
+                          fCurrentEntry, io.name.c_str());
+        exit(1);
+    }
+    // Tree of the event chain has the friends attached: reading the tree would read
+    // all of them, so only its own enabled branches are read. The list is made once per file
+    if ( io.chain->GetTreeNumber() != io.treeNumber ) {
+        io.treeNumber = io.chain->GetTreeNumber();
+        if ( iChain == kJetChain || iChain == kTrackChain ) {
+            fitBuffers( iChain );
+        }
+        io.branches.clear();
+        TIter next( tree->GetListOfBranches() );
+        while ( TBranch *branch = static_cast<TBranch*>( next() ) ) {
+            if ( tree->GetBranchStatus( branch->GetName() ) ) {
+                io.branches.push_back( branch );
+            }
+        }
+    }
+    for (auto branch : io.branches) {
+        branch->GetEntry( localEntry );
+    }
+}
+
+//________________
+void ForestAODReader::checkAlignment(const int& iChain) const {
+    const ChainIO &io = fChainIO.at(iChain);
+    if ( !io.checkAlignment ) return;
+    TTree *tree = io.chain->GetTree();
+    if ( !tree || tree->GetReadEntry() < 0 ) return;
+    TBranch *runBranch = tree->GetBranch( io.runName.c_str() );
+    TBranch *eventBranch = tree->GetBranch( io.eventName.c_str() );
+    if ( !runBranch || !eventBranch ) return;
+
+    // Disabled branches are read for the loaded entry only. Values are taken
+    // from the leaves: no branch address is needed
+    runBranch->GetEntry( tree->GetReadEntry(), 1 );
+    eventBranch->GetEntry( tree->GetReadEntry(), 1 );
+    TLeaf *runLeaf = runBranch->GetLeaf( io.runName.c_str() );
+    TLeaf *eventLeaf = eventBranch->GetLeaf( io.eventName.c_str() );
+    if ( !runLeaf || !eventLeaf ) return;
+
+    // Some trees store the event number as a 32-bit integer
+    const ULong64_t eventMask = ( eventLeaf->GetLenType() < 8 ) ? 0xFFFFFFFFull : ~0ull;
+    const ULong64_t run = static_cast<ULong64_t>( runLeaf->GetValueLong64() );
+    const ULong64_t event = static_cast<ULong64_t>( eventLeaf->GetValueLong64() );
+    if ( run != fRunId || ( event & eventMask ) != ( fEventId & eventMask ) ) {
+        std::cerr << Form("[ERROR] ForestAODReader::checkAlignment - entry %lld: %s tree has run/event %llu/%llu, event tree has %u/%llu. Trees are misaligned. Terminating\n",
+                          fCurrentEntry, io.name.c_str(), run, event, fRunId, fEventId);
+        exit(1);
+    }
+}
+
+//________________
+void ForestAODReader::collectIOStats(const int& iChain) {
+    ChainIO &io = fChainIO.at(iChain);
+    TFile *file = ( io.chain ) ? io.chain->GetCurrentFile() : nullptr;
+    if ( !file ) return;
+    io.bytesRead += file->GetBytesRead();
+    io.readCalls += file->GetReadCalls();
+    TFileCacheRead *cache = file->GetCacheRead( io.chain->GetTree() );
+    if ( cache ) {
+        io.cacheBytesRead += cache->GetBytesRead();
+        io.noCacheBytesRead += cache->GetNoCacheBytesRead();
+    }
+}
+
 //________________
 void ForestAODReader::fixIndices() {
 
@@ -1444,18 +2675,26 @@ Event* ForestAODReader::returnEvent() {
     clearVariables();
 
     //std::cout << "ForestAODReader::returnEvent" << std::endl;
-    readEvent();
+    {
+        StageTimer timer(fStageStats, fStageGetEntry);
+        readEvent();
+    }
 
-    if ( fIsMc ) {
-        fixIndices();
+    // Event construction time does not include jet corrections and cuts
+    std::chrono::steady_clock::time_point constructionStart{};
+    double subStageTimeStart{0};
+    if ( fStageStats ) {
+        constructionStart = std::chrono::steady_clock::now();
+        subStageTimeStart = subStageTime();
     }
 
-    fEvent = new Event();
+    fEvent = fEventPool->get();
 
     // Remove UPC bins
     if ( fIsMc && fCorrectCentMC && fHiBin<10) {
-        delete fEvent;
+        fEventPool->put( fEvent );
         fEvent = nullptr;
+        fEntriesRejectedEarly++;
         return fEvent;
     }
 
@@ -1486,78 +2725,44 @@ Event* ForestAODReader::returnEvent() {
         fEvent->setPtHatWeight( 1. );        
     }
 
-    // Fill HLT branch
-    if ( fUseHltBranch ) {
-
-        fEvent->trigAndSkim()->setHLT_HIAK4CaloJet60_v1(fHLT_HIAK4CaloJet60_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK4CaloJet80_v1(fHLT_HIAK4CaloJet80_v1);
-        fEvent->trigAndSkim()->setHLT_PAAK4CaloJet60_Eta5p1_v3(fHLT_PAAK4CaloJet60_Eta5p1_v3);
-        fEvent->trigAndSkim()->setHLT_PAAK4CaloJet80_Eta5p1_v3(fHLT_PAAK4CaloJet80_Eta5p1_v3);
-        fEvent->trigAndSkim()->setHLT_PAAK4CaloJet100_Eta5p1_v3(fHLT_PAAK4CaloJet100_Eta5p1_v3);
-        fEvent->trigAndSkim()->setHLT_PAAK4PFJet60_Eta5p1_v4(fHLT_PAAK4PFJet60_Eta5p1_v4);
-        fEvent->trigAndSkim()->setHLT_PAAK4PFJet80_Eta5p1_v3(fHLT_PAAK4PFJet80_Eta5p1_v3);
-        fEvent->trigAndSkim()->setHLT_PAAK4PFJet100_Eta5p1_v3(fHLT_PAAK4PFJet100_Eta5p1_v3);
-        fEvent->trigAndSkim()->setHLT_PAAK4PFJet120_Eta5p1_v2(fHLT_PAAK4PFJet120_Eta5p1_v2);
-
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet15_v1(fHLT_HIAK4PFJet15_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet15_v1_Prescl(fHLT_HIAK4PFJet15_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet30_v1(fHLT_HIAK4PFJet30_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet30_v1_Prescl(fHLT_HIAK4PFJet30_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet40_v1(fHLT_HIAK4PFJet40_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet40_v1_Prescl(fHLT_HIAK4PFJet40_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet60_v1(fHLT_HIAK4PFJet60_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet60_v1_Prescl(fHLT_HIAK4PFJet60_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet80_v1(fHLT_HIAK4PFJet80_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet80_v1_Prescl(fHLT_HIAK4PFJet80_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet120_v1(fHLT_HIAK4PFJet120_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK4PFJet120_v1_Prescl(fHLT_HIAK4PFJet120_v1_Prescl);
-
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet15_v1(fHLT_HIAK8PFJet15_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet15_v1_Prescl(fHLT_HIAK8PFJet15_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet25_v1(fHLT_HIAK8PFJet25_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet25_v1_Prescl(fHLT_HIAK8PFJet25_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet40_v1(fHLT_HIAK8PFJet40_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet40_v1_Prescl(fHLT_HIAK8PFJet40_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet60_v1(fHLT_HIAK8PFJet60_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet60_v1_Prescl(fHLT_HIAK8PFJet60_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet80_v1(fHLT_HIAK8PFJet80_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet80_v1_Prescl(fHLT_HIAK8PFJet80_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet140_v1(fHLT_HIAK8PFJet140_v1);
-        fEvent->trigAndSkim()->setHLT_HIAK8PFJet140_v1_Prescl(fHLT_HIAK8PFJet140_v1_Prescl);
-
-        fEvent->trigAndSkim()->setHLT_HIPFJet25_v1(fHLT_HIPFJet25_v1);
-        fEvent->trigAndSkim()->setHLT_HIPFJet25_v1_Prescl(fHLT_HIPFJet25_v1_Prescl);
-        fEvent->trigAndSkim()->setHLT_HIPFJet140_v1(fHLT_HIPFJet140_v1);
-        fEvent->trigAndSkim()->setHLT_HIPFJet140_v1_Prescl(fHLT_HIPFJet140_v1_Prescl);
-
-        fEvent->trigAndSkim()->setHLT_HIPuAK4CaloJet80Eta5p1_v1(fHLT_HIPuAK4CaloJet80Eta5p1_v1);
-        fEvent->trigAndSkim()->setHLT_HIPuAK4CaloJet100Eta5p1_v1(fHLT_HIPuAK4CaloJet100Eta5p1_v1);
-    }
-
-    // Fill skimming branch
-    if ( fUseSkimmingBranch ) {
-        fEvent->trigAndSkim()->setHBHENoiseFilterResultRun2Loose(fHBHENoiseFilterResultRun2Loose);
-        fEvent->trigAndSkim()->setHBHENoiseFilterResultRun2Tight(fHBHENoiseFilterResultRun2Tight);
-        fEvent->trigAndSkim()->setHBHEIsoNoiseFilterResult(fHBHEIsoNoiseFilterResult);
-        fEvent->trigAndSkim()->setCollisionEventSelectionAODv2(fCollisionEventSelectionAODv2);
-        fEvent->trigAndSkim()->setPhfCoincFilter2Th4(fPhfCoincFilter2Th4);
-        fEvent->trigAndSkim()->setPPAprimaryVertexFilter(fPPAprimaryVertexFilter);
-        fEvent->trigAndSkim()->setPBeamScrapingFilter(fPBeamScrapingFilter);
-        fEvent->trigAndSkim()->setPprimaryVertexFilter(fPprimaryVertexFilter);
-        fEvent->trigAndSkim()->setPVertexFilterCutG(fPVertexFilterCutG);
-        fEvent->trigAndSkim()->setPVertexFilterCutGloose(fPVertexFilterCutGloose);
-        fEvent->trigAndSkim()->setPVertexFilterCutGtight(fPVertexFilterCutGtight);
-        fEvent->trigAndSkim()->setPVertexFilterCutE(fPVertexFilterCutE);
-        fEvent->trigAndSkim()->setPVertexFilterCutEandG(fPVertexFilterCutEandG);
-        fEvent->trigAndSkim()->setPClusterCompatibilityFilter(fPClusterCompatibilityFilter);
-
-        fEvent->trigAndSkim()->setPhfCoincFilter(fPhfCoincFilter);
-        fEvent->trigAndSkim()->setPVertexFilterCutdz1p0(fPVertexFilterCutdz1p0);
-        fEvent->trigAndSkim()->setPVertexFilterCutGplus(fPVertexFilterCutGplus);
-        fEvent->trigAndSkim()->setPVertexFilterCutVtx1(fPVertexFilterCutVtx1);
+    // Fill trigger and skimming flags (flags not read stay 0)
+    ULong64_t triggerAndSkimMask{0};
+    for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+        if ( fTriggerAndSkim[iFlag] != 0 ) triggerAndSkimMask |= TriggerAndSkim::flagBit( iFlag );
     }
+    fEvent->trigAndSkim()->setMask( triggerAndSkimMask );
 
     //fEvent->print();
+
+    // Event selection uses event-level quantities only: jets and tracks
+    // of the rejected entries are not read
+    bool isGoodEvent{true};
+    {
+        StageTimer timer(fStageStats, fStageEventCut);
+        isGoodEvent = ( !fEventCut || fEventCut->pass(fEvent) );
+    }
+    if ( !isGoodEvent ) {
+        if ( fVerbose ) {
+            std::cout << "Event did not pass the cut" << std::endl;
+        }
+        fEventPool->put( fEvent );
+        fEvent = nullptr;
+        fEntriesRejectedEarly++;
+        if ( fStageStats ) {
+            double constructionTime = std::chrono::duration<double>( std::chrono::steady_clock::now() - constructionStart ).count();
+            fStageStats->add( fStageEventConstruction, constructionTime - ( subStageTime() - subStageTimeStart ) );
+        }
+        return fEvent;
+    }
+
+    {
+        StageTimer timer(fStageStats, fStageGetEntry);
+        readObjects();
+    }
+
+    if ( fIsMc ) {
+        fixIndices();
+    }
     
     //
     // Create particle flow jet instances
@@ -1579,7 +2784,7 @@ Event* ForestAODReader::returnEvent() {
                 std::cout << "Filling GenJets: " << fNGenJets << std::endl;
             }
             for (int iGenJet{0}; iGenJet<fNGenJets; iGenJet++) {
-                GenJet *jet = new GenJet{};
+                GenJet *jet = fEvent->newGenJet();
                 jet->setId( iGenJet );
                 jet->setPt( fGenJetPt[iGenJet] );
                 jet->setEta( fGenJetEta[iGenJet] );
@@ -1617,8 +2822,8 @@ Event* ForestAODReader::returnEvent() {
 
         for (int iJet{0}; iJet<fNRecoJets; iJet++) {
 
-            // Create a new jet instance
-            RecoJet *jet = new RecoJet{};
+            // Take a jet instance from the event pool
+            RecoJet *jet = fEvent->newRecoJet();
 
             if ( fIsMc ) {
                 // Add index of the matched GenJet
@@ -1633,6 +2838,7 @@ Event* ForestAODReader::returnEvent() {
             jet->setWTAEta( fRecoJetWTAEta[iJet] );
             jet->setWTAPhi( fRecoJetWTAPhi[iJet] );
             jet->setTrackMaxPt( fRecoJetTrackMax[iJet] );
+            StageTimer jecTimer(fStageStats, fStageJetCorrections);
             if ( fJEC ) {
                 fJEC->SetJetPT( fRecoJetPt[iJet] );
                 fJEC->SetJetEta( fRecoJetEta[iJet] );
@@ -1693,6 +2899,7 @@ Event* ForestAODReader::returnEvent() {
                 }
                 jet->setPtJECCorr( -999.f );
             }
+            jecTimer.stop();
             jet->setJtPfNHF( fRecoJtPfNHF[iJet] );
             jet->setJtPfNEF( fRecoJtPfNEF[iJet] );
             jet->setJtPfCHF( fRecoJtPfCHF[iJet] );
@@ -1710,11 +2917,16 @@ Event* ForestAODReader::returnEvent() {
             }
 
             // Check front-loaded cut
-            if ( fJetCut && !fJetCut->pass(jet, false, false, false) ) {
+            bool isGoodJet{true};
+            {
+                StageTimer timer(fStageStats, fStageJetCut);
+                isGoodJet = ( !fJetCut || fJetCut->pass(jet, false, false, false) );
+            }
+            if ( !isGoodJet ) {
                 if ( fVerbose ) {
                     std::cout << "Reco jet # " << iJet << " failed cut" << std::endl;
                 }
-                delete jet;
+                // Jet stays in the pool and is reused by the next one
                 continue;
             }
 
@@ -1722,12 +2934,19 @@ Event* ForestAODReader::returnEvent() {
         } // for (int iJet{0}; iJet<fNRecoJets; iJet++)
     } // if ( fUseRecoJetBranch )
 
-    if ( fEventCut && !fEventCut->pass(fEvent) ) {
-        if ( fVerbose ) {
-            std::cout << "Event did not pass the cut" << std::endl;
+    // Jets of the additional trees
+    if ( fUseRecoJetBranch ) {
+        fEvent->setRecoJetCollectionName( fRecoJetTreeName.Data() );
+        for (auto& input : fJetCollectionInputs) {
+            fillJetCollection( input );
         }
-        delete fEvent;
-        fEvent = nullptr;
+    }
+
+    fillTrackViews();
+
+    if ( fStageStats ) {
+        double constructionTime = std::chrono::duration<double>( std::chrono::steady_clock::now() - constructionStart ).count();
+        fStageStats->add( fStageEventConstruction, constructionTime - ( subStageTime() - subStageTimeStart ) );
     }
 
     if ( fVerbose ) {
@@ -14,6 +14,7 @@
 
 // ROOT headers
 #include "Rtypes.h"
+#include "TBranch.h"
 #include "TChain.h"
 #include "TString.h"
 #include "TF1.h"
@@ -21,14 +22,23 @@
 
 // JetAnalysis headers
 #include "BaseReader.h"
+#include "BranchBuffer.h"
 #include "Event.h"
+#include "EventPool.h"
 #include "EventCut.h"
 #include "JetCut.h"
+#include "TrackCut.h"
 #include "JetCorrector.h"
 #include "JetUncertainty.h"
 
 // C++ headers
 #include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class ForestRNTupleInput;
 
 //_________________
 class ForestAODReader : public BaseReader {
@@ -48,6 +58,8 @@ class ForestAODReader : public BaseReader {
 
     /// @brief  Initialize input
     int init();
+    /// @brief Validate files of the input list (and update the entry manifest) once
+    void prepareInput();
     /// @brief Finish (print final information)
     void finish();
     /// Read event and fill objects
@@ -63,6 +75,11 @@ class ForestAODReader : public BaseReader {
     void useRecoJetBranch() { fUseRecoJetBranch = {true}; }
     /// @brief Set particle flow jet branch name
     void setRecoJetBranchName(const char *name = "akCs4PFJetAnalyzer") { fRecoJetTreeName = name; }
+    /// @brief Read one more jet tree (e.g. ak4PFJetAnalyzer) in the same pass. Jets are corrected
+    /// with the given JEC files (same location as addJECFile()), pass the jet cut and are stored
+    /// in the event collection named after the tree. For MC the generated jets of the tree are stored
+    /// with the collection (Event::genJetCollection(name)) and the reco jets are matched to them
+    void addJetCollection(const char *treeName, const std::vector<std::string>& jecFiles);
     /// Turn-on track branch to be read
     void useTrackBranch()       { fUseTrackBranch = {true}; }
 
@@ -88,6 +105,8 @@ class ForestAODReader : public BaseReader {
     void setEventCut(EventCut *cut) { fEventCut = {cut}; }
     /// @brief Set jet cut
     void setJetCut(JetCut *cut) { fJetCut = {cut}; }
+    /// @brief Set track cut (tracks and generated particles)
+    void setTrackCut(TrackCut *cut) { fTrackCut = {cut}; }
     /// @brief Is the dataset from MC
     void setIsMc() { fIsMc = {true}; }
     /// @brief Correct centrality for MC events
@@ -110,9 +129,68 @@ class ForestAODReader : public BaseReader {
     void setPbGoingDir(const bool &pb = true) { fIsPbGoingDir = pb; }
     /// @brief Add lorentz shift
     void setEtaShift(const float& shift)  { fEtaShift = shift; }
+    /// @brief Set TTreeCache size in bytes of all chains (0 - no cache, negative - ROOT default)
+    void setTreeCacheSize(const Long64_t& bytes) { fTreeCacheSize = bytes; }
+    /// @brief Set TTreeCache size in bytes of a single chain: event, hlt, skim, jet, track or genTrack
+    void setTreeCacheSize(const char *chain, const Long64_t& bytes) { fChainTreeCacheSize[chain] = bytes; }
+    /// @brief Number of entries the cache learns the branches to read from.
+    /// 0 - all enabled branches are cached from the first entry (default)
+    void setTreeCacheLearnEntries(const int& n = 0) { fTreeCacheLearnEntries = (n < 0) ? 0 : n; }
+    /// @brief Prefetch baskets asynchronously (TFile.AsyncPrefetching)
+    void useAsyncPrefetch(const bool& prefetch = true) { fUseAsyncPrefetch = prefetch; }
+    /// @brief Read HLT, skimming, jet and track trees as friends of the event tree:
+    /// the event tree alone decides which file and entry are loaded
+    void useFriendChain(const bool& use = true) { fUseFriendChain = use; }
+    /// @brief Match jet tree entries to the event tree by (run, evt) index instead of
+    /// by entry number (implies friend chain). Building the index reads run and evt of all entries
+    void useEventIndex(const bool& use = true) { fUseEventIndex = use; if ( use ) fUseFriendChain = true; }
+    /// @brief Compare run and event numbers of the HLT, jet and track trees to the event tree
+    /// and terminate if they differ: 0 - never, 1 - first entry read from each file (default), 2 - every entry
+    void setAlignmentCheck(const int& mode = 1) { fAlignmentCheck = mode; }
+    /// @brief Set number of threads that open the files of the list to validate them (default: 8)
+    void setNumberOfValidationThreads(const int& n = 8) { fNValidationThreads = (n < 1) ? 1 : n; }
+    /// @brief Set file where the number of entries of each input file is stored
+    /// (default: file list name + .manifest). Implies useEntryManifest()
+    void setEntryManifest(const char *name) { fEntryManifest = name; fUseEntryManifest = true; }
+    /// @brief Read and update the entry manifest of the file list (default: false). Files found
+    /// in it with the same size and modification time are not opened at startup
+    void useEntryManifest(const bool& use = true) { fUseEntryManifest = use; }
+    /// @brief Input files are RNTuple conversions of the forest (see ForestRNTupleConverter).
+    /// Event, HLT, skimming and jet trees are read from the RNTuples into the same buffers,
+    /// so events are identical to the ones read from the trees. Tracks are not available
+    void useRNTupleInput(const bool& use = true) { fUseRNTupleInput = use; }
 
     /// @brief Return amount of events to read
     Long64_t nEventsTotal() const { return fEvents2Read; }
+    /// @brief Return number of entries in the whole chain
+    Long64_t nEntriesInChain() const { return fEntriesInChain; }
+    /// @brief Return number of entries in the entry range (before sampling)
+    Long64_t nEntriesInRange() const { return fEntriesInRange; }
+    /// @brief Read only the first of every step blocks of blockSize consecutive entries
+    void setSampling(const Long64_t& step, const Long64_t& blockSize = 1);
+    /// @brief Read only entries [first, last) of the chain. Negative last means till the end of chain
+    void setEntryRange(const Long64_t& first, const Long64_t& last = -1);
+    /// @brief Split the entry range into tasks at cluster boundaries of the jet tree
+    /// (aligned to the sampling blocks). Opens every file of the range
+    void entryTasks(std::vector<EntryTask>& tasks) const;
+    /// @brief Read entries of the task [task.first, task.last)
+    void startTask(const EntryTask& task);
+    /// @brief Read raw jets (and PF fractions if they are read) of the next nEvents entries
+    /// of the entry range into the batch. Event and jet trees only: no JEC, no cuts
+    Long64_t readBatch(JetBatch& batch, const Long64_t& nEvents);
+    /// @brief Return event to the pool of events for reuse
+    void recycleEvent(Event *event) { fEventPool->put( event ); }
+    /// @brief Add input files, JEC and JEU files and the settings of jet corrections
+    void cacheKey(std::vector<std::string>& files, std::string& settings) const;
+    /// @brief Tracks or additional jet collections are read
+    bool hasUncachedContent() const
+    { return ( fUseTrackBranch || fUseGenTrackBranch || !fJetCollectionInputs.empty() ); }
+
+    /// @brief Set stats where time spent in the reading stages is stored
+    void setStageStats(StageStats *stats);
+
+    /// @brief Read only shard index of nShards equal parts of the entry range (e.g. one condor job of many)
+    void setShard(const int& index, const int& nShards);
 
   private:
 
@@ -126,16 +204,121 @@ class ForestAODReader : public BaseReader {
                     TChain *trkChain, bool useMC, TChain *genTrkChain);
     /// Setup chains to be filled
     int setupChains();
+    /// @brief Read names of the input files (single file or list of files)
+    void readInputFiles(std::vector<std::string>& files) const;
+    /// @brief Open RNTuple input and set addresses of the fields required by the analyses and cuts
+    int setupRNTupleInput();
+    /// @brief Number of event tree entries of the input file and the file state they were counted for
+    struct InputFileInfo {
+        /// @brief Number of entries (-1 - file is not valid)
+        Long64_t entries{-1};
+        /// @brief File size in bytes (-1 - unknown)
+        Long64_t size{-1};
+        /// @brief Modification time of the file
+        Long_t modTime{0};
+    };
+    /// @brief Open files in parallel and return number of event tree entries in each (-1 - not valid)
+    void validateFiles(const std::vector<std::string>& files, std::vector<InputFileInfo>& infos) const;
+    /// @brief Read number of entries of the files from the entry manifest
+    bool readEntryManifest(const TString& name, std::map<std::string, InputFileInfo>& infos) const;
+    /// @brief Write number of entries of the files into the entry manifest
+    void writeEntryManifest(const TString& name, const std::map<std::string, InputFileInfo>& infos) const;
+    /// @brief Entries of the manifest are valid if the file was valid and has the same size and modification time
+    bool isEntryUpToDate(const std::string& file, const InputFileInfo& info) const;
     /// Setup branches
     void setupBranches();
+    /// @brief Fill the list of chains used for reading and I/O statistics
+    void setupChainIO();
+    /// @brief Enable run and event branches of the trees to check
+    void setupAlignmentCheck();
+    /// @brief Add trees as friends of the event tree (and build the event index)
+    void setupFriendChain();
+    /// @brief Setup TTreeCache of all chains (after the branches to read are known)
+    void setupTreeCache();
+    /// @brief Disable branches that are not required by the analyses and cuts
+    void applyRequiredInputs();
+    /// @brief Add number of enabled branches of the chain and their uncompressed size per entry
+    void enabledBranchesSize(TChain *chain, int& nBranches, double& bytesPerEntry) const;
 
     /// @brief Clear variables for reading
     void clearVariables();
+    /// @brief Reset the first entries of the jet and track arrays
+    void clearArrays(const int& nRecoJets, const int& nGenJets, const int& nTracks);
+    /// @brief Allocate jet (reco, ref and gen) buffers of the given size
+    void allocateJetBuffers(const size_t& n);
+    /// @brief Allocate track buffers of the given size
+    void allocateTrackBuffers(const size_t& n);
+    /// @brief Set addresses of the jet array branches
+    void setJetBranchAddresses();
+    /// @brief Set addresses of the track array branches
+    void setTrackBranchAddresses();
+    /// @brief Grow buffers of the jet or track chain if the current file has longer arrays
+    void fitBuffers(const int& iChain);
+    /// @brief Maximal value of the counter branch in the tree (0 - branch is not found)
+    size_t maximalArrayLength(TTree *tree, const char *counterName) const;
+    /// @brief Terminate if number of jets or tracks exceeds the buffer size
+    void checkBufferOverflow() const;
+    /// @brief Fill track views of the event with tracks and generated particles passing the track cut
+    void fillTrackViews();
+
+    /// @brief Jet tree read in addition to the main one
+    struct JetCollectionInput {
+        /// @brief Jet tree name (also the name of the event collection)
+        std::string name{};
+        /// @brief JEC files and the corrector
+        std::vector<std::string> jecFiles{};
+        JetCorrector *jec{nullptr};
+        /// @brief Chain of the jet tree
+        TChain *chain{nullptr};
+        /// @brief Buffer size and tree number the buffers were fitted to
+        size_t bufferSize{0};
+        int bufferTreeNumber{-1};
+        /// @brief Number of jets and their arrays
+        int nJets{0};
+        BranchBuffer<float> rawPt, eta, phi, wtaEta, wtaPhi, trackMax;
+        BranchBuffer<float> pfNHF, pfNEF, pfCHF, pfMUF, pfCEF;
+        BranchBuffer<int> pfCHM, pfCEM, pfNHM, pfNEM, pfMUM;
+        /// @brief Matched generated jet direction and parton flavor (MC only)
+        BranchBuffer<float> refEta, refPhi;
+        BranchBuffer<int> refFlavor, refFlavorForB;
+        /// @brief Generated jets of the tree (MC only). Jet radius may differ from the main tree
+        int nGenJets{0};
+        BranchBuffer<float> genPt, genEta, genPhi, genWTAEta, genWTAPhi;
+        /// @brief Jets are read from the RNTuple input
+        bool fromRNTuple{false};
+    };
+    /// @brief Enable branches and allocate buffers of the additional jet trees
+    void setupJetCollections();
+    /// @brief Grow buffers of the additional jet tree if the current file has longer arrays
+    void fitBuffers(JetCollectionInput& input);
+    /// @brief Allocate buffers of the additional jet tree of the given size
+    void allocateJetCollectionBuffers(JetCollectionInput& input, const size_t& n);
+    /// @brief Read entry of the additional jet tree
+    void readJetCollection(JetCollectionInput& input);
+    /// @brief Fill event collection of the additional jet tree
+    void fillJetCollection(JetCollectionInput& input);
     /// @brief Fix jet arrays
     void fixIndices();
 
-    /// @brief Call read event
+    /// @brief Read event-level quantities (event, HLT and skimming trees) of the next entry
     void readEvent();
+    /// @brief Read entry of the chain. I/O statistics of the file are collected before the chain leaves it
+    void readChainEntry(const int& iChain, const Long64_t& entry);
+    /// @brief Load entry of the event tree and its friends (friend chain only)
+    void loadFriendChain(const Long64_t& entry);
+    /// @brief Read enabled branches of the tree loaded by loadFriendChain
+    void readLoadedBranches(const int& iChain);
+    /// @brief Terminate if run or event number of the chain differs from the event tree
+    void checkAlignment(const int& iChain) const;
+    /// @brief Add I/O statistics of the current file of the chain
+    void collectIOStats(const int& iChain);
+    /// @brief Read jets and tracks of the current entry. Called only for entries
+    /// that passed the event selection
+    void readObjects();
+    /// @brief Recalculate number of events to read from the entry range
+    void applyEntryRange(const bool& verbose = true);
+    /// @brief Time spent in the stages called during event construction
+    double subStageTime() const;
 
     /// @brief Setup JEC
     void setupJEC();
@@ -161,6 +344,8 @@ class ForestAODReader : public BaseReader {
 
     /// @brief Event with jets and other variables
     Event *fEvent;
+    /// @brief Events reused between entries
+    EventPool *fEventPool; //!
 
     /// @brief Input filename (name.root) or file with list of ROOT files 
     const char *fInFileName;
@@ -168,6 +353,16 @@ class ForestAODReader : public BaseReader {
     Long64_t fEvents2Read;
     /// @brief How many events were processed
     Long64_t fEventsProcessed;
+    /// @brief Number of entries in the chain
+    Long64_t fEntriesInChain;
+    /// @brief Number of entries in the entry range (before sampling)
+    Long64_t fEntriesInRange;
+    /// @brief Chain entry being read
+    Long64_t fCurrentEntry;
+    /// @brief Number of entries read (over all entry ranges)
+    Long64_t fEntriesRead;
+    /// @brief Number of entries rejected before jets and tracks were read
+    Long64_t fEntriesRejectedEarly;
 
     /// @brief Is file with MC information
     bool fIsMc;
@@ -233,132 +428,74 @@ class ForestAODReader : public BaseReader {
     // Trigger and skimming information
     //
 
-    int fHLT_HIAK4CaloJet60_v1;
-    int fHLT_HIAK4CaloJet80_v1;
-    int fHLT_PAAK4CaloJet60_Eta5p1_v3;
-    int fHLT_PAAK4CaloJet80_Eta5p1_v3;
-    int fHLT_PAAK4CaloJet100_Eta5p1_v3;
-    int fHLT_PAAK4PFJet60_Eta5p1_v4;
-    int fHLT_PAAK4PFJet80_Eta5p1_v3;
-    int fHLT_PAAK4PFJet100_Eta5p1_v3;
-    int fHLT_PAAK4PFJet120_Eta5p1_v2;
-
-    int fHLT_HIAK4PFJet15_v1;
-    int fHLT_HIAK4PFJet15_v1_Prescl;
-    int fHLT_HIAK4PFJet30_v1;
-    int fHLT_HIAK4PFJet30_v1_Prescl;
-    int fHLT_HIAK4PFJet40_v1;
-    int fHLT_HIAK4PFJet40_v1_Prescl;
-    int fHLT_HIAK4PFJet60_v1;
-    int fHLT_HIAK4PFJet60_v1_Prescl;
-    int fHLT_HIAK4PFJet80_v1;
-    int fHLT_HIAK4PFJet80_v1_Prescl;
-    int fHLT_HIAK4PFJet120_v1;
-    int fHLT_HIAK4PFJet120_v1_Prescl;
-
-    int fHLT_HIAK8PFJet15_v1;
-    int fHLT_HIAK8PFJet15_v1_Prescl;
-    int fHLT_HIAK8PFJet25_v1;
-    int fHLT_HIAK8PFJet25_v1_Prescl;
-    int fHLT_HIAK8PFJet40_v1;
-    int fHLT_HIAK8PFJet40_v1_Prescl;
-    int fHLT_HIAK8PFJet60_v1;
-    int fHLT_HIAK8PFJet60_v1_Prescl;
-    int fHLT_HIAK8PFJet80_v1;
-    int fHLT_HIAK8PFJet80_v1_Prescl;
-    int fHLT_HIAK8PFJet140_v1;
-    int fHLT_HIAK8PFJet140_v1_Prescl;
-
-    int fHLT_HIPFJet25_v1;
-    int fHLT_HIPFJet25_v1_Prescl;
-    int fHLT_HIPFJet140_v1;
-    int fHLT_HIPFJet140_v1_Prescl;
-
-    int fHLT_HIPuAK4CaloJet80Eta5p1_v1;
-    int fHLT_HIPuAK4CaloJet100Eta5p1_v1;
-
-
-    // Skimanalysis part
-    int fHBHENoiseFilterResultRun2Loose;
-    int fHBHENoiseFilterResultRun2Tight;
-    int fHBHEIsoNoiseFilterResult;
-    int fCollisionEventSelectionAODv2;
-    int fPhfCoincFilter2Th4;
-    int fPPAprimaryVertexFilter;
-    int fPBeamScrapingFilter;
-    int fPprimaryVertexFilter;
-    int fPVertexFilterCutG;
-    int fPVertexFilterCutGloose;
-    int fPVertexFilterCutGtight;
-    int fPVertexFilterCutE;
-    int fPVertexFilterCutEandG;
-    int fPClusterCompatibilityFilter;
-
-    int fPhfCoincFilter;
-    int fPVertexFilterCutdz1p0;
-    int fPVertexFilterCutGplus;
-    int fPVertexFilterCutVtx1;
+    /// @brief Values of the trigger and skimming branches (in the order of TriggerAndSkim::Flag)
+    int fTriggerAndSkim[TriggerAndSkim::kNFlags];
 
     //
     // Jet information
     //
 
-    static constexpr size_t JET_ARRAY_SIZE = 1000;
-    static constexpr size_t TRACK_ARRAY_SIZE = 20000;
+    /// @brief Size of the jet and track buffers. Buffers are sized from the longest
+    /// arrays in the file and grow when a file with longer arrays is read
+    size_t fJetBufferSize;
+    size_t fTrackBufferSize;
+    /// @brief Tree numbers of the jet and track chains the buffers were fitted to
+    int fJetBufferTreeNumber;
+    int fTrackBufferTreeNumber;
 
     /// @brief Number of reconstructed jets
     int   fNRecoJets;
     /// @brief Reconstructed jet transverse momentum (without JEC)
-    float fRecoJetPt[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRecoJetPt; //!
     /// @brief Pseudorapidity of reconstructed jet
-    float fRecoJetEta[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRecoJetEta; //!
     /// @brief Azimuthal angle of reconstructed jet
-    float fRecoJetPhi[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRecoJetPhi; //!
     /// @brief WTA eta of reconstructed jet
-    float fRecoJetWTAEta[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRecoJetWTAEta; //!
     /// @brief WTA phi of reconstructed jet
-    float fRecoJetWTAPhi[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRecoJetWTAPhi; //!
     /// @brief Track with maximum pT in reconstructed jet
-    float fRecoJetTrackMax[JET_ARRAY_SIZE];
-
-    float fRecoJtPfNHF[JET_ARRAY_SIZE];
-    float fRecoJtPfNEF[JET_ARRAY_SIZE];
-    float fRecoJtPfCHF[JET_ARRAY_SIZE];
-    float fRecoJtPfMUF[JET_ARRAY_SIZE];
-    float fRecoJtPfCEF[JET_ARRAY_SIZE];
-    int fRecoJtPfCHM[JET_ARRAY_SIZE];
-    int fRecoJtPfCEM[JET_ARRAY_SIZE];
-    int fRecoJtPfNHM[JET_ARRAY_SIZE];
-    int fRecoJtPfNEM[JET_ARRAY_SIZE];
-    int fRecoJtPfMUM[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRecoJetTrackMax; //!
+
+    BranchBuffer<float> fRecoJtPfNHF; //!
+    BranchBuffer<float> fRecoJtPfNEF; //!
+    BranchBuffer<float> fRecoJtPfCHF; //!
+    BranchBuffer<float> fRecoJtPfMUF; //!
+    BranchBuffer<float> fRecoJtPfCEF; //!
+    BranchBuffer<int> fRecoJtPfCHM; //!
+    BranchBuffer<int> fRecoJtPfCEM; //!
+    BranchBuffer<int> fRecoJtPfNHM; //!
+    BranchBuffer<int> fRecoJtPfNEM; //!
+    BranchBuffer<int> fRecoJtPfMUM; //!
 
     /// @brief Transverse momentum of generated jet that was matched with reconstructed jet
-    float fRefJetPt[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRefJetPt; //!
     /// @brief /// @brief Pseudorapidity of generated jet that was matched with reconstructed jet
-    float fRefJetEta[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRefJetEta; //!
     /// @brief Azimuthal angle of generated jet that was matched with reconstructed jet
-    float fRefJetPhi[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRefJetPhi; //!
     /// @brief WTA eta of generated jet that was matched with reconstructed jet
-    float fRefJetWTAEta[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRefJetWTAEta; //!
     /// @brief WTA phi of generated jet that was matched with reconstructed jet
-    float fRefJetWTAPhi[JET_ARRAY_SIZE];
+    BranchBuffer<float> fRefJetWTAPhi; //!
     /// @brief Parton flavor of generated jet that was matched with reconstructed jet
-    int   fRefJetPartonFlavor[JET_ARRAY_SIZE];
+    BranchBuffer<int> fRefJetPartonFlavor; //!
     /// @brief Parton flavor for B of generated jet that was matched with reconstructed jet
-    int   fRefJetPartonFlavorForB[JET_ARRAY_SIZE];
+    BranchBuffer<int> fRefJetPartonFlavorForB; //!
 
     /// @brief Number of generated jets
     int   fNGenJets;
     /// @brief Generated jet transverse momentum
-    float fGenJetPt[JET_ARRAY_SIZE];
+    BranchBuffer<float> fGenJetPt; //!
     /// @brief Pseudorapidity of generated jet
-    float fGenJetEta[JET_ARRAY_SIZE];
+    BranchBuffer<float> fGenJetEta; //!
     /// @brief Azimuthal angle of generated jet
-    float fGenJetPhi[JET_ARRAY_SIZE];
+    BranchBuffer<float> fGenJetPhi; //!
     /// @brief WTA eta of generated jet
-    float fGenJetWTAEta[JET_ARRAY_SIZE];
+    BranchBuffer<float> fGenJetWTAEta; //!
     /// @brief WTA phi of generated jet
-    float fGenJetWTAPhi[JET_ARRAY_SIZE];
+    BranchBuffer<float> fGenJetWTAPhi; //!
 
     //
     // Reconstructed tracks
@@ -367,41 +504,41 @@ class ForestAODReader : public BaseReader {
     /// @brief Number of tracks
     int   fNTracks;
     /// @brief Track transverse momentum
-    float fTrackPt[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackPt; //!
     /// @brief Track pseudorapidity
-    float fTrackEta[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackEta; //!
     /// @brief Track azimuthal angle
-    float fTrackPhi[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackPhi; //!
     /// @brief Track pT error (uncertainty)
-    float fTrackPtErr[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackPtErr; //!
     /// @brief Track distance of closest approach in transverse plane (XY)
-    float fTrackDcaXY[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackDcaXY; //!
     /// @brief Track distance of closest approach in beam direction (z)
-    float fTrackDcaZ[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackDcaZ; //!
     /// @brief Track distance of closest approach error in transverse plane (XY)
-    float fTrackDcaXYErr[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackDcaXYErr; //!
     /// @brief Track distance of closest approach error in beam direction (z)
-    float fTrackDcaZErr[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackDcaZErr; //!
     /// @brief Track fitting (reconstruction) chi2
-    float fTrackChi2[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackChi2; //!
     /// @brief Track number of degrees of freedom in the fitting
-    unsigned char fTrackNDOF[TRACK_ARRAY_SIZE];
+    BranchBuffer<unsigned char> fTrackNDOF; //!
     /// @brief Particle flow energy deposited in ECAL from the given track
-    float fTrackPartFlowEcal[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackPartFlowEcal; //!
     /// @brief Particle flow energy deposited in HCAL from the given track
-    float fTrackPartFlowHcal[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackPartFlowHcal; //!
     /// @brief Track MVA for each step
-    float fTrackMVA[TRACK_ARRAY_SIZE];
+    BranchBuffer<float> fTrackMVA; //!
     /// @brief Track algorithm/step
-    unsigned char fTrackAlgo[TRACK_ARRAY_SIZE];
+    BranchBuffer<unsigned char> fTrackAlgo; //!
     /// @brief Track charge
-    int   fTrackCharge[TRACK_ARRAY_SIZE];
+    BranchBuffer<int> fTrackCharge; //!
     /// @brief Number of hits in the tracker
-    unsigned char fTrackNHits[TRACK_ARRAY_SIZE];
+    BranchBuffer<unsigned char> fTrackNHits; //!
     /// @brief Number of layers with measurement in the tracker
-    unsigned char fTrackNLayers[TRACK_ARRAY_SIZE];
+    BranchBuffer<unsigned char> fTrackNLayers; //!
     /// @brief Tracker steps MVA selection
-    bool  fTrackHighPurity[TRACK_ARRAY_SIZE];
+    BranchBuffer<bool> fTrackHighPurity; //!
 
     //
     // Monte Carlo tracks
@@ -449,6 +586,8 @@ class ForestAODReader : public BaseReader {
     EventCut *fEventCut;
     /// @brief Jet cut
     JetCut *fJetCut;
+    /// @brief Track cut
+    TrackCut *fTrackCut;
 
     /// @brief Vector that contains indices of generated jets that matched to the reconsructed 
     /// particle flow jet (should be of the reco/red size)
@@ -486,6 +625,83 @@ class ForestAODReader : public BaseReader {
     /// @brief  Verbose mode
     bool  fVerbose;
 
+    /// @brief Stage indices in the stage stats
+    int fStageGetEntry;
+    int fStageEventConstruction;
+    int fStageJetCorrections;
+    int fStageJetCut;
+    int fStageEventCut;
+    int fStageClearVariables;
+
+    /// @brief Chains in the order of the I/O statistics
+    enum ChainIndex { kEventChain = 0, kHltChain, kSkimChain, kJetChain, kTrackChain, kGenTrackChain, kNChains };
+    /// @brief Cache settings and I/O statistics of a chain
+    struct ChainIO {
+        /// @brief Name used in the settings and the report
+        std::string name{};
+        /// @brief Chain (nullptr - not read)
+        TChain *chain{nullptr};
+        /// @brief TTreeCache size in bytes
+        Long64_t cacheSize{-1};
+        /// @brief Bytes read from the files
+        Long64_t bytesRead{0};
+        /// @brief Number of read calls
+        Long64_t readCalls{0};
+        /// @brief Bytes read through the cache
+        Long64_t cacheBytesRead{0};
+        /// @brief Bytes read outside the cache (cache misses)
+        Long64_t noCacheBytesRead{0};
+        /// @brief Run and event number branches (empty - tree is not checked)
+        std::string runName{};
+        std::string eventName{};
+        /// @brief Run and event numbers are compared to the event tree
+        bool checkAlignment{false};
+        /// @brief Tree number and enabled branches of the loaded tree (friend chain only)
+        int treeNumber{-1};
+        std::vector<TBranch*> branches{};
+    };
+
+    /// @brief TTreeCache size of all chains (negative - ROOT default)
+    Long64_t fTreeCacheSize;
+    /// @brief TTreeCache size of the chains set separately
+    std::map<std::string, Long64_t> fChainTreeCacheSize; //!
+    /// @brief Number of entries the cache learns branches from (0 - enabled branches are cached)
+    int fTreeCacheLearnEntries;
+    /// @brief Prefetch baskets asynchronously
+    bool fUseAsyncPrefetch;
+    /// @brief Cache settings and I/O statistics of all chains
+    std::vector<ChainIO> fChainIO; //!
+
+    /// @brief Trees are read as friends of the event tree
+    bool fUseFriendChain;
+    /// @brief Jet tree is matched to the event tree by (run, evt)
+    bool fUseEventIndex;
+    /// @brief Alignment check mode: 0 - never, 1 - once per file, 2 - every entry
+    int fAlignmentCheck;
+    /// @brief Tree number of the event chain where trees were last checked
+    int fAlignmentTreeNumber;
+    /// @brief Jet and track trees are checked at the next readObjects()
+    bool fCheckObjectAlignment;
+
+    /// @brief Number of threads validating input files
+    int fNValidationThreads;
+    /// @brief Entry manifest file name (empty - next to the file list)
+    TString fEntryManifest;
+    /// @brief Entry manifest is used
+    bool fUseEntryManifest;
+    /// @brief Files of the input list and their numbers of entries (filled by prepareInput())
+    std::vector< std::pair<std::string, Long64_t> > fInputFileEntries;
+    /// @brief Files of the input list are validated
+    bool fIsInputPrepared;
+
+    /// @brief Additional jet trees
+    std::vector<JetCollectionInput> fJetCollectionInputs; //!
+
+    /// @brief Read RNTuple conversion of the forest instead of the trees
+    bool fUseRNTupleInput;
+    /// @brief RNTuple input
+    ForestRNTupleInput *fRNTupleInput; //!
+
     ClassDef(ForestAODReader, 1)
 };
 
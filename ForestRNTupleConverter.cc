@@ -0,0 +1,355 @@
+/**
+ * @file ForestRNTupleConverter.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Convert event, HLT, skimming and jet trees of the forest into RNTuples
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// JetAnalysis headers
+#include "ForestRNTupleConverter.h"
+#include "ForestRNTupleInput.h"
+#include "TriggerAndSkim.h"
+
+// ROOT headers
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#ifdef JETANALYSIS_RNTUPLE
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#endif
+
+// C++ headers
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+//________________
+ForestRNTupleConverter::ForestRNTupleConverter() : fJetTrees{}, fIsMc{false}, fUseHltTree{true},
+    fUseSkimTree{true}, fCompression{505}, fVerbose{false} {
+    /* empty */
+}
+
+//________________
+void ForestRNTupleConverter::addJetTree(const char *name) {
+    if ( std::find( fJetTrees.begin(), fJetTrees.end(), name ) == fJetTrees.end() ) {
+        fJetTrees.push_back( name );
+    }
+}
+
+//________________
+bool ForestRNTupleConverter::convert(const char *inFileName, const char *outFileName) const {
+#ifdef JETANALYSIS_RNTUPLE
+    std::unique_ptr<TFile> inFile{ TFile::Open( inFileName ) };
+    if ( !inFile || inFile->IsZombie() ) {
+        std::cerr << Form("[ERROR] ForestRNTupleConverter::convert - cannot open %s\n", inFileName);
+        return false;
+    }
+    TTree *eventTree = dynamic_cast<TTree*>( inFile->Get("hiEvtAnalyzer/HiTree") );
+    if ( !eventTree ) {
+        std::cerr << Form("[ERROR] ForestRNTupleConverter::convert - %s has no hiEvtAnalyzer/HiTree\n", inFileName);
+        return false;
+    }
+
+    // Complete file replaces the old one
+    TString tmpName = Form("%s.%d.tmp", outFileName, gSystem->GetPid());
+    std::unique_ptr<TFile> outFile{ TFile::Open( tmpName.Data(), "RECREATE" ) };
+    if ( !outFile || outFile->IsZombie() ) {
+        std::cerr << Form("[ERROR] ForestRNTupleConverter::convert - cannot create %s\n", tmpName.Data());
+        return false;
+    }
+
+    // Trees are converted one after another: each tree is read once
+    std::vector<UInt_t> runs;
+    std::vector<ULong64_t> events;
+    bool isGood = convertEventTree( eventTree, *outFile, runs, events );
+    if ( isGood && fUseHltTree ) {
+        TTree *tree = dynamic_cast<TTree*>( inFile->Get("hltanalysis/HltTree") );
+        isGood = ( tree && convertFlagTree( tree, *outFile, ForestRNTupleInput::kHltNTuple, false, runs, events ) );
+    }
+    if ( isGood && fUseSkimTree ) {
+        TTree *tree = dynamic_cast<TTree*>( inFile->Get("skimanalysis/HltTree") );
+        isGood = ( tree && convertFlagTree( tree, *outFile, ForestRNTupleInput::kSkimNTuple, true, runs, events ) );
+    }
+    const std::vector<std::string> jetTrees = ( fJetTrees.empty() ) ?
+        std::vector<std::string>{ "akCs4PFJetAnalyzer" } : fJetTrees;
+    for (const auto& name : jetTrees) {
+        if ( !isGood ) break;
+        TTree *tree = dynamic_cast<TTree*>( inFile->Get( Form("%s/t", name.c_str()) ) );
+        if ( !tree ) {
+            std::cerr << Form("[ERROR] ForestRNTupleConverter::convert - %s has no %s/t\n", inFileName, name.c_str());
+            isGood = false;
+            break;
+        }
+        isGood = convertJetTree( tree, *outFile, name.c_str(), runs, events );
+    }
+    outFile->Close();
+
+    if ( !isGood || gSystem->Rename( tmpName.Data(), outFileName ) != 0 ) {
+        std::cerr << Form("[ERROR] ForestRNTupleConverter::convert - %s is not converted\n", inFileName);
+        gSystem->Unlink( tmpName.Data() );
+        return false;
+    }
+    std::cout << Form("%s -> %s: %zu entries\n", inFileName, outFileName, runs.size());
+    return true;
+#else
+    (void)outFileName;
+    std::cerr << Form("[ERROR] ForestRNTupleConverter::convert - RNTuple support is not compiled in. Cannot convert %s\n", inFileName);
+    return false;
+#endif
+}
+
+//________________
+bool ForestRNTupleConverter::convertEventTree(TTree *tree, TDirectory& out, std::vector<UInt_t>& runs,
+                                              std::vector<ULong64_t>& events) const {
+#ifdef JETANALYSIS_RNTUPLE
+    // Branch types follow ForestAODReader
+    UInt_t run{0}, lumi{0};
+    ULong64_t event{0};
+    Float_t vz{0}, weight{0}, ptHat{0};
+    Int_t hiBin{0};
+
+    tree->SetBranchStatus("*", 0);
+    auto model = ROOT::RNTupleModel::Create();
+    std::vector< std::pair<std::shared_ptr<std::uint32_t>, UInt_t*> > uints;
+    std::vector< std::pair<std::shared_ptr<float>, Float_t*> > floats;
+    std::shared_ptr<std::uint64_t> eventField{};
+    std::shared_ptr<std::int32_t> hiBinField{};
+    auto enable = [&tree](const char *name, void *address) {
+        if ( !tree->GetBranch( name ) ) return false;
+        tree->SetBranchStatus( name, 1 );
+        tree->SetBranchAddress( name, address );
+        return true;
+    };
+    if ( enable( "run", &run ) ) uints.emplace_back( model->MakeField<std::uint32_t>("run"), &run );
+    if ( enable( "lumi", &lumi ) ) uints.emplace_back( model->MakeField<std::uint32_t>("lumi"), &lumi );
+    if ( enable( "evt", &event ) ) eventField = model->MakeField<std::uint64_t>("evt");
+    if ( enable( "vz", &vz ) ) floats.emplace_back( model->MakeField<float>("vz"), &vz );
+    if ( enable( "hiBin", &hiBin ) ) hiBinField = model->MakeField<std::int32_t>("hiBin");
+    if ( fIsMc ) {
+        if ( enable( "weight", &weight ) ) floats.emplace_back( model->MakeField<float>("weight"), &weight );
+        if ( enable( "pthat", &ptHat ) ) floats.emplace_back( model->MakeField<float>("pthat"), &ptHat );
+    }
+
+    ROOT::RNTupleWriteOptions options;
+    options.SetCompression( fCompression );
+    auto writer = ROOT::RNTupleWriter::Append( std::move( model ), ForestRNTupleInput::kEventNTuple, out, options );
+
+    const Long64_t nEntries = tree->GetEntries();
+    runs.assign( nEntries, 0 );
+    events.assign( nEntries, 0 );
+    for (Long64_t iEntry{0}; iEntry<nEntries; iEntry++) {
+        if ( tree->GetEntry( iEntry ) <= 0 ) {
+            std::cerr << Form("[ERROR] ForestRNTupleConverter::convertEventTree - cannot read entry %lld\n", iEntry);
+            return false;
+        }
+        for (auto& field : uints) *field.first = *field.second;
+        for (auto& field : floats) *field.first = *field.second;
+        if ( eventField ) *eventField = event;
+        if ( hiBinField ) *hiBinField = hiBin;
+        writer->Fill();
+        runs.at(iEntry) = run;
+        events.at(iEntry) = event;
+    }
+    return true;
+#else
+    (void)tree; (void)out; (void)runs; (void)events;
+    return false;
+#endif
+}
+
+//________________
+bool ForestRNTupleConverter::convertFlagTree(TTree *tree, TDirectory& out, const char *ntupleName, const bool& isSkim,
+                                             const std::vector<UInt_t>& runs, const std::vector<ULong64_t>& events) const {
+#ifdef JETANALYSIS_RNTUPLE
+    if ( tree->GetEntries() != static_cast<Long64_t>( runs.size() ) ) {
+        std::cerr << Form("[ERROR] ForestRNTupleConverter::convertFlagTree - %s tree has %lld entries while the event tree has %zu\n",
+                          ntupleName, tree->GetEntries(), runs.size());
+        return false;
+    }
+
+    // Only flags of the registry are read by ForestAODReader
+    tree->SetBranchStatus("*", 0);
+    auto model = ROOT::RNTupleModel::Create();
+    std::vector<Int_t> values( TriggerAndSkim::kNFlags, 0 );
+    std::vector< std::pair<std::shared_ptr<std::int32_t>, int> > fields;
+    for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+        if ( TriggerAndSkim::isSkimFilter( iFlag ) != isSkim ) continue;
+        const char *name = TriggerAndSkim::flagName( iFlag );
+        if ( !tree->GetBranch( name ) ) continue;
+        tree->SetBranchStatus( name, 1 );
+        tree->SetBranchAddress( name, &values.at(iFlag) );
+        fields.emplace_back( model->MakeField<std::int32_t>( name ), iFlag );
+    }
+    // Run and event numbers are read for the alignment check only
+    const char *runName = ( isSkim ) ? "" : "Run";
+    const char *eventName = ( isSkim ) ? "" : "Event";
+    const bool checkAlignment = ( !isSkim && tree->GetBranch( runName ) && tree->GetBranch( eventName ) );
+    if ( checkAlignment ) {
+        tree->SetBranchStatus( runName, 1 );
+        tree->SetBranchStatus( eventName, 1 );
+    }
+
+    ROOT::RNTupleWriteOptions options;
+    options.SetCompression( fCompression );
+    auto writer = ROOT::RNTupleWriter::Append( std::move( model ), ntupleName, out, options );
+    for (Long64_t iEntry{0}; iEntry<tree->GetEntries(); iEntry++) {
+        std::fill( values.begin(), values.end(), 0 );
+        tree->GetEntry( iEntry );
+        if ( checkAlignment && !isAligned( tree, runName, eventName, iEntry, runs, events ) ) return false;
+        for (auto& field : fields) *field.first = values.at( field.second );
+        writer->Fill();
+    }
+    if ( fVerbose ) {
+        std::cout << Form("%s: %zu flags converted\n", ntupleName, fields.size());
+    }
+    return true;
+#else
+    (void)tree; (void)out; (void)ntupleName; (void)isSkim; (void)runs; (void)events;
+    return false;
+#endif
+}
+
+//________________
+bool ForestRNTupleConverter::convertJetTree(TTree *tree, TDirectory& out, const char *ntupleName,
+                                            const std::vector<UInt_t>& runs, const std::vector<ULong64_t>& events) const {
+#ifdef JETANALYSIS_RNTUPLE
+    if ( tree->GetEntries() != static_cast<Long64_t>( runs.size() ) ) {
+        std::cerr << Form("[ERROR] ForestRNTupleConverter::convertJetTree - %s tree has %lld entries while the event tree has %zu\n",
+                          ntupleName, tree->GetEntries(), runs.size());
+        return false;
+    }
+
+    // Branches read by ForestAODReader
+    std::vector<ArrayColumn> columns{
+        {"rawpt", "nref", false}, {"jteta", "nref", false}, {"jtphi", "nref", false},
+        {"trackMax", "nref", false}, {"WTAeta", "nref", false}, {"WTAphi", "nref", false},
+        {"jtPfNHF", "nref", false}, {"jtPfNEF", "nref", false}, {"jtPfCHF", "nref", false},
+        {"jtPfMUF", "nref", false}, {"jtPfCEF", "nref", false},
+        {"jtPfCHM", "nref", true}, {"jtPfCEM", "nref", true}, {"jtPfNHM", "nref", true},
+        {"jtPfNEM", "nref", true}, {"jtPfMUM", "nref", true} };
+    std::vector<std::string> counters{ "nref" };
+    if ( fIsMc ) {
+        std::vector<ArrayColumn> mcColumns{
+            {"genpt", "ngen", false}, {"geneta", "ngen", false}, {"genphi", "ngen", false},
+            {"WTAgeneta", "ngen", false}, {"WTAgenphi", "ngen", false},
+            {"refpt", "nref", false}, {"refeta", "nref", false}, {"refphi", "nref", false},
+            {"refWTAeta", "nref", false}, {"refWTAphi", "nref", false},
+            {"refparton_flavor", "nref", true}, {"refparton_flavorForB", "nref", true} };
+        columns.insert( columns.end(), mcColumns.begin(), mcColumns.end() );
+        counters.push_back( "ngen" );
+    }
+
+    tree->SetBranchStatus("*", 0);
+    auto model = ROOT::RNTupleModel::Create();
+
+    // Counters are stored as well: ForestAODReader reads them as in the forest
+    std::vector<Int_t> counterValues( counters.size(), 0 );
+    std::vector< std::shared_ptr<std::int32_t> > counterFields( counters.size() );
+    size_t bufferSize{1};
+    for (size_t iCounter{0}; iCounter<counters.size(); iCounter++) {
+        const char *name = counters.at(iCounter).c_str();
+        if ( !tree->GetBranch( name ) ) {
+            std::cerr << Form("[ERROR] ForestRNTupleConverter::convertJetTree - %s tree has no %s branch\n", ntupleName, name);
+            return false;
+        }
+        tree->SetBranchStatus( name, 1 );
+        tree->SetBranchAddress( name, &counterValues.at(iCounter) );
+        counterFields.at(iCounter) = model->MakeField<std::int32_t>( name );
+        bufferSize = std::max( bufferSize, static_cast<size_t>( std::max( tree->GetMaximum( name ), 0. ) ) );
+    }
+
+    std::vector< std::vector<Float_t> > floatBuffers;
+    std::vector< std::vector<Int_t> > intBuffers;
+    floatBuffers.reserve( columns.size() );
+    intBuffers.reserve( columns.size() );
+    std::vector< std::pair<std::shared_ptr< std::vector<float> >, size_t> > floatFields;
+    std::vector< std::pair<std::shared_ptr< std::vector<std::int32_t> >, size_t> > intFields;
+    std::vector<size_t> floatCounters, intCounters;
+    for (const auto& column : columns) {
+        if ( !tree->GetBranch( column.name.c_str() ) ) continue;
+        tree->SetBranchStatus( column.name.c_str(), 1 );
+        const size_t iCounter = std::find( counters.begin(), counters.end(), column.counter ) - counters.begin();
+        if ( column.isInt ) {
+            intBuffers.emplace_back( bufferSize, 0 );
+            tree->SetBranchAddress( column.name.c_str(), intBuffers.back().data() );
+            intFields.emplace_back( model->MakeField< std::vector<std::int32_t> >( column.name ), intBuffers.size() - 1 );
+            intCounters.push_back( iCounter );
+        }
+        else {
+            floatBuffers.emplace_back( bufferSize, 0.f );
+            tree->SetBranchAddress( column.name.c_str(), floatBuffers.back().data() );
+            floatFields.emplace_back( model->MakeField< std::vector<float> >( column.name ), floatBuffers.size() - 1 );
+            floatCounters.push_back( iCounter );
+        }
+    }
+    const bool checkAlignment = ( tree->GetBranch("run") && tree->GetBranch("evt") );
+    if ( checkAlignment ) {
+        tree->SetBranchStatus( "run", 1 );
+        tree->SetBranchStatus( "evt", 1 );
+    }
+
+    ROOT::RNTupleWriteOptions options;
+    options.SetCompression( fCompression );
+    auto writer = ROOT::RNTupleWriter::Append( std::move( model ), ntupleName, out, options );
+    for (Long64_t iEntry{0}; iEntry<tree->GetEntries(); iEntry++) {
+        std::fill( counterValues.begin(), counterValues.end(), 0 );
+        tree->GetEntry( iEntry );
+        if ( checkAlignment && !isAligned( tree, "run", "evt", iEntry, runs, events ) ) return false;
+
+        // Counters above the maximum stored in the file mean the arrays were written past the buffers
+        for (size_t iCounter{0}; iCounter<counters.size(); iCounter++) {
+            if ( counterValues.at(iCounter) < 0 || static_cast<size_t>( counterValues.at(iCounter) ) > bufferSize ) {
+                std::cerr << Form("[ERROR] ForestRNTupleConverter::convertJetTree - entry %lld: %s = %d exceeds buffer size %zu\n",
+                                  iEntry, counters.at(iCounter).c_str(), counterValues.at(iCounter), bufferSize);
+                return false;
+            }
+            *counterFields.at(iCounter) = counterValues.at(iCounter);
+        }
+        for (size_t iField{0}; iField<floatFields.size(); iField++) {
+            const std::vector<Float_t> &buffer = floatBuffers.at( floatFields.at(iField).second );
+            floatFields.at(iField).first->assign( buffer.begin(), buffer.begin() + counterValues.at( floatCounters.at(iField) ) );
+        }
+        for (size_t iField{0}; iField<intFields.size(); iField++) {
+            const std::vector<Int_t> &buffer = intBuffers.at( intFields.at(iField).second );
+            intFields.at(iField).first->assign( buffer.begin(), buffer.begin() + counterValues.at( intCounters.at(iField) ) );
+        }
+        writer->Fill();
+    }
+    if ( fVerbose ) {
+        std::cout << Form("%s: %zu arrays converted, up to %zu jets\n", ntupleName, floatFields.size() + intFields.size(), bufferSize);
+    }
+    return true;
+#else
+    (void)tree; (void)out; (void)ntupleName; (void)runs; (void)events;
+    return false;
+#endif
+}
+
+//________________
+bool ForestRNTupleConverter::isAligned(TTree *tree, const char *runName, const char *eventName, const Long64_t& entry,
+                                       const std::vector<UInt_t>& runs, const std::vector<ULong64_t>& events) const {
+    TLeaf *runLeaf = tree->GetLeaf( runName );
+    TLeaf *eventLeaf = tree->GetLeaf( eventName );
+    if ( !runLeaf || !eventLeaf ) return true;
+
+    // Some trees store the event number as a 32-bit integer
+    const ULong64_t eventMask = ( eventLeaf->GetLenType() < 8 ) ? 0xFFFFFFFFull : ~0ull;
+    const ULong64_t run = static_cast<ULong64_t>( runLeaf->GetValueLong64() );
+    const ULong64_t event = static_cast<ULong64_t>( eventLeaf->GetValueLong64() );
+    if ( run != runs.at(entry) || ( event & eventMask ) != ( events.at(entry) & eventMask ) ) {
+        std::cerr << Form("[ERROR] ForestRNTupleConverter::isAligned - entry %lld: %s tree has run/event %llu/%llu, event tree has %u/%llu\n",
+                          entry, tree->GetName(), run, event, runs.at(entry), events.at(entry));
+        return false;
+    }
+    return true;
+}
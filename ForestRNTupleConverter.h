@@ -0,0 +1,87 @@
+/**
+ * @file ForestRNTupleConverter.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Convert event, HLT, skimming and jet trees of the forest into RNTuples
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef ForestRNTupleConverter_h
+#define ForestRNTupleConverter_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <string>
+#include <vector>
+
+// Forward declarations
+class TDirectory;
+class TTree;
+
+//________________
+class ForestRNTupleConverter {
+  public:
+    /// @brief Constructor
+    ForestRNTupleConverter();
+    /// @brief Destructor
+    virtual ~ForestRNTupleConverter() { /* empty */ }
+
+    /// @brief Add jet tree to convert (e.g. akCs4PFJetAnalyzer). Default: akCs4PFJetAnalyzer
+    void addJetTree(const char *name);
+    /// @brief Convert generator-level quantities (MC)
+    void setIsMc(const bool& isMc = true) { fIsMc = isMc; }
+    /// @brief Convert HLT tree (triggers of the TriggerAndSkim registry)
+    void useHltTree(const bool& use = true)  { fUseHltTree = use; }
+    /// @brief Convert skimming tree (filters of the TriggerAndSkim registry)
+    void useSkimTree(const bool& use = true) { fUseSkimTree = use; }
+    /// @brief Set compression settings (algorithm * 100 + level, e.g. 505 - ZSTD level 5)
+    void setCompression(const int& settings = 505) { fCompression = settings; }
+    /// @brief Set verbose mode
+    void setVerbose() { fVerbose = true; }
+
+    /// @brief Convert forest file into a file with RNTuples named after the tree directories.
+    /// Run and event numbers of the HLT and jet trees are compared to the event tree
+    /// @return true if all trees were converted
+    bool convert(const char *inFileName, const char *outFileName) const;
+
+  private:
+    /// @brief Column converted from a variable-length array branch
+    struct ArrayColumn {
+        std::string name;
+        std::string counter;
+        bool isInt;
+    };
+
+    /// @brief Convert event tree. Run and event numbers of all entries are returned
+    bool convertEventTree(TTree *tree, TDirectory& out, std::vector<UInt_t>& runs,
+                          std::vector<ULong64_t>& events) const;
+    /// @brief Convert HLT or skimming tree (integer flags of the registry)
+    bool convertFlagTree(TTree *tree, TDirectory& out, const char *ntupleName, const bool& isSkim,
+                         const std::vector<UInt_t>& runs, const std::vector<ULong64_t>& events) const;
+    /// @brief Convert jet tree
+    bool convertJetTree(TTree *tree, TDirectory& out, const char *ntupleName,
+                        const std::vector<UInt_t>& runs, const std::vector<ULong64_t>& events) const;
+    /// @brief Compare run and event numbers of the entry to the event tree
+    bool isAligned(TTree *tree, const char *runName, const char *eventName, const Long64_t& entry,
+                   const std::vector<UInt_t>& runs, const std::vector<ULong64_t>& events) const;
+
+    /// @brief Jet trees to convert
+    std::vector<std::string> fJetTrees;
+    /// @brief Convert generator-level quantities
+    bool fIsMc;
+    /// @brief Convert HLT tree
+    bool fUseHltTree;
+    /// @brief Convert skimming tree
+    bool fUseSkimTree;
+    /// @brief Compression settings of the RNTuples
+    int fCompression;
+    /// @brief Verbose mode
+    bool fVerbose;
+};
+
+#endif // #define ForestRNTupleConverter_h
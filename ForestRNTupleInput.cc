@@ -0,0 +1,350 @@
+/**
+ * @file ForestRNTupleInput.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief RNTuple conversion of the forest read into the reader buffers
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// JetAnalysis headers
+#include "ForestRNTupleInput.h"
+
+// ROOT headers
+#include "TString.h"
+#ifdef JETANALYSIS_RNTUPLE
+#include <ROOT/RError.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleView.hxx>
+#endif
+
+// C++ headers
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+//________________
+const char *ForestRNTupleInput::kEventNTuple = "hiEvtAnalyzer";
+const char *ForestRNTupleInput::kHltNTuple = "hltanalysis";
+const char *ForestRNTupleInput::kSkimNTuple = "skimanalysis";
+
+namespace {
+    /// @brief Types of the fields
+    enum FieldType { kUInt = 0, kULong64, kInt, kFloat, kFloatArray, kIntArray };
+}
+
+//________________
+struct ForestRNTupleInput::NTupleInput {
+    /// @brief Field read into an address
+    struct Field {
+        std::string name{};
+        int type{kFloat};
+        void *address{nullptr};
+        /// @brief Read value of the entry (arrays: keep it in the view) and return the array length
+        std::function<size_t(const Long64_t&)> load{};
+        /// @brief Copy array of the loaded entry into the buffer
+        std::function<void()> copy{};
+    };
+#ifdef JETANALYSIS_RNTUPLE
+    /// @brief Reader of the open file (declared first: views of the fields are destroyed before it)
+    std::unique_ptr<ROOT::RNTupleReader> reader{};
+#endif
+    /// @brief RNTuple name
+    std::string name{};
+    /// @brief Fields with addresses
+    std::vector<Field> fields{};
+    /// @brief Buffer growth function
+    std::function<size_t(const size_t&)> grow{};
+    /// @brief Length of the buffers
+    size_t bufferSize{0};
+    /// @brief Index of the open file (-1 - none)
+    int fileIndex{-1};
+    /// @brief Number of entries read
+    Long64_t entriesRead{0};
+};
+
+//________________
+ForestRNTupleInput::ForestRNTupleInput() : fFiles{}, fOffsets{0}, fNTuples{} {
+    /* empty */
+}
+
+//________________
+ForestRNTupleInput::~ForestRNTupleInput() {
+    /* empty */
+}
+
+//________________
+bool ForestRNTupleInput::isAvailable() {
+#ifdef JETANALYSIS_RNTUPLE
+    return true;
+#else
+    return false;
+#endif
+}
+
+//________________
+bool ForestRNTupleInput::addFile(const std::string& name) {
+#ifdef JETANALYSIS_RNTUPLE
+    Long64_t entries{-1};
+    try {
+        auto reader = ROOT::RNTupleReader::Open( kEventNTuple, name );
+        entries = static_cast<Long64_t>( reader->GetNEntries() );
+    }
+    catch (const ROOT::RException&) {
+        std::cout << Form("[WARNING] ForestRNTupleInput::addFile - cannot read %s RNTuple of %s. File is skipped\n",
+                          kEventNTuple, name.c_str());
+        return false;
+    }
+    if ( entries <= 0 ) return false;
+    fFiles.push_back( name );
+    fOffsets.push_back( fOffsets.back() + entries );
+    return true;
+#else
+    std::cerr << Form("[ERROR] ForestRNTupleInput::addFile - RNTuple support is not compiled in. Cannot read %s\n", name.c_str());
+    return false;
+#endif
+}
+
+//________________
+bool ForestRNTupleInput::hasNTuple(const std::string& ntuple) const {
+#ifdef JETANALYSIS_RNTUPLE
+    if ( fFiles.empty() ) return false;
+    try {
+        ROOT::RNTupleReader::Open( ntuple, fFiles.front() );
+    }
+    catch (const ROOT::RException&) {
+        return false;
+    }
+    return true;
+#else
+    (void)ntuple;
+    return false;
+#endif
+}
+
+//________________
+ForestRNTupleInput::NTupleInput& ForestRNTupleInput::ntupleInput(const std::string& ntuple) {
+    for (auto& input : fNTuples) {
+        if ( input->name == ntuple ) return *input;
+    }
+    fNTuples.emplace_back( new NTupleInput{} );
+    fNTuples.back()->name = ntuple;
+    return *fNTuples.back();
+}
+
+//________________
+void ForestRNTupleInput::addField(const std::string& ntuple, const std::string& field, const int& type, void *address) {
+    NTupleInput &input = ntupleInput( ntuple );
+    for (auto& existing : input.fields) {
+        if ( existing.name == field ) {
+            existing.type = type;
+            existing.address = address;
+            // Views are created again with the new address
+            input.fileIndex = -1;
+            return;
+        }
+    }
+    NTupleInput::Field newField;
+    newField.name = field;
+    newField.type = type;
+    newField.address = address;
+    input.fields.push_back( std::move( newField ) );
+    input.fileIndex = -1;
+}
+
+//________________
+void ForestRNTupleInput::setFieldAddress(const std::string& ntuple, const std::string& field, UInt_t *address) {
+    addField( ntuple, field, kUInt, address );
+}
+
+//________________
+void ForestRNTupleInput::setFieldAddress(const std::string& ntuple, const std::string& field, ULong64_t *address) {
+    addField( ntuple, field, kULong64, address );
+}
+
+//________________
+void ForestRNTupleInput::setFieldAddress(const std::string& ntuple, const std::string& field, Int_t *address) {
+    addField( ntuple, field, kInt, address );
+}
+
+//________________
+void ForestRNTupleInput::setFieldAddress(const std::string& ntuple, const std::string& field, Float_t *address) {
+    addField( ntuple, field, kFloat, address );
+}
+
+//________________
+void ForestRNTupleInput::setFieldAddress(const std::string& ntuple, const std::string& field, BranchBuffer<Float_t> *buffer) {
+    addField( ntuple, field, kFloatArray, buffer );
+}
+
+//________________
+void ForestRNTupleInput::setFieldAddress(const std::string& ntuple, const std::string& field, BranchBuffer<Int_t> *buffer) {
+    addField( ntuple, field, kIntArray, buffer );
+}
+
+//________________
+void ForestRNTupleInput::setBufferGrowth(const std::string& ntuple, std::function<size_t(const size_t&)> grow) {
+    ntupleInput( ntuple ).grow = grow;
+}
+
+//________________
+bool ForestRNTupleInput::isFieldRead(const std::string& ntuple, const std::string& field) const {
+    for (const auto& input : fNTuples) {
+        if ( input->name != ntuple ) continue;
+        for (const auto& existing : input->fields) {
+            if ( existing.name == field ) return true;
+        }
+    }
+    return false;
+}
+
+//________________
+void ForestRNTupleInput::openFile(NTupleInput& input, const Long64_t& entry) {
+#ifdef JETANALYSIS_RNTUPLE
+    auto file = std::upper_bound( fOffsets.begin(), fOffsets.end(), entry );
+    const int fileIndex = static_cast<int>( file - fOffsets.begin() ) - 1;
+    if ( fileIndex < 0 || fileIndex >= static_cast<int>( fFiles.size() ) ) {
+        std::cerr << Form("[ERROR] ForestRNTupleInput::openFile - entry %lld is out of the input. Terminating\n", entry);
+        exit(1);
+    }
+    // Views of the previous file are released before its reader
+    for (auto& field : input.fields) {
+        field.load = nullptr;
+        field.copy = nullptr;
+    }
+    try {
+        input.reader = ROOT::RNTupleReader::Open( input.name, fFiles.at(fileIndex) );
+    }
+    catch (const ROOT::RException&) {
+        std::cerr << Form("[ERROR] ForestRNTupleInput::openFile - cannot read %s RNTuple of %s. Terminating\n",
+                          input.name.c_str(), fFiles.at(fileIndex).c_str());
+        exit(1);
+    }
+    input.fileIndex = fileIndex;
+
+    // Only fields with addresses are read: their columns are the only ones decompressed
+    ROOT::RNTupleReader &reader = *input.reader;
+    for (auto& field : input.fields) {
+        if ( reader.GetDescriptor().FindFieldId( field.name ) == ROOT::kInvalidDescriptorId ) continue;
+
+        switch ( field.type ) {
+            case kUInt: {
+                auto view = std::make_shared< ROOT::RNTupleView<UInt_t> >( reader.GetView<UInt_t>( field.name ) );
+                UInt_t *address = static_cast<UInt_t*>( field.address );
+                field.load = [view, address](const Long64_t& i) { *address = (*view)( i ); return size_t{0}; };
+                break;
+            }
+            case kULong64: {
+                // Stored as std::uint64_t: ULong64_t is a different type on LP64 platforms
+                auto view = std::make_shared< ROOT::RNTupleView<std::uint64_t> >( reader.GetView<std::uint64_t>( field.name ) );
+                ULong64_t *address = static_cast<ULong64_t*>( field.address );
+                field.load = [view, address](const Long64_t& i) { *address = (*view)( i ); return size_t{0}; };
+                break;
+            }
+            case kInt: {
+                auto view = std::make_shared< ROOT::RNTupleView<Int_t> >( reader.GetView<Int_t>( field.name ) );
+                Int_t *address = static_cast<Int_t*>( field.address );
+                field.load = [view, address](const Long64_t& i) { *address = (*view)( i ); return size_t{0}; };
+                break;
+            }
+            case kFloat: {
+                auto view = std::make_shared< ROOT::RNTupleView<Float_t> >( reader.GetView<Float_t>( field.name ) );
+                Float_t *address = static_cast<Float_t*>( field.address );
+                field.load = [view, address](const Long64_t& i) { *address = (*view)( i ); return size_t{0}; };
+                break;
+            }
+            case kFloatArray: {
+                auto view = std::make_shared< ROOT::RNTupleView< std::vector<Float_t> > >( reader.GetView< std::vector<Float_t> >( field.name ) );
+                auto values = std::make_shared< const std::vector<Float_t>* >( nullptr );
+                BranchBuffer<Float_t> *buffer = static_cast< BranchBuffer<Float_t>* >( field.address );
+                field.load = [view, values](const Long64_t& i) { *values = &(*view)( i ); return (*values)->size(); };
+                field.copy = [values, buffer]() { std::copy( (*values)->begin(), (*values)->end(), buffer->data() ); };
+                break;
+            }
+            case kIntArray: {
+                auto view = std::make_shared< ROOT::RNTupleView< std::vector<Int_t> > >( reader.GetView< std::vector<Int_t> >( field.name ) );
+                auto values = std::make_shared< const std::vector<Int_t>* >( nullptr );
+                BranchBuffer<Int_t> *buffer = static_cast< BranchBuffer<Int_t>* >( field.address );
+                field.load = [view, values](const Long64_t& i) { *values = &(*view)( i ); return (*values)->size(); };
+                field.copy = [values, buffer]() { std::copy( (*values)->begin(), (*values)->end(), buffer->data() ); };
+                break;
+            }
+            default:
+                break;
+        }
+    }
+#else
+    (void)input;
+    std::cerr << Form("[ERROR] ForestRNTupleInput::openFile - RNTuple support is not compiled in. Cannot read entry %lld. Terminating\n", entry);
+    exit(1);
+#endif
+}
+
+//________________
+void ForestRNTupleInput::readEntry(const std::string& ntuple, const Long64_t& entry) {
+    NTupleInput &input = ntupleInput( ntuple );
+    // RNTuples without addresses are not opened
+    if ( input.fields.empty() ) return;
+    if ( input.fileIndex < 0 || entry < fOffsets.at(input.fileIndex) || entry >= fOffsets.at(input.fileIndex + 1) ) {
+        openFile( input, entry );
+    }
+    const Long64_t localEntry = entry - fOffsets.at(input.fileIndex);
+
+    // Arrays are copied only after the buffers fit the longest one
+    size_t maxLength{0};
+    for (auto& field : input.fields) {
+        if ( field.load ) maxLength = std::max( maxLength, field.load( localEntry ) );
+    }
+    if ( maxLength > input.bufferSize ) {
+        if ( !input.grow ) {
+            std::cerr << Form("[ERROR] ForestRNTupleInput::readEntry - entry %lld: %zu elements do not fit buffers of %s RNTuple. Terminating\n",
+                              entry, maxLength, ntuple.c_str());
+            exit(1);
+        }
+        input.bufferSize = input.grow( maxLength );
+    }
+    for (auto& field : input.fields) {
+        if ( field.copy ) field.copy();
+    }
+    input.entriesRead++;
+}
+
+//________________
+void ForestRNTupleInput::clusterEnds(const std::string& ntuple, const Long64_t& first, const Long64_t& last,
+                                     std::vector<Long64_t>& ends) const {
+#ifdef JETANALYSIS_RNTUPLE
+    for (size_t iFile{0}; iFile<fFiles.size(); iFile++) {
+        const Long64_t offset = fOffsets.at(iFile);
+        if ( fOffsets.at(iFile + 1) <= first || offset >= last ) continue;
+        auto reader = ROOT::RNTupleReader::Open( ntuple, fFiles.at(iFile) );
+        for (const auto& cluster : reader->GetDescriptor().GetClusterIterable()) {
+            const Long64_t clusterFirst = offset + static_cast<Long64_t>( cluster.GetFirstEntryIndex() );
+            const Long64_t clusterEnd = clusterFirst + static_cast<Long64_t>( cluster.GetNEntries() );
+            if ( clusterEnd <= first || clusterFirst >= last ) continue;
+            ends.push_back( std::min( clusterEnd, last ) );
+        }
+    }
+    // Cluster descriptors are not ordered by entry
+    std::sort( ends.begin(), ends.end() );
+#else
+    (void)ntuple;
+    ends.push_back( std::max( first, last ) );
+#endif
+}
+
+//________________
+void ForestRNTupleInput::report() const {
+    std::cout << Form("RNTuple input: %zu files, %lld entries\n", fFiles.size(), nEntries());
+    for (const auto& input : fNTuples) {
+        int nFields{0};
+        for (const auto& field : input->fields) {
+            if ( field.load ) nFields++;
+        }
+        std::cout << Form("  %-20s fields read: %2d of %2zu requested, entries read: %lld\n",
+                          input->name.c_str(), nFields, input->fields.size(), input->entriesRead);
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file ForestRNTupleInput.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief RNTuple conversion of the forest read into the reader buffers
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef ForestRNTupleInput_h
+#define ForestRNTupleInput_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// JetAnalysis headers
+#include "BranchBuffer.h"
+
+// C++ headers
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//________________
+class ForestRNTupleInput {
+  public:
+    /// @brief Names of the RNTuples made from the event, HLT and skimming trees.
+    /// Jet trees are stored in RNTuples named after the tree directory (e.g. akCs4PFJetAnalyzer)
+    static const char *kEventNTuple;
+    static const char *kHltNTuple;
+    static const char *kSkimNTuple;
+
+    /// @brief Constructor
+    ForestRNTupleInput();
+    /// @brief Destructor
+    virtual ~ForestRNTupleInput();
+
+    /// @brief RNTuple support is compiled in (ROOT 6.36 and newer)
+    static bool isAvailable();
+
+    /// @brief Add converted forest file. Entries are counted from the event RNTuple
+    /// @return false if the file has no event RNTuple (file is skipped)
+    bool addFile(const std::string& name);
+    /// @brief Return files added
+    const std::vector<std::string>& files() const { return fFiles; }
+    /// @brief Return number of entries in all files
+    Long64_t nEntries() const { return fOffsets.back(); }
+    /// @brief RNTuple is in the first file
+    bool hasNTuple(const std::string& ntuple) const;
+
+    /// @brief Read the field into the address at every readEntry() of the RNTuple.
+    /// Fields missing in a file are not read (the value is kept)
+    void setFieldAddress(const std::string& ntuple, const std::string& field, UInt_t *address);
+    void setFieldAddress(const std::string& ntuple, const std::string& field, ULong64_t *address);
+    void setFieldAddress(const std::string& ntuple, const std::string& field, Int_t *address);
+    void setFieldAddress(const std::string& ntuple, const std::string& field, Float_t *address);
+    /// @brief Read the vector field into the buffer
+    void setFieldAddress(const std::string& ntuple, const std::string& field, BranchBuffer<Float_t> *buffer);
+    void setFieldAddress(const std::string& ntuple, const std::string& field, BranchBuffer<Int_t> *buffer);
+    /// @brief Set function that grows the buffers of the RNTuple. Called with the length of the
+    /// longest array of the entry when it does not fit into the buffers, before the arrays are
+    /// copied. Returns the new buffer length
+    void setBufferGrowth(const std::string& ntuple, std::function<size_t(const size_t&)> grow);
+    /// @brief Field of the RNTuple has an address
+    bool isFieldRead(const std::string& ntuple, const std::string& field) const;
+
+    /// @brief Read entry of the RNTuple into the addresses
+    void readEntry(const std::string& ntuple, const Long64_t& entry);
+
+    /// @brief Add last entries (excluded) of the clusters of the RNTuple that overlap [first, last).
+    /// Opens every file of the range
+    void clusterEnds(const std::string& ntuple, const Long64_t& first, const Long64_t& last,
+                     std::vector<Long64_t>& ends) const;
+
+    /// @brief Print files, entries and fields read
+    void report() const;
+
+  private:
+    /// @brief Fields of a single RNTuple and the reader of its current file
+    struct NTupleInput;
+
+    /// @brief Return input of the RNTuple (created if missing)
+    NTupleInput& ntupleInput(const std::string& ntuple);
+    /// @brief Add field of the given type
+    void addField(const std::string& ntuple, const std::string& field, const int& type, void *address);
+    /// @brief Open file of the entry and create views of the fields
+    void openFile(NTupleInput& input, const Long64_t& entry);
+
+    /// @brief Input files
+    std::vector<std::string> fFiles;
+    /// @brief First entry of each file and the total number of entries (last element)
+    std::vector<Long64_t> fOffsets;
+    /// @brief RNTuples read
+    std::vector< std::unique_ptr<NTupleInput> > fNTuples;
+};
+
+#endif // #define ForestRNTupleInput_h
@@ -0,0 +1,479 @@
+/**
+ * @file ForestSkimmer.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Skim forest files: event selection, branch selection and recompression
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "ForestSkimmer.h"
+#include "Event.h"
+#include "TriggerAndSkim.h"
+
+// ROOT headers
+#include "Compression.h"
+#include "TBranch.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+// C++ headers
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+//________________
+ForestSkimmer::ForestSkimmer() : fTrees{}, fBranchPatterns{}, fEventCut{nullptr},
+    fLeadingJetPt{-1.}, fLeadingJetTree{}, fLeadingJetPtBranch{"jtpt"}, fIsMc{false},
+    fCompression{505}, fBasketSize{0}, fVerbose{false} {
+    /* empty */
+}
+
+//________________
+ForestSkimmer::~ForestSkimmer() {
+    if ( fEventCut ) delete fEventCut;
+}
+
+//________________
+void ForestSkimmer::addTree(const char *dirName, const char *treeName) {
+    for (const auto& tree : fTrees) {
+        if ( tree.first == dirName ) return;
+    }
+    fTrees.emplace_back( dirName, treeName );
+}
+
+//________________
+std::vector< std::pair<std::string, std::string> > ForestSkimmer::trees() const {
+    if ( !fTrees.empty() ) return fTrees;
+    // Trees copied by the former macro/cloneForest.C
+    return { {"hiEvtAnalyzer", "HiTree"}, {"hltanalysis", "HltTree"}, {"skimanalysis", "HltTree"},
+             {"ak4PFJetAnalyzer", "t"} };
+}
+
+//________________
+void ForestSkimmer::keepBranches(const char *dirName, const std::vector<std::string>& patterns) {
+    std::vector<std::string> &kept = fBranchPatterns[dirName];
+    for (const auto& pattern : patterns) {
+        if ( std::find( kept.begin(), kept.end(), pattern ) == kept.end() ) kept.push_back( pattern );
+    }
+}
+
+//________________
+void ForestSkimmer::keepReaderBranches() {
+    // Branches of ForestAODReader::setupBranches
+    keepBranches( "hiEvtAnalyzer", {"run", "evt", "lumi", "vz", "hiBin", "weight", "pthat"} );
+    std::vector<std::string> triggers{"Run", "Event"};
+    std::vector<std::string> filters;
+    for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+        ( TriggerAndSkim::isSkimFilter( iFlag ) ? filters : triggers ).push_back( TriggerAndSkim::flagName( iFlag ) );
+    }
+    keepBranches( "hltanalysis", triggers );
+    keepBranches( "skimanalysis", filters );
+
+    const std::vector<std::string> jetBranches{ "run", "evt", "nref", "rawpt", "jtpt", "jteta", "jtphi",
+        "trackMax", "WTAeta", "WTAphi", "jtPfNHF", "jtPfNEF", "jtPfCHF", "jtPfMUF", "jtPfCEF",
+        "jtPfCHM", "jtPfCEM", "jtPfNHM", "jtPfNEM", "jtPfMUM",
+        "ngen", "genpt", "geneta", "genphi", "WTAgeneta", "WTAgenphi",
+        "refpt", "refeta", "refphi", "refWTAeta", "refWTAphi", "refparton_flavor", "refparton_flavorForB" };
+    for (const auto& tree : trees()) {
+        if ( tree.second == "t" ) keepBranches( tree.first.c_str(), jetBranches );
+    }
+}
+
+//________________
+void ForestSkimmer::keepBranches(const char *spec) {
+    const std::string branches{ spec };
+    if ( branches.empty() || branches == "all" ) return;
+    if ( branches == "reader" ) {
+        keepReaderBranches();
+        return;
+    }
+    std::stringstream trees( branches );
+    std::string tree;
+    while ( getline( trees, tree, ';' ) ) {
+        const size_t pos = tree.find(':');
+        if ( pos == std::string::npos || pos == 0 ) {
+            std::cerr << Form("[WARNING] ForestSkimmer::keepBranches - %s has no directory name. Skipping\n", tree.c_str());
+            continue;
+        }
+        std::vector<std::string> patterns;
+        std::stringstream names( tree.substr( pos + 1 ) );
+        std::string name;
+        while ( getline( names, name, ',' ) ) {
+            if ( !name.empty() ) patterns.push_back( name );
+        }
+        keepBranches( tree.substr( 0, pos ).c_str(), patterns );
+    }
+}
+
+//________________
+void ForestSkimmer::setEventCut(EventCut *cut) {
+    if ( fEventCut && fEventCut != cut ) delete fEventCut;
+    fEventCut = cut;
+}
+
+//________________
+void ForestSkimmer::setLeadingJetPt(const double& ptCut, const char *jetTree, const char *ptBranch) {
+    fLeadingJetPt = ptCut;
+    fLeadingJetTree = jetTree;
+    fLeadingJetPtBranch = ptBranch;
+}
+
+//________________
+std::string ForestSkimmer::leadingJetTree() const {
+    if ( !fLeadingJetTree.empty() ) return fLeadingJetTree;
+    for (const auto& tree : trees()) {
+        if ( tree.second == "t" ) return tree.first;
+    }
+    return "ak4PFJetAnalyzer";
+}
+
+//________________
+int ForestSkimmer::compressionSettings(const char *spec) {
+    std::string settings{ spec };
+    const size_t pos = settings.find(':');
+    if ( pos == std::string::npos ) {
+        // Numeric settings: algorithm * 100 + level
+        const bool isNumber = !settings.empty() &&
+            std::all_of( settings.begin(), settings.end(), [](const char& c) { return std::isdigit( c ); } );
+        return ( isNumber ) ? std::stoi( settings ) : -1;
+    }
+
+    std::string codec = settings.substr( 0, pos );
+    std::transform( codec.begin(), codec.end(), codec.begin(), [](const char& c) { return std::toupper( c ); } );
+    const int level = std::atoi( settings.substr( pos + 1 ).c_str() );
+    if ( level < 0 || level > 99 ) return -1;
+    if ( codec == "ZLIB" ) return ROOT::CompressionSettings( ROOT::RCompressionSetting::EAlgorithm::kZLIB, level );
+    if ( codec == "LZMA" ) return ROOT::CompressionSettings( ROOT::RCompressionSetting::EAlgorithm::kLZMA, level );
+    if ( codec == "LZ4" )  return ROOT::CompressionSettings( ROOT::RCompressionSetting::EAlgorithm::kLZ4, level );
+    if ( codec == "ZSTD" ) return ROOT::CompressionSettings( ROOT::RCompressionSetting::EAlgorithm::kZSTD, level );
+    return -1;
+}
+
+//________________
+bool ForestSkimmer::selectEntries(TFile *inFile, std::vector<Long64_t>& entries, Result& result) const {
+
+    TTree *eventTree = dynamic_cast<TTree*>( inFile->Get("hiEvtAnalyzer/HiTree") );
+    if ( !eventTree ) {
+        std::cerr << Form("[ERROR] ForestSkimmer::selectEntries - %s has no hiEvtAnalyzer/HiTree\n", inFile->GetName());
+        return false;
+    }
+    const Long64_t nEntries = eventTree->GetEntries();
+    entries.clear();
+
+    // Without selection every entry is copied
+    if ( !fEventCut && fLeadingJetPt < 0 ) {
+        entries.resize( nEntries );
+        for (Long64_t iEntry{0}; iEntry<nEntries; iEntry++) entries.at(iEntry) = iEntry;
+        return true;
+    }
+
+    //
+    // Only branches of the selection are read (types follow ForestAODReader)
+    //
+    UInt_t run{0}, lumi{0};
+    ULong64_t eventId{0};
+    Float_t vz{0}, weight{1}, ptHat{1};
+    Int_t hiBin{-1};
+    std::vector<Int_t> flags( TriggerAndSkim::kNFlags, 0 );
+    Int_t nJets{0};
+    std::vector<Float_t> jetPt;
+
+    auto enable = [](TTree *tree, const char *name, void *address) {
+        if ( !tree->GetBranch( name ) ) return false;
+        tree->SetBranchStatus( name, 1 );
+        tree->SetBranchAddress( name, address );
+        return true;
+    };
+
+    std::vector<TTree*> selectionTrees;
+    if ( fEventCut ) {
+        eventTree->SetBranchStatus("*", 0);
+        enable( eventTree, "run", &run );
+        enable( eventTree, "evt", &eventId );
+        enable( eventTree, "lumi", &lumi );
+        enable( eventTree, "vz", &vz );
+        enable( eventTree, "hiBin", &hiBin );
+        if ( fIsMc ) {
+            enable( eventTree, "weight", &weight );
+            enable( eventTree, "pthat", &ptHat );
+        }
+        selectionTrees.push_back( eventTree );
+
+        // Flags missing in the menu stay 0 as in ForestAODReader
+        TTree *hltTree = dynamic_cast<TTree*>( inFile->Get("hltanalysis/HltTree") );
+        TTree *skimTree = dynamic_cast<TTree*>( inFile->Get("skimanalysis/HltTree") );
+        if ( hltTree ) hltTree->SetBranchStatus("*", 0);
+        if ( skimTree ) skimTree->SetBranchStatus("*", 0);
+        for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+            TTree *tree = ( TriggerAndSkim::isSkimFilter( iFlag ) ) ? skimTree : hltTree;
+            if ( tree ) enable( tree, TriggerAndSkim::flagName( iFlag ), &flags.at(iFlag) );
+        }
+        for (auto tree : {hltTree, skimTree}) {
+            if ( tree ) selectionTrees.push_back( tree );
+        }
+    }
+
+    if ( fLeadingJetPt >= 0 ) {
+        const std::string jetTreeName = leadingJetTree();
+        TTree *jetTree = dynamic_cast<TTree*>( inFile->Get( Form("%s/t", jetTreeName.c_str()) ) );
+        if ( !jetTree || !jetTree->GetBranch("nref") || !jetTree->GetBranch( fLeadingJetPtBranch.c_str() ) ) {
+            std::cerr << Form("[ERROR] ForestSkimmer::selectEntries - %s has no %s/t with nref and %s branches\n",
+                              inFile->GetName(), jetTreeName.c_str(), fLeadingJetPtBranch.c_str());
+            return false;
+        }
+        // Buffer is sized from the input as in ForestAODReader
+        jetPt.assign( std::max( static_cast<size_t>( jetTree->GetMaximum("nref") ), size_t{1} ), 0.f );
+        jetTree->SetBranchStatus("*", 0);
+        enable( jetTree, "nref", &nJets );
+        enable( jetTree, fLeadingJetPtBranch.c_str(), jetPt.data() );
+        selectionTrees.push_back( jetTree );
+    }
+
+    for (auto tree : selectionTrees) {
+        if ( tree->GetEntries() != nEntries ) {
+            std::cerr << Form("[ERROR] ForestSkimmer::selectEntries - %s has %lld entries while the event tree has %lld\n",
+                              tree->GetDirectory()->GetName(), tree->GetEntries(), nEntries);
+            for (auto t : selectionTrees) t->ResetBranchAddresses();
+            return false;
+        }
+    }
+
+    // Each file has its own copy of the cut: files are skimmed in parallel
+    std::unique_ptr<EventCut> eventCut{ ( fEventCut ) ? new EventCut{ *fEventCut } : nullptr };
+    Event event;
+    bool isGood{true};
+    for (Long64_t iEntry{0}; iEntry<nEntries; iEntry++) {
+        for (auto tree : selectionTrees) tree->GetEntry( iEntry );
+
+        if ( eventCut ) {
+            event.setRunId( run );
+            event.setEventId( eventId );
+            event.setLumi( lumi );
+            event.setVz( vz );
+            event.setHiBin( hiBin );
+            event.setPtHat( ( fIsMc ) ? ptHat : 1.f );
+            event.setPtHatWeight( ( fIsMc ) ? weight : 1.f );
+            for (int iFlag{0}; iFlag<TriggerAndSkim::kNFlags; iFlag++) {
+                event.trigAndSkim()->setFlag( iFlag, flags.at(iFlag) != 0 );
+            }
+            if ( !eventCut->pass( &event ) ) {
+                result.nEventCutFailed++;
+                continue;
+            }
+            result.nEventCutPassed++;
+        }
+
+        if ( fLeadingJetPt >= 0 ) {
+            if ( nJets < 0 || static_cast<size_t>( nJets ) > jetPt.size() ) {
+                std::cerr << Form("[ERROR] ForestSkimmer::selectEntries - entry %lld: nref = %d exceeds buffer size %zu\n",
+                                  iEntry, nJets, jetPt.size());
+                isGood = false;
+                break;
+            }
+            const auto leading = std::max_element( jetPt.begin(), jetPt.begin() + nJets );
+            if ( leading == jetPt.begin() + nJets || *leading < fLeadingJetPt ) continue;
+        }
+        entries.push_back( iEntry );
+    }
+
+    // Local buffers go out of scope
+    for (auto tree : selectionTrees) tree->ResetBranchAddresses();
+    return isGood;
+}
+
+//________________
+bool ForestSkimmer::copyTree(TTree *tree, TFile *outFile, const std::string& dirName,
+                             const std::vector<Long64_t>& entries) const {
+
+    // Only active branches are cloned
+    auto patterns = fBranchPatterns.find( dirName );
+    if ( patterns == fBranchPatterns.end() ) {
+        tree->SetBranchStatus("*", 1);
+    }
+    else {
+        tree->SetBranchStatus("*", 0);
+        for (const auto& pattern : patterns->second) {
+            UInt_t found{0};
+            tree->SetBranchStatus( pattern.c_str(), 1, &found );
+            if ( found == 0 && fVerbose ) {
+                std::cout << Form("%s: no branch matches %s\n", dirName.c_str(), pattern.c_str());
+            }
+        }
+    }
+
+    TDirectory *outDir = outFile->mkdir( dirName.c_str() );
+    outDir->cd();
+    TTree *outTree = tree->CloneTree( 0 );
+    if ( !outTree ) {
+        std::cerr << Form("[ERROR] ForestSkimmer::copyTree - cannot clone %s/%s\n", dirName.c_str(), tree->GetName());
+        return false;
+    }
+
+    // Cloned branches keep the compression of the input
+    TIter next( outTree->GetListOfBranches() );
+    while ( TBranch *branch = static_cast<TBranch*>( next() ) ) {
+        branch->SetCompressionSettings( fCompression );
+    }
+    if ( fBasketSize > 0 ) outTree->SetBasketSize( "*", fBasketSize );
+
+    for (const auto& entry : entries) {
+        if ( tree->GetEntry( entry ) <= 0 ) {
+            std::cerr << Form("[ERROR] ForestSkimmer::copyTree - cannot read entry %lld of %s/%s\n",
+                              entry, dirName.c_str(), tree->GetName());
+            delete outTree;
+            return false;
+        }
+        outTree->Fill();
+    }
+    outTree->Write( "", TObject::kOverwrite );
+    if ( fVerbose ) {
+        std::cout << Form("%s/%s: %d branches, %lld of %lld entries copied\n", dirName.c_str(), tree->GetName(),
+                          outTree->GetListOfBranches()->GetEntries(), outTree->GetEntries(), tree->GetEntries());
+    }
+    delete outTree;
+    tree->ResetBranchAddresses();
+    return true;
+}
+
+//________________
+ForestSkimmer::Result ForestSkimmer::skim(const char *inFileName, const char *outFileName) const {
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<TFile> inFile{ TFile::Open( inFileName ) };
+    if ( !inFile || inFile->IsZombie() ) {
+        std::cerr << Form("[ERROR] ForestSkimmer::skim - cannot open %s\n", inFileName);
+        return result;
+    }
+    result.inBytes = inFile->GetSize();
+
+    std::vector<Long64_t> entries;
+    if ( !selectEntries( inFile.get(), entries, result ) ) return result;
+    TTree *eventTree = dynamic_cast<TTree*>( inFile->Get("hiEvtAnalyzer/HiTree") );
+    result.nEvents = eventTree->GetEntries();
+    result.nSelected = entries.size();
+
+    // Complete file replaces the old one
+    TString tmpName = Form("%s.%d.tmp", outFileName, gSystem->GetPid());
+    std::unique_ptr<TFile> outFile{ TFile::Open( tmpName.Data(), "RECREATE", "", fCompression ) };
+    if ( !outFile || outFile->IsZombie() ) {
+        std::cerr << Form("[ERROR] ForestSkimmer::skim - cannot create %s\n", tmpName.Data());
+        return result;
+    }
+
+    bool isGood{true};
+    for (const auto& treeName : trees()) {
+        TTree *tree = dynamic_cast<TTree*>( inFile->Get( Form("%s/%s", treeName.first.c_str(), treeName.second.c_str()) ) );
+        if ( !tree ) {
+            std::cerr << Form("[WARNING] ForestSkimmer::skim - %s has no %s/%s. Skipping\n",
+                              inFileName, treeName.first.c_str(), treeName.second.c_str());
+            continue;
+        }
+        if ( tree->GetEntries() != result.nEvents ) {
+            std::cerr << Form("[ERROR] ForestSkimmer::skim - %s/%s has %lld entries while the event tree has %lld\n",
+                              treeName.first.c_str(), treeName.second.c_str(), tree->GetEntries(), result.nEvents);
+            isGood = false;
+            break;
+        }
+        isGood = copyTree( tree, outFile.get(), treeName.first, entries );
+        if ( !isGood ) break;
+    }
+    outFile->Close();
+
+    if ( !isGood || gSystem->Rename( tmpName.Data(), outFileName ) != 0 ) {
+        std::cerr << Form("[ERROR] ForestSkimmer::skim - %s is not skimmed\n", inFileName);
+        gSystem->Unlink( tmpName.Data() );
+        return result;
+    }
+    FileStat_t outStat;
+    if ( gSystem->GetPathInfo( outFileName, outStat ) == 0 ) result.outBytes = outStat.fSize;
+    result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    result.isGood = true;
+    std::cout << Form("%s -> %s: %lld of %lld events, %.1f -> %.1f MB\n", inFileName, outFileName,
+                      result.nSelected, result.nEvents, result.inBytes / 1024. / 1024., result.outBytes / 1024. / 1024.);
+    return result;
+}
+
+//________________
+ForestSkimmer::Result ForestSkimmer::skim(const std::vector<std::string>& inFiles, const char *outDir,
+                                          const int& nThreads, std::vector<Result> *results) const {
+    auto start = std::chrono::steady_clock::now();
+    gSystem->mkdir( outDir, kTRUE );
+
+    std::vector<Result> fileResults( inFiles.size() );
+    const int nWorkers = std::max( std::min( nThreads, static_cast<int>( inFiles.size() ) ), 1 );
+    if ( nWorkers > 1 ) {
+        ROOT::EnableThreadSafety();
+    }
+    std::atomic<size_t> next{0};
+    auto skimFiles = [&]() {
+        for (size_t iFile = next++; iFile < inFiles.size(); iFile = next++) {
+            TString outName = Form("%s/%s", outDir, gSystem->BaseName( inFiles.at(iFile).c_str() ));
+            fileResults.at(iFile) = skim( inFiles.at(iFile).c_str(), outName.Data() );
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int iThread{1}; iThread<nWorkers; iThread++) {
+        threads.emplace_back( skimFiles );
+    }
+    skimFiles();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Result total;
+    total.isGood = true;
+    for (const auto& result : fileResults) {
+        total.isGood = total.isGood && result.isGood;
+        total.nEvents += result.nEvents;
+        total.nSelected += result.nSelected;
+        total.nEventCutPassed += result.nEventCutPassed;
+        total.nEventCutFailed += result.nEventCutFailed;
+        total.inBytes += result.inBytes;
+        total.outBytes += result.outBytes;
+    }
+    total.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    if ( results ) *results = fileResults;
+    return total;
+}
+
+//________________
+void ForestSkimmer::report() const {
+    TString report = "\nReporting from ForestSkimmer\n";
+    report += TString::Format( "Compression     :\t %d\n", fCompression );
+    report += TString::Format( "Basket size     :\t %s\n", ( fBasketSize > 0 ) ? Form("%d bytes", fBasketSize) : "as input" );
+    report += TString::Format( "Event cut       :\t %s\n", ( fEventCut ) ? "yes" : "no" );
+    if ( fLeadingJetPt >= 0 ) {
+        report += TString::Format( "Leading jet     :\t %s >= %.1f GeV (%s)\n", fLeadingJetPtBranch.c_str(),
+                                   fLeadingJetPt, leadingJetTree().c_str() );
+    }
+    for (const auto& tree : trees()) {
+        auto patterns = fBranchPatterns.find( tree.first );
+        report += TString::Format( "Tree            :\t %s/%s - ", tree.first.c_str(), tree.second.c_str() );
+        if ( patterns == fBranchPatterns.end() ) {
+            report += "all branches\n";
+            continue;
+        }
+        report += TString::Format( "%zu branch patterns\n", patterns->second.size() );
+    }
+    if ( fEventCut ) {
+        // Counters of the cut stay zero: every file is selected with its own copy of the cut
+        report += TString::Format( "Event cut limits:\t %s\n", fEventCut->settings().Data() );
+    }
+    std::cout << report.Data() << std::endl;
+}
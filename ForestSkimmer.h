@@ -0,0 +1,125 @@
+/**
+ * @file ForestSkimmer.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Skim forest files: event selection, branch selection and recompression
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef ForestSkimmer_h
+#define ForestSkimmer_h
+
+// Jet analysis headers
+#include "EventCut.h"
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <map>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class TFile;
+class TTree;
+
+//________________
+class ForestSkimmer {
+  public:
+    /// @brief Constructor
+    ForestSkimmer();
+    /// @brief Destructor
+    virtual ~ForestSkimmer();
+
+    /// @brief Numbers of a skimmed file
+    struct Result {
+        bool isGood{false};
+        Long64_t nEvents{0};
+        Long64_t nSelected{0};
+        /// Events passed and failed the event cut (files have their own copies of the cut)
+        Long64_t nEventCutPassed{0};
+        Long64_t nEventCutFailed{0};
+        Long64_t inBytes{0};
+        Long64_t outBytes{0};
+        double seconds{0};
+    };
+
+    /// @brief Add tree to copy (directory and tree name). Default: event, HLT, skimming trees
+    /// and the ak4PFJetAnalyzer jet tree
+    void addTree(const char *dirName, const char *treeName = "t");
+    /// @brief Copy only branches matching the patterns (e.g. "jt*") of the trees in the directory.
+    /// Trees without patterns are copied with all branches
+    void keepBranches(const char *dirName, const std::vector<std::string>& patterns);
+    /// @brief Copy only branches read by ForestAODReader (tracks are not included)
+    void keepReaderBranches();
+    /// @brief Parse "dir:pattern,pattern;dir:pattern" and call keepBranches (or keepReaderBranches for "reader")
+    void keepBranches(const char *spec);
+
+    /// @brief Event selection applied to every file (the skimmer owns the cut)
+    void setEventCut(EventCut *cut);
+    /// @brief Keep events with the leading jet above the threshold
+    /// @param jetTree Directory of the jet tree (default: first jet tree added)
+    /// @param ptBranch Jet pT branch (e.g. jtpt or rawpt)
+    void setLeadingJetPt(const double& ptCut, const char *jetTree = "", const char *ptBranch = "jtpt");
+    /// @brief Read generator-level quantities of the event tree (pthat and weight) for the event cut
+    void setIsMc(const bool& isMc = true) { fIsMc = isMc; }
+
+    /// @brief Set compression settings of the output (algorithm * 100 + level, e.g. 505 - ZSTD level 5)
+    void setCompression(const int& settings = 505) { fCompression = settings; }
+    /// @brief Set basket size of the output branches in bytes (0 - basket sizes of the input)
+    void setBasketSize(const int& size = 0) { fBasketSize = size; }
+    /// @brief Print information about every tree
+    void setVerbose() { fVerbose = true; }
+
+    /// @brief Convert "LZ4:4", "ZSTD:5", "LZMA:8", "ZLIB:1" or "505" to compression settings
+    /// @return Compression settings or -1 if the codec is unknown
+    static int compressionSettings(const char *spec);
+
+    /// @brief Skim input file into the output file. The output is written to a temporary file
+    /// renamed at the end, so a failed skim leaves no output
+    Result skim(const char *inFileName, const char *outFileName) const;
+    /// @brief Skim files in parallel. Output files are named after the input files
+    /// @return Sum over the files (isGood if all files are skimmed)
+    Result skim(const std::vector<std::string>& inFiles, const char *outDir, const int& nThreads,
+                std::vector<Result> *results = nullptr) const;
+
+    /// @brief Print selection, trees and branches kept. Event cut statistics are in the Result of skim()
+    void report() const;
+
+  private:
+    /// @brief Return entries of the file passing the selection and add event cut statistics to the result
+    bool selectEntries(TFile *inFile, std::vector<Long64_t>& entries, Result& result) const;
+    /// @brief Copy selected entries of the tree to the output directory
+    bool copyTree(TTree *tree, TFile *outFile, const std::string& dirName, const std::vector<Long64_t>& entries) const;
+    /// @brief Return trees to copy (directory and tree name)
+    std::vector< std::pair<std::string, std::string> > trees() const;
+    /// @brief Return directory of the jet tree used in the leading-jet selection
+    std::string leadingJetTree() const;
+
+    /// @brief Trees copied (directory and tree name)
+    std::vector< std::pair<std::string, std::string> > fTrees;
+    /// @brief Branch patterns kept for the directories
+    std::map< std::string, std::vector<std::string> > fBranchPatterns;
+    /// @brief Event selection
+    EventCut *fEventCut;
+    /// @brief Leading jet pT threshold (no selection if negative)
+    double fLeadingJetPt;
+    /// @brief Directory of the jet tree with the leading jet
+    std::string fLeadingJetTree;
+    /// @brief Jet pT branch of the leading-jet selection
+    std::string fLeadingJetPtBranch;
+    /// @brief Read generator-level quantities
+    bool fIsMc;
+    /// @brief Compression settings of the output
+    int fCompression;
+    /// @brief Basket size of the output branches
+    int fBasketSize;
+    /// @brief Verbose mode
+    bool fVerbose;
+};
+
+#endif // #define ForestSkimmer_h
@@ -0,0 +1,80 @@
+/**
+ * @file ForestTools.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Helpers shared by the forest tools (file lists and reading benchmark)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "ForestTools.h"
+#include "ForestAODReader.h"
+
+// ROOT headers
+#include "TString.h"
+
+// C++ headers
+#include <chrono>
+#include <fstream>
+
+//________________
+void ForestTools::readFileList(const char *input, std::vector<std::string>& files) {
+    if ( TString( input ).Index(".root") > 0 ) {
+        files.push_back( input );
+        return;
+    }
+    std::ifstream inputStream( input );
+    std::string file;
+    while ( getline( inputStream, file ) ) {
+        // Take only the file name of "file NumEvents"
+        size_t pos = file.find_first_of(" ");
+        if ( pos != std::string::npos ) file.erase( pos );
+        if ( file.find(".root") != std::string::npos ) files.push_back( file );
+    }
+}
+
+//________________
+double ForestTools::readEvents(const char *input, const bool& isMc, const std::string& jetTree,
+                               const char *path2JetAnalysis, const Long64_t& nEvents, Long64_t& nRead,
+                               double *checksum, const bool& useRNTuple) {
+
+    ForestAODReader *reader = new ForestAODReader{input};
+    if ( isMc ) reader->setIsMc();
+    reader->useHltBranch();
+    reader->useSkimmingBranch();
+    reader->useRecoJetBranch();
+    reader->setRecoJetBranchName( jetTree.c_str() );
+    reader->setPath2JetAnalysis( path2JetAnalysis );
+    // No random JER smearing: events of different inputs must be equal
+    reader->useJERSystematics( 2 );
+    reader->useRNTupleInput( useRNTuple );
+    if ( nEvents > 0 ) reader->setEntryRange( 0, nEvents );
+    reader->init();
+
+    auto start = std::chrono::steady_clock::now();
+    if ( checksum ) *checksum = 0;
+    nRead = 0;
+    for (Long64_t iEvent{0}; iEvent<reader->nEventsTotal(); iEvent++) {
+        Event *event = reader->returnEvent();
+        if ( !event ) continue;
+        if ( checksum ) {
+            *checksum += event->runId() + static_cast<double>( event->eventId() % 1000003 ) + event->vz() +
+                         event->ptHatWeight() + static_cast<double>( event->trigAndSkim()->mask() % 1000003 );
+            for (auto jet : *event->recoJetCollection()) {
+                *checksum += jet->rawPt() + jet->ptJECCorr() + jet->eta() + jet->phi() + jet->genJetId();
+            }
+            for (auto jet : *event->genJetCollection()) {
+                *checksum += jet->pt() + jet->eta() + jet->phi();
+            }
+        }
+        reader->recycleEvent( event );
+        nRead++;
+    }
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    reader->finish();
+    delete reader;
+    return ( seconds > 0 ) ? nRead / seconds : 0.;
+}
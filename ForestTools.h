@@ -0,0 +1,39 @@
+/**
+ * @file ForestTools.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Helpers shared by the forest tools (file lists and reading benchmark)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef ForestTools_h
+#define ForestTools_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <string>
+#include <vector>
+
+//________________
+class ForestTools {
+  public:
+    /// @brief Add the input file (.root) or the files of the list ("file NumEvents" lines are allowed)
+    static void readFileList(const char *input, std::vector<std::string>& files);
+
+    /// @brief Read events of the input with ForestAODReader (no random JER smearing) and
+    /// return events per second. Initialization (JEC files, buffers) is not timed
+    /// @param nEvents Number of events to read (-1 - all)
+    /// @param nRead Number of events read
+    /// @param checksum Sum of event and jet quantities to compare inputs (not computed if nullptr)
+    /// @param useRNTuple Input files are RNTuple conversions of the forest
+    static double readEvents(const char *input, const bool& isMc, const std::string& jetTree,
+                             const char *path2JetAnalysis, const Long64_t& nEvents, Long64_t& nRead,
+                             double *checksum = nullptr, const bool& useRNTuple = false);
+};
+
+#endif // #define ForestTools_h
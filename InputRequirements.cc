@@ -0,0 +1,80 @@
+/**
+ * @file InputRequirements.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Input quantities required by analyses and cuts
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "InputRequirements.h"
+
+// ROOT headers
+#include "TString.h"
+
+// C++ headers
+#include <iostream>
+
+//________________
+InputRequirements::InputRequirements() : fRequireAll{false}, fTriggers{}, fSkimFilters{}, fJetContent{0} {
+    /* empty */
+}
+
+//________________
+void InputRequirements::add(const InputRequirements& other) {
+    fRequireAll = ( fRequireAll || other.fRequireAll );
+    fTriggers.insert( other.fTriggers.begin(), other.fTriggers.end() );
+    fSkimFilters.insert( other.fSkimFilters.begin(), other.fSkimFilters.end() );
+    fJetContent |= other.fJetContent;
+}
+
+//________________
+bool InputRequirements::isTriggerRequired(const std::string& name) const {
+    if ( fRequireAll ) return true;
+    std::string trigger = name;
+    const std::string suffix = "_Prescl";
+    if ( trigger.size() > suffix.size() && 
+         trigger.compare( trigger.size() - suffix.size(), suffix.size(), suffix ) == 0 ) {
+        trigger.erase( trigger.size() - suffix.size() );
+    }
+    return ( fTriggers.count(trigger) > 0 );
+}
+
+//________________
+bool InputRequirements::isSkimFilterRequired(const std::string& name) const {
+    return ( fRequireAll || fSkimFilters.count(name) > 0 );
+}
+
+//________________
+std::string InputRequirements::key() const {
+    if ( fRequireAll ) return "inputs=all";
+    // Sets are ordered, so equal requirements give equal keys
+    std::string key = "triggers=";
+    for (const auto& name : fTriggers) { key += name; key += ","; }
+    key += " filters=";
+    for (const auto& name : fSkimFilters) { key += name; key += ","; }
+    key += Form(" jetContent=%u", fJetContent);
+    return key;
+}
+
+//________________
+void InputRequirements::print() const {
+    if ( fRequireAll ) {
+        std::cout << "Required inputs: all" << std::endl;
+        return;
+    }
+    TString triggers, filters;
+    for (const auto& name : fTriggers) { triggers += " "; triggers += name.c_str(); }
+    for (const auto& name : fSkimFilters) { filters += " "; filters += name.c_str(); }
+    std::cout << "Required inputs:\n"
+              << Form("--> triggers    :%s\n", triggers.Data())
+              << Form("--> skim filters:%s\n", filters.Data())
+              << Form("--> jet content : trackMax %d WTA %d PF fractions %d PF multiplicities %d parton flavor %d",
+                      isJetContentRequired(kJetTrackMax), isJetContentRequired(kJetWTAAxes),
+                      isJetContentRequired(kJetPFFractions), isJetContentRequired(kJetPFMultiplicities),
+                      isJetContentRequired(kJetPartonFlavor) )
+              << std::endl;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file InputRequirements.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Input quantities required by analyses and cuts
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef InputRequirements_h
+#define InputRequirements_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <set>
+#include <string>
+
+//________________
+class InputRequirements {
+  public:
+    /// @brief Optional jet content (jet kinematics are always read)
+    enum JetContent {
+        kJetTrackMax         = 1 << 0, ///< trackMax
+        kJetWTAAxes          = 1 << 1, ///< WTA axes of reco, gen and matched jets
+        kJetPFFractions      = 1 << 2, ///< jtPf*F energy fractions
+        kJetPFMultiplicities = 1 << 3, ///< jtPf*M multiplicities
+        kJetPartonFlavor     = 1 << 4, ///< parton flavor of the matched gen jets
+        kJetAll              = (1 << 5) - 1
+    };
+
+    /// @brief Constructor (nothing is required)
+    InputRequirements();
+    /// @brief Destructor
+    virtual ~InputRequirements() { /* empty */ }
+
+    /// @brief Require all input quantities (default for analyses that do not declare their inputs)
+    void requireAll()                              { fRequireAll = {true}; }
+    /// @brief Require trigger decision (the prescale branch is implied)
+    void requireTrigger(const std::string& name)    { fTriggers.insert(name); }
+    /// @brief Require skimming filter
+    void requireSkimFilter(const std::string& name) { fSkimFilters.insert(name); }
+    /// @brief Require optional jet content (JetContent flags)
+    void requireJetContent(const UInt_t& flags)     { fJetContent |= flags; }
+    /// @brief Add requirements of other analysis or cut
+    void add(const InputRequirements& other);
+
+    /// @brief All input quantities are required
+    bool isAllRequired() const { return fRequireAll; }
+    /// @brief Trigger decision or its prescale (name with _Prescl suffix) is required
+    bool isTriggerRequired(const std::string& name) const;
+    /// @brief Skimming filter is required
+    bool isSkimFilterRequired(const std::string& name) const;
+    /// @brief All of the jet content flags are required
+    bool isJetContentRequired(const UInt_t& flags) const 
+    { return ( fRequireAll || (fJetContent & flags) == flags ); }
+
+    /// @brief Print requirements
+    void print() const;
+    /// @brief Return requirements as a single line (e.g. for cache keys)
+    std::string key() const;
+
+  private:
+    /// @brief Require all input quantities
+    bool fRequireAll;
+    /// @brief Required trigger names
+    std::set<std::string> fTriggers;
+    /// @brief Required skimming filter names
+    std::set<std::string> fSkimFilters;
+    /// @brief Required jet content (JetContent flags)
+    UInt_t fJetContent;
+};
+
+#endif // #define InputRequirements_h
@@ -0,0 +1,84 @@
+/**
+ * @file JetBatch.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Columnar (struct-of-arrays) jets of a block of events
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "JetBatch.h"
+
+//________________
+JetBatch::JetBatch() : fEntry{}, fVz{}, fWeight{}, fOffsets{0},
+    fPt{}, fEta{}, fPhi{}, fHasPFFractions{false},
+    fChf{}, fNhf{}, fCef{}, fNef{}, fMuf{} {
+    /* empty */
+}
+
+//________________
+void JetBatch::clear() {
+    fEntry.clear();
+    fVz.clear();
+    fWeight.clear();
+    fOffsets.assign(1, 0);
+    fPt.clear();
+    fEta.clear();
+    fPhi.clear();
+    fChf.clear();
+    fNhf.clear();
+    fCef.clear();
+    fNef.clear();
+    fMuf.clear();
+}
+
+//________________
+void JetBatch::reserve(const size_t& nEvents, const size_t& nJets) {
+    fEntry.reserve( nEvents );
+    fVz.reserve( nEvents );
+    fWeight.reserve( nEvents );
+    fOffsets.reserve( nEvents + 1 );
+    fPt.reserve( nJets );
+    fEta.reserve( nJets );
+    fPhi.reserve( nJets );
+    if ( fHasPFFractions ) {
+        fChf.reserve( nJets );
+        fNhf.reserve( nJets );
+        fCef.reserve( nJets );
+        fNef.reserve( nJets );
+        fMuf.reserve( nJets );
+    }
+}
+
+//________________
+void JetBatch::addEvent(const Long64_t& entry, const float& vz, const float& weight) {
+    fEntry.push_back( entry );
+    fVz.push_back( vz );
+    fWeight.push_back( weight );
+    // Event has no jets until they are added
+    fOffsets.push_back( fOffsets.back() );
+}
+
+//________________
+void JetBatch::addJets(const int& nJets, const float *pt, const float *eta, const float *phi) {
+    if ( nJets <= 0 ) return;
+    // Input arrays are contiguous: whole ranges are copied
+    fPt.insert( fPt.end(), pt, pt + nJets );
+    fEta.insert( fEta.end(), eta, eta + nJets );
+    fPhi.insert( fPhi.end(), phi, phi + nJets );
+    fOffsets.back() += nJets;
+}
+
+//________________
+void JetBatch::addPFFractions(const int& nJets, const float *chf, const float *nhf,
+                              const float *cef, const float *nef, const float *muf) {
+    if ( nJets <= 0 ) return;
+    fChf.insert( fChf.end(), chf, chf + nJets );
+    fNhf.insert( fNhf.end(), nhf, nhf + nJets );
+    fCef.insert( fCef.end(), cef, cef + nJets );
+    fNef.insert( fNef.end(), nef, nef + nJets );
+    fMuf.insert( fMuf.end(), muf, muf + nJets );
+}
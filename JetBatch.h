@@ -0,0 +1,110 @@
+/**
+ * @file JetBatch.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Columnar (struct-of-arrays) jets of a block of events
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef JetBatch_h
+#define JetBatch_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <vector>
+
+//________________
+/// @brief Jets of a block of events stored in contiguous columns. Jets of the
+/// iEvent-th event are [jetBegin(iEvent), jetEnd(iEvent)) of each jet column.
+/// Columns hold the values read from the input: no corrections are applied
+class JetBatch {
+  public:
+    /// @brief Constructor
+    JetBatch();
+    /// @brief Destructor
+    virtual ~JetBatch() { /* empty */ }
+
+    /// @brief Remove all events (memory is kept for the next batch)
+    void clear();
+    /// @brief Reserve memory for the given number of events and jets
+    void reserve(const size_t& nEvents, const size_t& nJets);
+
+    /// @brief Start a new event: following jets belong to it
+    void addEvent(const Long64_t& entry, const float& vz, const float& weight);
+    /// @brief Add jet kinematics of the last event
+    void addJets(const int& nJets, const float *pt, const float *eta, const float *phi);
+    /// @brief Add PF energy fractions of the jets added last
+    void addPFFractions(const int& nJets, const float *chf, const float *nhf,
+                        const float *cef, const float *nef, const float *muf);
+
+    /// @brief PF energy fractions are filled
+    void setHasPFFractions(const bool& has) { fHasPFFractions = has; }
+    /// @brief Return true if PF energy fractions are filled
+    bool hasPFFractions() const { return fHasPFFractions; }
+
+    /// @brief Number of events in the batch
+    size_t nEvents() const { return fEntry.size(); }
+    /// @brief Number of jets in the batch
+    size_t nJets() const { return fPt.size(); }
+    /// @brief Index of the first jet of the event
+    size_t jetBegin(const size_t& iEvent) const { return fOffsets[iEvent]; }
+    /// @brief Index after the last jet of the event
+    size_t jetEnd(const size_t& iEvent) const { return fOffsets[iEvent + 1]; }
+
+    /// @brief Chain entry of each event
+    const std::vector<Long64_t>& entry() const { return fEntry; }
+    /// @brief Vertex z of each event
+    const std::vector<float>& vz() const { return fVz; }
+    /// @brief Weight of each event (pT hat weight for MC, 1 for data)
+    const std::vector<float>& weight() const { return fWeight; }
+    /// @brief Index of the first jet of each event (nEvents + 1 values)
+    const std::vector<UInt_t>& offsets() const { return fOffsets; }
+
+    /// @brief Jet transverse momentum (without JEC)
+    const std::vector<float>& pt() const { return fPt; }
+    /// @brief Jet pseudorapidity
+    const std::vector<float>& eta() const { return fEta; }
+    /// @brief Jet azimuthal angle
+    const std::vector<float>& phi() const { return fPhi; }
+    /// @brief Charged hadron energy fraction
+    const std::vector<float>& chf() const { return fChf; }
+    /// @brief Neutral hadron energy fraction
+    const std::vector<float>& nhf() const { return fNhf; }
+    /// @brief Charged electromagnetic energy fraction
+    const std::vector<float>& cef() const { return fCef; }
+    /// @brief Neutral electromagnetic energy fraction
+    const std::vector<float>& nef() const { return fNef; }
+    /// @brief Muon energy fraction
+    const std::vector<float>& muf() const { return fMuf; }
+
+  private:
+    /// @brief Chain entry of each event
+    std::vector<Long64_t> fEntry;
+    /// @brief Vertex z of each event
+    std::vector<float> fVz;
+    /// @brief Weight of each event
+    std::vector<float> fWeight;
+    /// @brief Index of the first jet of each event and the total number of jets
+    std::vector<UInt_t> fOffsets;
+
+    /// @brief Jet kinematics
+    std::vector<float> fPt;
+    std::vector<float> fEta;
+    std::vector<float> fPhi;
+
+    /// @brief PF energy fractions are filled
+    bool fHasPFFractions;
+    /// @brief PF energy fractions
+    std::vector<float> fChf;
+    std::vector<float> fNhf;
+    std::vector<float> fCef;
+    std::vector<float> fNef;
+    std::vector<float> fMuf;
+};
+
+#endif // #define JetBatch_h
@@ -0,0 +1,338 @@
+/**
+ * @file JetCache.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Flat columnar file of events and calibrated jets read through mmap
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "JetCache.h"
+#include "Event.h"
+
+// ROOT headers
+#include "TString.h"
+
+// C++ headers
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+    /// @brief File signature
+    const char kMagic[8] = {'J', 'E', 'T', 'C', 'A', 'C', 'H', 'E'};
+    /// @brief Columns start at multiples of the alignment
+    const size_t kAlignment = 64;
+
+    /// @brief Round the offset up to the alignment
+    size_t aligned(const size_t& offset) { return ( offset + kAlignment - 1 ) / kAlignment * kAlignment; }
+} // namespace
+
+const UInt_t JetCache::kVersion;
+
+//________________
+JetCache::JetCache() : fColumns( kNColumns ), fNEvents{0}, fNRecoJets{0}, fNGenJets{0},
+    fMap{nullptr}, fMapSize{0}, fHeader{nullptr} {
+    /* empty */
+}
+
+//________________
+JetCache::~JetCache() {
+    unmap();
+}
+
+//________________
+size_t JetCache::elementSize(const int& iColumn) {
+    switch ( iColumn ) {
+        case kEntry: case kEventId: case kTriggerMask: case kRecoJetBegin: case kGenJetBegin:
+            return sizeof(ULong64_t);
+        case kGenJetsFilled: case kRecoPfCHM: case kRecoPfCEM: case kRecoPfNHM: case kRecoPfNEM: case kRecoPfMUM:
+            return sizeof(UChar_t);
+        default:
+            // 32-bit integers and floats
+            return sizeof(Float_t);
+    }
+}
+
+//________________
+ULong64_t JetCache::columnLength(const int& iColumn, const ULong64_t& nEvents, 
+                                 const ULong64_t& nRecoJets, const ULong64_t& nGenJets) {
+    if ( iColumn < kRecoJetBegin ) return nEvents;
+    if ( iColumn < kRecoId ) return nEvents + 1;
+    if ( iColumn < kGenId ) return nRecoJets;
+    return nGenJets;
+}
+
+//________________
+void JetCache::clear() {
+    for (auto& column : fColumns) column.clear();
+    fNEvents = 0;
+    fNRecoJets = 0;
+    fNGenJets = 0;
+}
+
+//________________
+void JetCache::addEvent(const Long64_t& entry, const Event *event) {
+
+    append<ULong64_t>( kEntry, static_cast<ULong64_t>( entry ) );
+    append<UInt_t>( kRunId, event->runId() );
+    append<UInt_t>( kLumi, event->lumi() );
+    append<ULong64_t>( kEventId, event->eventId() );
+    append<Float_t>( kVz, event->vz() );
+    append<Int_t>( kHiBin, event->hiBin() );
+    append<Float_t>( kCentralityWeight, static_cast<Float_t>( event->centralityWeight() ) );
+    append<Float_t>( kPtHat, event->ptHat() );
+    append<Float_t>( kPtHatWeight, event->ptHatWeight() );
+    append<Int_t>( kNBadRecoJets, event->numberOfOverscaledRecoJets() );
+    append<Int_t>( kMult, event->multiplicity() );
+    append<ULong64_t>( kTriggerMask, event->trigAndSkim()->mask() );
+    append<UChar_t>( kGenJetsFilled, event->isGenJetCollectionFilled() ? 1 : 0 );
+    append<ULong64_t>( kRecoJetBegin, fNRecoJets );
+    append<ULong64_t>( kGenJetBegin, fNGenJets );
+    fNEvents++;
+
+    for (const RecoJet *jet : *event->recoJetCollection()) {
+        append<UInt_t>( kRecoId, jet->id() );
+        append<Float_t>( kRecoRawPt, jet->rawPt() );
+        append<Float_t>( kRecoPtJECCorr, jet->ptJECCorr() );
+        append<Float_t>( kRecoEta, jet->eta() );
+        append<Float_t>( kRecoPhi, jet->phi() );
+        append<Float_t>( kRecoWTAEta, jet->WTAEta() );
+        append<Float_t>( kRecoWTAPhi, jet->WTAPhi() );
+        append<Float_t>( kRecoTrackMaxPt, jet->trackMaxPt() );
+        append<Int_t>( kRecoGenJetId, jet->genJetId() );
+        append<Float_t>( kRecoPfNHF, jet->jtPfNHF() );
+        append<Float_t>( kRecoPfNEF, jet->jtPfNEF() );
+        append<Float_t>( kRecoPfCHF, jet->jtPfCHF() );
+        append<Float_t>( kRecoPfMUF, jet->jtPfMUF() );
+        append<Float_t>( kRecoPfCEF, jet->jtPfCEF() );
+        append<UChar_t>( kRecoPfCHM, static_cast<UChar_t>( jet->jtPfCHM() ) );
+        append<UChar_t>( kRecoPfCEM, static_cast<UChar_t>( jet->jtPfCEM() ) );
+        append<UChar_t>( kRecoPfNHM, static_cast<UChar_t>( jet->jtPfNHM() ) );
+        append<UChar_t>( kRecoPfNEM, static_cast<UChar_t>( jet->jtPfNEM() ) );
+        append<UChar_t>( kRecoPfMUM, static_cast<UChar_t>( jet->jtPfMUM() ) );
+        fNRecoJets++;
+    }
+    for (const GenJet *jet : *event->genJetCollection()) {
+        append<UInt_t>( kGenId, jet->id() );
+        append<Float_t>( kGenPt, jet->pt() );
+        append<Float_t>( kGenEta, jet->eta() );
+        append<Float_t>( kGenPhi, jet->phi() );
+        append<Float_t>( kGenWTAEta, jet->WTAEta() );
+        append<Float_t>( kGenWTAPhi, jet->WTAPhi() );
+        append<Int_t>( kGenFlavor, jet->flavor() );
+        append<Int_t>( kGenFlavorForB, jet->flavorForB() );
+        fNGenJets++;
+    }
+}
+
+//________________
+bool JetCache::write(const char *fileName, const ULong64_t& key, const Long64_t& nEntries,
+                     const std::string& collectionName) const {
+
+    // Jet ranges of the events end with the total number of jets: the value is
+    // written right after the begin column (the columns are not copied)
+    auto columnSize = [this](const int& iColumn) {
+        const size_t size = fColumns[iColumn].size();
+        return ( iColumn == kRecoJetBegin || iColumn == kGenJetBegin ) ? size + sizeof(ULong64_t) : size;
+    };
+
+    Header header{};
+    std::memcpy( header.magic, kMagic, sizeof(kMagic) );
+    header.version = kVersion;
+    header.headerSize = sizeof(Header);
+    header.key = key;
+    header.nEvents = fNEvents;
+    header.nRecoJets = fNRecoJets;
+    header.nGenJets = fNGenJets;
+    header.nEntries = nEntries;
+    std::strncpy( header.collectionName, collectionName.c_str(), sizeof(header.collectionName) - 1 );
+    size_t offset = aligned( sizeof(Header) );
+    for (int iColumn{0}; iColumn<kNColumns; iColumn++) {
+        header.offsets[iColumn] = offset;
+        offset = aligned( offset + columnSize( iColumn ) );
+    }
+
+    // Readers never see a partially written file
+    TString tmpFileName = Form("%s.tmp.%d", fileName, (int)getpid());
+    std::ofstream file( tmpFileName.Data(), std::ios::binary | std::ios::trunc );
+    if ( !file.is_open() ) {
+        std::cerr << "[ERROR] JetCache::write - cannot open file " << tmpFileName.Data() << std::endl;
+        return false;
+    }
+    const char padding[kAlignment] = {};
+    file.write( reinterpret_cast<const char*>( &header ), sizeof(Header) );
+    size_t position = sizeof(Header);
+    for (int iColumn{0}; iColumn<kNColumns; iColumn++) {
+        file.write( padding, header.offsets[iColumn] - position );
+        file.write( fColumns[iColumn].data(), fColumns[iColumn].size() );
+        if ( iColumn == kRecoJetBegin ) file.write( reinterpret_cast<const char*>( &fNRecoJets ), sizeof(ULong64_t) );
+        if ( iColumn == kGenJetBegin ) file.write( reinterpret_cast<const char*>( &fNGenJets ), sizeof(ULong64_t) );
+        position = header.offsets[iColumn] + columnSize( iColumn );
+    }
+    file.close();
+    if ( !file || std::rename( tmpFileName.Data(), fileName ) != 0 ) {
+        std::cerr << "[ERROR] JetCache::write - cannot write file " << fileName << std::endl;
+        std::remove( tmpFileName.Data() );
+        return false;
+    }
+    return true;
+}
+
+//________________
+bool JetCache::map(const char *fileName, const ULong64_t& key) {
+
+    unmap();
+    int fd = open( fileName, O_RDONLY );
+    if ( fd < 0 ) return false;
+    struct stat info;
+    if ( fstat( fd, &info ) != 0 || static_cast<size_t>( info.st_size ) < sizeof(Header) ) {
+        close( fd );
+        return false;
+    }
+    fMapSize = static_cast<size_t>( info.st_size );
+    fMap = mmap( nullptr, fMapSize, PROT_READ, MAP_SHARED, fd, 0 );
+    // Mapping stays valid after the descriptor is closed
+    close( fd );
+    if ( fMap == MAP_FAILED ) {
+        fMap = nullptr;
+        fMapSize = 0;
+        return false;
+    }
+
+    const Header *header = static_cast<const Header*>( fMap );
+    bool isValid = ( std::memcmp( header->magic, kMagic, sizeof(kMagic) ) == 0 &&
+                     header->version == kVersion && header->headerSize == sizeof(Header) &&
+                     header->key == key );
+    for (int iColumn{0}; isValid && iColumn<kNColumns; iColumn++) {
+        const ULong64_t length = columnLength( iColumn, header->nEvents, header->nRecoJets, header->nGenJets );
+        isValid = ( header->offsets[iColumn] % kAlignment == 0 &&
+                    header->offsets[iColumn] + length * elementSize( iColumn ) <= fMapSize );
+    }
+    if ( !isValid ) {
+        std::cout << Form("[WARNING] JetCache::map - %s is not a valid cache of this input. It will be rebuilt\n", fileName);
+        unmap();
+        return false;
+    }
+
+    // Events are read in order
+    madvise( fMap, fMapSize, MADV_SEQUENTIAL );
+    fHeader = header;
+    return true;
+}
+
+//________________
+void JetCache::unmap() {
+    if ( fMap ) {
+        munmap( fMap, fMapSize );
+    }
+    fMap = nullptr;
+    fMapSize = 0;
+    fHeader = nullptr;
+}
+
+//________________
+ULong64_t JetCache::nEvents() const {
+    return ( fHeader ) ? fHeader->nEvents : fNEvents;
+}
+
+//________________
+Long64_t JetCache::nEntries() const {
+    return ( fHeader ) ? fHeader->nEntries : 0;
+}
+
+//________________
+std::string JetCache::collectionName() const {
+    return ( fHeader ) ? std::string( fHeader->collectionName ) : std::string();
+}
+
+//________________
+void JetCache::fillEvent(const ULong64_t& iEvent, Event *event) const {
+
+    event->setRunId( column<UInt_t>(kRunId)[iEvent] );
+    event->setEventId( column<ULong64_t>(kEventId)[iEvent] );
+    event->setLumi( column<UInt_t>(kLumi)[iEvent] );
+    event->setVz( column<Float_t>(kVz)[iEvent] );
+    event->setHiBin( column<Int_t>(kHiBin)[iEvent] );
+    event->setCentralityWeight( column<Float_t>(kCentralityWeight)[iEvent] );
+    event->setPtHat( column<Float_t>(kPtHat)[iEvent] );
+    event->setPtHatWeight( column<Float_t>(kPtHatWeight)[iEvent] );
+    event->setNumberOfOverscaledRecoJets( column<Int_t>(kNBadRecoJets)[iEvent] );
+    event->setMultiplicity( column<Int_t>(kMult)[iEvent] );
+    event->trigAndSkim()->setMask( column<ULong64_t>(kTriggerMask)[iEvent] );
+    event->setRecoJetCollectionName( fHeader->collectionName );
+
+    const ULong64_t *genBegin = column<ULong64_t>(kGenJetBegin);
+    for (ULong64_t iJet=genBegin[iEvent]; iJet<genBegin[iEvent + 1]; iJet++) {
+        GenJet *jet = event->newGenJet();
+        jet->setId( column<UInt_t>(kGenId)[iJet] );
+        jet->setPt( column<Float_t>(kGenPt)[iJet] );
+        jet->setEta( column<Float_t>(kGenEta)[iJet] );
+        jet->setPhi( column<Float_t>(kGenPhi)[iJet] );
+        jet->setWTAEta( column<Float_t>(kGenWTAEta)[iJet] );
+        jet->setWTAPhi( column<Float_t>(kGenWTAPhi)[iJet] );
+        jet->setFlavor( column<Int_t>(kGenFlavor)[iJet] );
+        jet->setFlavorForB( column<Int_t>(kGenFlavorForB)[iJet] );
+        jet->setPtWeight( 1. );
+        event->genJetCollection()->push_back( jet );
+    }
+    if ( column<UChar_t>(kGenJetsFilled)[iEvent] ) {
+        event->setGenJetCollectionIsFilled();
+    }
+
+    const ULong64_t *recoBegin = column<ULong64_t>(kRecoJetBegin);
+    for (ULong64_t iJet=recoBegin[iEvent]; iJet<recoBegin[iEvent + 1]; iJet++) {
+        RecoJet *jet = event->newRecoJet();
+        jet->setId( column<UInt_t>(kRecoId)[iJet] );
+        jet->setRawPt( column<Float_t>(kRecoRawPt)[iJet] );
+        jet->setPtJECCorr( column<Float_t>(kRecoPtJECCorr)[iJet] );
+        jet->setEta( column<Float_t>(kRecoEta)[iJet] );
+        jet->setPhi( column<Float_t>(kRecoPhi)[iJet] );
+        jet->setWTAEta( column<Float_t>(kRecoWTAEta)[iJet] );
+        jet->setWTAPhi( column<Float_t>(kRecoWTAPhi)[iJet] );
+        jet->setTrackMaxPt( column<Float_t>(kRecoTrackMaxPt)[iJet] );
+        jet->setGenJetId( column<Int_t>(kRecoGenJetId)[iJet] );
+        jet->setJtPfNHF( column<Float_t>(kRecoPfNHF)[iJet] );
+        jet->setJtPfNEF( column<Float_t>(kRecoPfNEF)[iJet] );
+        jet->setJtPfCHF( column<Float_t>(kRecoPfCHF)[iJet] );
+        jet->setJtPfMUF( column<Float_t>(kRecoPfMUF)[iJet] );
+        jet->setJtPfCEF( column<Float_t>(kRecoPfCEF)[iJet] );
+        jet->setJtPfCHM( column<UChar_t>(kRecoPfCHM)[iJet] );
+        jet->setJtPfCEM( column<UChar_t>(kRecoPfCEM)[iJet] );
+        jet->setJtPfNHM( column<UChar_t>(kRecoPfNHM)[iJet] );
+        jet->setJtPfNEM( column<UChar_t>(kRecoPfNEM)[iJet] );
+        jet->setJtPfMUM( column<UChar_t>(kRecoPfMUM)[iJet] );
+        event->recoJetCollection()->push_back( jet );
+    }
+}
+
+//________________
+ULong64_t JetCache::hash(const void *data, const size_t& size, const ULong64_t& seed) {
+    const unsigned char *bytes = static_cast<const unsigned char*>( data );
+    ULong64_t value = seed;
+    for (size_t i{0}; i<size; i++) {
+        value ^= bytes[i];
+        value *= 1099511628211ULL;
+    }
+    return value;
+}
+
+//________________
+ULong64_t JetCache::fileHash(const std::string& fileName, const ULong64_t& seed) {
+    ULong64_t value = hash( fileName, seed );
+    struct stat info;
+    if ( stat( fileName.c_str(), &info ) == 0 ) {
+        const Long64_t size = static_cast<Long64_t>( info.st_size );
+        const Long64_t modified = static_cast<Long64_t>( info.st_mtime );
+        value = hash( &size, sizeof(size), value );
+        value = hash( &modified, sizeof(modified), value );
+    }
+    return value;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file JetCache.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Flat columnar file of events and calibrated jets read through mmap
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef JetCache_h
+#define JetCache_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class Event;
+
+//________________
+class JetCache {
+  public:
+    /// @brief Format version. Must be increased when columns change
+    static const UInt_t kVersion = 1;
+
+    /// @brief Columns of the cache. Event columns have one element per event, jet
+    /// ranges nEvents + 1 elements and jet columns one element per jet
+    enum Column {
+        // Events
+        kEntry = 0, kRunId, kLumi, kEventId, kVz, kHiBin, kCentralityWeight, kPtHat, kPtHatWeight,
+        kNBadRecoJets, kMult, kTriggerMask, kGenJetsFilled,
+        // First jet of each event
+        kRecoJetBegin, kGenJetBegin,
+        // Reco jets
+        kRecoId, kRecoRawPt, kRecoPtJECCorr, kRecoEta, kRecoPhi, kRecoWTAEta, kRecoWTAPhi, 
+        kRecoTrackMaxPt, kRecoGenJetId, kRecoPfNHF, kRecoPfNEF, kRecoPfCHF, kRecoPfMUF, kRecoPfCEF,
+        kRecoPfCHM, kRecoPfCEM, kRecoPfNHM, kRecoPfNEM, kRecoPfMUM,
+        // Gen jets
+        kGenId, kGenPt, kGenEta, kGenPhi, kGenWTAEta, kGenWTAPhi, kGenFlavor, kGenFlavorForB,
+        kNColumns
+    };
+
+    /// @brief Constructor
+    JetCache();
+    /// @brief Destructor (unmaps the file)
+    virtual ~JetCache();
+
+    //
+    // Writing
+    //
+
+    /// @brief Remove events added for writing
+    void clear();
+    /// @brief Add event with its main reco jet collection and gen jets
+    /// @param entry Chain entry the event was read from
+    void addEvent(const Long64_t& entry, const Event *event);
+    /// @brief Write added events (via a temporary file renamed at the end)
+    /// @param nEntries Number of chain entries the events were selected from
+    bool write(const char *fileName, const ULong64_t& key, const Long64_t& nEntries,
+               const std::string& collectionName) const;
+
+    //
+    // Reading
+    //
+
+    /// @brief Map the file. Fails if the file is missing, damaged, of another version or key
+    bool map(const char *fileName, const ULong64_t& key);
+    /// @brief Unmap the file
+    void unmap();
+    /// @brief File is mapped
+    bool isMapped() const { return ( fHeader != nullptr ); }
+    /// @brief Number of events (mapped or added)
+    ULong64_t nEvents() const;
+    /// @brief Number of chain entries the events were selected from
+    Long64_t nEntries() const;
+    /// @brief Name of the reco jet collection
+    std::string collectionName() const;
+    /// @brief Chain entry of the event
+    Long64_t entry(const ULong64_t& iEvent) const { return static_cast<Long64_t>( column<ULong64_t>(kEntry)[iEvent] ); }
+    /// @brief Return the mapped column
+    template <typename T> const T *column(const int& iColumn) const
+    { return reinterpret_cast<const T*>( static_cast<const char*>( fMap ) + fHeader->offsets[iColumn] ); }
+    /// @brief Fill the event and its jets from the mapped columns
+    void fillEvent(const ULong64_t& iEvent, Event *event) const;
+
+    //
+    // Cache key
+    //
+
+    /// @brief 64-bit FNV-1a hash of the bytes
+    static ULong64_t hash(const void *data, const size_t& size, const ULong64_t& seed = 14695981039346656037ULL);
+    /// @brief Hash of the string
+    static ULong64_t hash(const std::string& text, const ULong64_t& seed) { return hash( text.data(), text.size(), seed ); }
+    /// @brief Hash of the file name, size and modification time (name only if the file is not local)
+    static ULong64_t fileHash(const std::string& fileName, const ULong64_t& seed);
+
+  private:
+    /// @brief File header
+    struct Header {
+        char      magic[8];
+        UInt_t    version;
+        UInt_t    headerSize;
+        ULong64_t key;
+        ULong64_t nEvents;
+        ULong64_t nRecoJets;
+        ULong64_t nGenJets;
+        Long64_t  nEntries;
+        char      collectionName[128];
+        ULong64_t offsets[kNColumns];
+    };
+
+    /// @brief Size of the column element in bytes
+    static size_t elementSize(const int& iColumn);
+    /// @brief Number of elements of the column
+    static ULong64_t columnLength(const int& iColumn, const ULong64_t& nEvents, 
+                                  const ULong64_t& nRecoJets, const ULong64_t& nGenJets);
+    /// @brief Append value to the column being written
+    template <typename T> void append(const int& iColumn, const T& value) {
+        std::vector<char>& column = fColumns[iColumn];
+        const size_t size = column.size();
+        column.resize( size + sizeof(T) );
+        std::memcpy( column.data() + size, &value, sizeof(T) );
+    }
+
+    /// @brief Columns being written
+    std::vector< std::vector<char> > fColumns;
+    /// @brief Number of added events and jets
+    ULong64_t fNEvents;
+    ULong64_t fNRecoJets;
+    ULong64_t fNGenJets;
+
+    /// @brief Mapped file
+    void *fMap;
+    /// @brief Size of the mapped file
+    size_t fMapSize;
+    /// @brief Header of the mapped file
+    const Header *fHeader;
+};
+
+#endif // #define JetCache_h
@@ -0,0 +1,341 @@
+/**
+ * @file JetCacheReader.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Reader that keeps events with calibrated jets of another reader in a memory-mapped cache
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "JetCacheReader.h"
+
+// ROOT headers
+#include "TSystem.h"
+
+// C++ headers
+#include <iostream>
+#include <algorithm>
+
+//_________________
+JetCacheReader::JetCacheReader(BaseReader *reader, const char *cacheDir) : BaseReader(),
+    fReader{reader}, fCache{}, fEventPool{nullptr}, fCacheDir{cacheDir}, fCacheTag{}, fCacheFileName{},
+    fCacheKey{0}, fIsInitialized{false}, fIsCacheHit{false}, fIsFillingCache{false}, fIsCacheBypassed{false},
+    fEntriesRead{0},
+    fCollectionName{}, fEntriesInChain{0}, fEntriesInRange{0}, fEvents2Read{0},
+    fFirstEvent{0}, fCurrentEvent{0}, fEndEvent{0} {
+    if ( !fReader ) {
+        std::cerr << "[ERROR] JetCacheReader::JetCacheReader - no input reader. Terminating" << std::endl;
+        exit(1);
+    }
+    fEventPool = new EventPool{};
+}
+
+//_________________
+JetCacheReader::~JetCacheReader() {
+    if (fEventPool) delete fEventPool;
+    if (fReader) delete fReader;
+}
+
+//_________________
+int JetCacheReader::init() {
+
+    // Input reader provides the cache key (its files are known after init)
+    fIsCacheBypassed = fReader->hasUncachedContent();
+    int status = fReader->init();
+    fIsInitialized = {true};
+    if ( fIsCacheBypassed ) {
+        std::cout << "[WARNING] JetCacheReader::init - input reader reads tracks or additional jet collections "
+                  << "that are not cached. Events are read from the input reader, the cache is not used" << std::endl;
+        return status;
+    }
+    setupCacheKey();
+
+    if ( fCache.map( fCacheFileName.Data(), fCacheKey ) && fCache.nEntries() == fReader->nEntriesInChain() ) {
+        fIsCacheHit = {true};
+        fEntriesInChain = fCache.nEntries();
+        std::cout << Form("JetCacheReader: %llu events of %lld entries are read from %s\n",
+                          fCache.nEvents(), fEntriesInChain, fCacheFileName.Data());
+        applyEntryRange();
+        return status;
+    }
+
+    fCache.unmap();
+    checkFullPass();
+    if ( fIsFillingCache ) {
+        std::cout << Form("JetCacheReader: no cache found. It will be written to %s\n", fCacheFileName.Data());
+    }
+    else {
+        std::cout << "[WARNING] JetCacheReader::init - no cache found. The cache is written only when "
+                  << "the whole input is read without sampling" << std::endl;
+    }
+    return status;
+}
+
+//_________________
+void JetCacheReader::setupCacheKey() {
+
+    std::vector<std::string> files;
+    std::string settings;
+    fReader->cacheKey( files, settings );
+
+    ULong64_t key = JetCache::hash( &JetCache::kVersion, sizeof(JetCache::kVersion) );
+    for (const auto& file : files) {
+        key = JetCache::fileHash( file, key );
+    }
+    key = JetCache::hash( settings, key );
+    key = JetCache::hash( std::string( fCacheTag.Data() ), key );
+    fCacheKey = key;
+
+    if ( files.empty() ) {
+        std::cout << "[WARNING] JetCacheReader::setupCacheKey - input reader does not provide its files. "
+                  << "Cache key depends on the cache tag only" << std::endl;
+    }
+    fCacheFileName = Form("%s/jetCache_%016llx.bin", fCacheDir.Data(), fCacheKey);
+}
+
+//_________________
+void JetCacheReader::checkFullPass() {
+    fIsFillingCache = ( !fIsCacheBypassed && fReader->firstEntry() == 0 && fReader->nEntriesInChain() > 0 &&
+                        fReader->nEntriesInRange() == fReader->nEntriesInChain() &&
+                        fReader->samplingStep() <= 1 );
+    if ( !fIsFillingCache ) {
+        fCache.clear();
+    }
+}
+
+//_________________
+Event* JetCacheReader::returnEvent() {
+
+    if ( !fIsCacheHit ) {
+        Event *event = fReader->returnEvent();
+        fReaderStatus = fReader->status();
+        if ( fIsFillingCache && fReaderStatus == 0 ) {
+            // Full pass without sampling: chain entry is the number of entries read
+            if ( event ) {
+                fCache.addEvent( fEntriesRead, event );
+                fCollectionName = event->recoJetCollectionName();
+            }
+            fEntriesRead++;
+        }
+        return event;
+    }
+
+    // Skip events of the entries that are not sampled
+    while ( fCurrentEvent < fEndEvent && !isSampledEntry( fCache.entry( fCurrentEvent ) ) ) {
+        fCurrentEvent++;
+    }
+    if ( fCurrentEvent >= fEndEvent ) {
+        std::cerr << "JetCacheReader::returnEvent() out of cached events\n";
+        fReaderStatus = 2; // End of input stream
+        return nullptr;
+    }
+
+    Event *event = fEventPool->get();
+    fCache.fillEvent( fCurrentEvent, event );
+    fCurrentEvent++;
+    return event;
+}
+
+//_________________
+void JetCacheReader::recycleEvent(Event *event) {
+    if ( fIsCacheHit ) {
+        fEventPool->put( event );
+    }
+    else {
+        fReader->recycleEvent( event );
+    }
+}
+
+//_________________
+void JetCacheReader::finish() {
+    fReader->finish();
+    if ( fIsCacheHit || !fIsFillingCache ) return;
+
+    if ( fEntriesRead != fReader->nEntriesInChain() ) {
+        std::cout << Form("[WARNING] JetCacheReader::finish - %lld of %lld entries were read. Cache is not written\n",
+                          fEntriesRead, fReader->nEntriesInChain());
+        return;
+    }
+    gSystem->mkdir( fCacheDir.Data(), kTRUE );
+    if ( fCache.write( fCacheFileName.Data(), fCacheKey, fEntriesRead, fCollectionName ) ) {
+        std::cout << Form("JetCacheReader: %llu events of %lld entries are written to %s\n",
+                          fCache.nEvents(), fEntriesRead, fCacheFileName.Data());
+    }
+    fCache.clear();
+}
+
+//_________________
+void JetCacheReader::report() {
+    if ( fIsCacheBypassed ) {
+        std::cout << "JetCacheReader: cache bypassed (tracks or additional jet collections are read)\n";
+    }
+    else {
+        std::cout << Form("JetCacheReader: cache %s (%s)\n", fCacheFileName.Data(), 
+                          ( fIsCacheHit ) ? "hit" : ( fIsFillingCache ? "filled by this run" : "not used" ));
+    }
+    fReader->report();
+}
+
+//_________________
+Long64_t JetCacheReader::nEventsTotal() const {
+    return ( fIsCacheHit ) ? fEvents2Read : fReader->nEventsTotal();
+}
+
+//_________________
+Long64_t JetCacheReader::nEntriesInChain() const {
+    return ( fIsCacheHit ) ? fEntriesInChain : fReader->nEntriesInChain();
+}
+
+//_________________
+Long64_t JetCacheReader::nEntriesInRange() const {
+    return ( fIsCacheHit ) ? fEntriesInRange : fReader->nEntriesInRange();
+}
+
+//_________________
+Long64_t JetCacheReader::entryNumber(const Long64_t& iEvent) const {
+    if ( !fIsCacheHit ) return fReader->entryNumber( iEvent );
+    // Entry of the iEvent-th sampled event of the range
+    Long64_t nSampled{0};
+    for (ULong64_t iCached=fFirstEvent; iCached<fEndEvent; iCached++) {
+        if ( !isSampledEntry( fCache.entry( iCached ) ) ) continue;
+        if ( nSampled++ == iEvent ) return fCache.entry( iCached );
+    }
+    return fFirstEntry + fEntriesInRange;
+}
+
+//_________________
+void JetCacheReader::setEntryRange(const Long64_t& first, const Long64_t& last) {
+    BaseReader::setEntryRange(first, last);
+    if ( fIsCacheHit ) {
+        applyEntryRange();
+        return;
+    }
+    fReader->setEntryRange(first, last);
+    if ( fIsInitialized ) checkFullPass();
+}
+
+//_________________
+void JetCacheReader::setShard(const int& index, const int& nShards) {
+    BaseReader::setShard(index, nShards);
+    if ( fIsCacheHit ) {
+        applyEntryRange();
+        return;
+    }
+    fReader->setShard(index, nShards);
+    if ( fIsInitialized ) checkFullPass();
+}
+
+//_________________
+void JetCacheReader::setSampling(const Long64_t& step, const Long64_t& blockSize) {
+    BaseReader::setSampling(step, blockSize);
+    if ( fIsCacheHit ) {
+        applyEntryRange();
+        return;
+    }
+    fReader->setSampling(step, blockSize);
+    if ( fIsInitialized ) checkFullPass();
+}
+
+//_________________
+void JetCacheReader::setSamplingOrigin(const Long64_t& entry) {
+    BaseReader::setSamplingOrigin( entry );
+    fReader->setSamplingOrigin( entry );
+}
+
+//_________________
+Long64_t JetCacheReader::samplingOrigin() const {
+    return ( fIsCacheHit ) ? fSamplingOrigin : fReader->samplingOrigin();
+}
+
+//_________________
+void JetCacheReader::entryTasks(std::vector<EntryTask>& tasks) const {
+
+    if ( !fIsCacheHit ) {
+        // A single reader must see the whole input to write the cache
+        if ( fIsFillingCache ) {
+            tasks.push_back( EntryTask{ fReader->firstEntry(), fReader->firstEntry() + fReader->nEntriesInRange() } );
+        }
+        else {
+            fReader->entryTasks( tasks );
+        }
+        return;
+    }
+
+    // Cached events are cheap: tasks of a fixed number of entries
+    const Long64_t last = fFirstEntry + fEntriesInRange;
+    std::vector<Long64_t> taskEnds;
+    for (Long64_t end=fFirstEntry+100000; end<last; end+=100000) {
+        taskEnds.push_back( end );
+    }
+    clusterTasks( taskEnds, last, tasks );
+}
+
+//_________________
+void JetCacheReader::startTask(const EntryTask& task) {
+    if ( fIsCacheHit ) {
+        BaseReader::setEntryRange(task.first, task.last);
+        applyEntryRange( false );
+        return;
+    }
+    BaseReader::setEntryRange(task.first, task.last);
+    fReader->startTask( task );
+    checkFullPass();
+}
+
+//_________________
+void JetCacheReader::setRequiredInputs(const InputRequirements& inputs) {
+    BaseReader::setRequiredInputs( inputs );
+    // Cached events would miss tracks, track views and additional jet collections:
+    // the input reader is used directly with the requirements of the analyses
+    fIsCacheBypassed = fReader->hasUncachedContent();
+    if ( fIsCacheBypassed ) {
+        fReader->setRequiredInputs( inputs );
+        return;
+    }
+    // Cached events are used by other analyses later: the input reader reads everything
+    InputRequirements all{};
+    all.requireAll();
+    fReader->setRequiredInputs( all );
+}
+
+//_________________
+void JetCacheReader::setStageStats(StageStats *stats) {
+    BaseReader::setStageStats( stats );
+    fReader->setStageStats( stats );
+}
+
+//_________________
+void JetCacheReader::setEventsAreQueued(const bool& queued) {
+    BaseReader::setEventsAreQueued( queued );
+    fReader->setEventsAreQueued( queued );
+}
+
+//_________________
+void JetCacheReader::applyEntryRange(const bool& verbose) {
+    const Long64_t last = resolveEntryRange( fEntriesInChain );
+    fEntriesInRange = last - fFirstEntry;
+
+    // Cached events are sorted by entry
+    const ULong64_t *entries = fCache.column<ULong64_t>( JetCache::kEntry );
+    const ULong64_t nEvents = fCache.nEvents();
+    fFirstEvent = std::lower_bound( entries, entries + nEvents, static_cast<ULong64_t>( fFirstEntry ) ) - entries;
+    fEndEvent = std::lower_bound( entries, entries + nEvents, static_cast<ULong64_t>( last ) ) - entries;
+    fCurrentEvent = fFirstEvent;
+
+    fEvents2Read = fEndEvent - fFirstEvent;
+    if ( fSamplingStep > 1 ) {
+        fEvents2Read = 0;
+        for (ULong64_t iCached=fFirstEvent; iCached<fEndEvent; iCached++) {
+            if ( isSampledEntry( fCache.entry( iCached ) ) ) fEvents2Read++;
+        }
+    }
+    fReaderStatus = 0;
+
+    if ( verbose && fEntriesInRange != fEntriesInChain ) {
+        std::cout << Form("Entry range to read: [%lld, %lld). Number of cached events to read: %lld\n", 
+                          fFirstEntry, last, fEvents2Read );
+    }
+}
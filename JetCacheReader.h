@@ -0,0 +1,143 @@
+/**
+ * @file JetCacheReader.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Reader that keeps events with calibrated jets of another reader in a memory-mapped cache
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef JetCacheReader_h
+#define JetCacheReader_h
+
+// ROOT headers
+#include "Rtypes.h"
+#include "TString.h"
+
+// JetAnalysis headers
+#include "BaseReader.h"
+#include "Event.h"
+#include "EventPool.h"
+#include "JetCache.h"
+
+// C++ headers
+#include <string>
+#include <vector>
+
+//_________________
+class JetCacheReader : public BaseReader {
+
+  public:
+    /// @brief Constructor
+    /// @param reader Reader of the input (owned). Its events (after corrections and cuts)
+    /// are written to the cache by the first full pass over the input
+    /// @param cacheDir Directory of the cache files
+    JetCacheReader(BaseReader *reader, const char *cacheDir = ".");
+    /// @brief Destructor
+    virtual ~JetCacheReader();
+
+    /// @brief Initialize the input reader and map the cache if it exists
+    int init();
+    /// @brief Prepare input of the input reader
+    void prepareInput() { fReader->prepareInput(); }
+    /// @brief Write the cache if the whole input was read
+    void finish();
+    /// @brief Return event from the cache or from the input reader
+    Event* returnEvent();
+    /// @brief Report cache status and the input reader
+    void report();
+    /// @brief Return event to the reader it came from
+    void recycleEvent(Event *event);
+
+    /// @brief Add settings that are not known to the input reader (e.g. cuts) to the cache key
+    void setCacheTag(const char *tag) { fCacheTag = tag; }
+    /// @brief Events are read from the cache
+    bool isCacheHit() const { return fIsCacheHit; }
+    /// @brief Cache is not used: events of the input reader carry content that is not cached
+    bool isCacheBypassed() const { return fIsCacheBypassed; }
+
+    /// @brief Return amount of events to read
+    Long64_t nEventsTotal() const;
+    /// @brief Return number of entries in the input chain
+    Long64_t nEntriesInChain() const;
+    /// @brief Return number of entries in the entry range (before sampling)
+    Long64_t nEntriesInRange() const;
+    /// @brief Return chain entry of the iEvent-th event to be read
+    Long64_t entryNumber(const Long64_t& iEvent) const;
+    /// @brief Read only entries [first, last) of the input chain
+    void setEntryRange(const Long64_t& first, const Long64_t& last = -1);
+    /// @brief Read only shard index of nShards equal parts of the entry range
+    void setShard(const int& index, const int& nShards);
+    /// @brief Read only the first of every step blocks of blockSize consecutive entries
+    void setSampling(const Long64_t& step, const Long64_t& blockSize = 1);
+    /// @brief Set sampling origin of the cache and of the input reader
+    void setSamplingOrigin(const Long64_t& entry = -1);
+    /// @brief Return sampling origin of the cache or of the input reader
+    Long64_t samplingOrigin() const;
+    /// @brief Split the entry range into tasks. Without the cache the range is read by a
+    /// single task: the cache is written only by a reader that read the whole input
+    void entryTasks(std::vector<EntryTask>& tasks) const;
+    /// @brief Read entries of the task
+    void startTask(const EntryTask& task);
+    /// @brief Set input requirements. The input reader reads everything to fill the cache.
+    /// The cache is bypassed if the input reader reads content that is not cached (e.g. tracks)
+    void setRequiredInputs(const InputRequirements& inputs);
+    /// @brief Set stats of the reading stages
+    void setStageStats(StageStats *stats);
+    /// @brief Events are queued
+    void setEventsAreQueued(const bool& queued = true);
+
+  private:
+    /// @brief Cache key of the input reader and cache file name
+    void setupCacheKey();
+    /// @brief Select cached events of the entry range
+    void applyEntryRange(const bool& verbose = true);
+    /// @brief Input reader reads the whole input: its events can be written to the cache
+    void checkFullPass();
+
+    /// @brief Reader of the input (owned)
+    BaseReader *fReader;
+    /// @brief Cache (mapped or being filled)
+    JetCache fCache; //!
+    /// @brief Events filled from the cache
+    EventPool *fEventPool;
+    /// @brief Directory of the cache files
+    TString fCacheDir;
+    /// @brief User settings added to the cache key
+    TString fCacheTag;
+    /// @brief Cache file name
+    TString fCacheFileName;
+    /// @brief Cache key
+    ULong64_t fCacheKey;
+    /// @brief Reader is initialized
+    bool fIsInitialized;
+    /// @brief Events are read from the cache
+    bool fIsCacheHit;
+    /// @brief Events of the input reader are added to the cache
+    bool fIsFillingCache;
+    /// @brief Cache is not used: events of the input reader carry content that is not cached
+    bool fIsCacheBypassed;
+    /// @brief Entries read by the input reader while filling the cache
+    Long64_t fEntriesRead;
+    /// @brief Name of the reco jet collection of the input reader
+    std::string fCollectionName;
+
+    /// @brief Number of input entries in the cache
+    Long64_t fEntriesInChain;
+    /// @brief Number of input entries in the entry range
+    Long64_t fEntriesInRange;
+    /// @brief Number of cached events to read
+    Long64_t fEvents2Read;
+    /// @brief First cached event of the entry range
+    ULong64_t fFirstEvent;
+    /// @brief Next cached event to read
+    ULong64_t fCurrentEvent;
+    /// @brief Cached event after the entry range
+    ULong64_t fEndEvent;
+
+    ClassDef(JetCacheReader, 0)
+};
+
+#endif // #define JetCacheReader_h
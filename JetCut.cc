@@ -71,6 +71,26 @@ void JetCut::report() {
     std::cout << report.Data() << std::endl;
 }
 
+//________________
+TString JetCut::settings() const {
+    return TString::Format( "pt=%.9g,%.9g coneR=%.9g etaLab=%.9g,%.9g etaCM=%.9g,%.9g method=%d looseJetId=%d",
+                            fPt[0], fPt[1], fConeR, fEtaLab[0], fEtaLab[1], fEtaCM[0], fEtaCM[1],
+                            fSelectionMethod, fLooseJetIdCut );
+}
+
+//________________
+void JetCut::addRequiredInputs(InputRequirements& inputs) const {
+    if ( fSelectionMethod == 1 ) {
+        // trackMaxPt/RawPt selection
+        inputs.requireJetContent( InputRequirements::kJetTrackMax );
+    }
+    else if ( fSelectionMethod == 2 ) {
+        // jetId uses PF fractions and multiplicities
+        inputs.requireJetContent( InputRequirements::kJetPFFractions | 
+                                  InputRequirements::kJetPFMultiplicities );
+    }
+}
+
 //________________
 bool JetCut::pass(const RecoJet* jet, bool isCM, bool isMC, bool requireMatching) {
 
@@ -15,9 +15,11 @@
 // Jet analysis headers
 #include "RecoJet.h"
 #include "GenJet.h"
+#include "InputRequirements.h"
 
 // ROOT headers
 #include "Rtypes.h"
+#include "TString.h"
 
 // C++ headers
 #include <limits>
@@ -79,10 +81,14 @@ class JetCut {
 
     /// @brief Report cut limits and passed/failed statistics
     void report();
+    /// @brief Return cut limits as a single line (statistics are not included)
+    TString settings() const;
     /// @brief Check if jet passes the cut 
     virtual bool pass(const RecoJet* jet, bool isCM, bool isMC, bool requireMatching);
     /// @brief Check if jet passes the cut 
     virtual bool pass(const GenJet* jet, bool isCM);
+    /// @brief Add jet content used by the selection method
+    void addRequiredInputs(InputRequirements& inputs) const;
 
 
   private:
@@ -1037,6 +1037,13 @@ void JetESRAnalysis::finish() {
     std::cout << "JetESRAnalysis::finish" << std::endl;
 }
 
+//________________
+void JetESRAnalysis::writeOutput() {
+    if ( fHM ) {
+        fHM->writeOutput();
+    }
+}
+
 //________________
 void JetESRAnalysis::report() {
     // Force to report everyone
@@ -1049,3 +1056,14 @@ TList* JetESRAnalysis::getOutputList() {
     // Add list of settings for cuts
     return outputList;
 }
+
+//________________
+void JetESRAnalysis::addRequiredInputs(InputRequirements& inputs) const {
+    // Jet kinematics and event quantities are always read.
+    // Inclusive jet histograms use PF fractions and multiplicities
+    inputs.requireJetContent( InputRequirements::kJetPFFractions | 
+                              InputRequirements::kJetPFMultiplicities );
+    // Jet cuts of the analysis (e.g. trackMax/rawPt selection)
+    if ( fRecoJetCut ) fRecoJetCut->addRequiredInputs( inputs );
+    if ( fGenJetCut ) fGenJetCut->addRequiredInputs( inputs );
+}
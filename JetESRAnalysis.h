@@ -41,11 +41,15 @@ class JetESRAnalysis : public BaseAnalysis {
     void processEvent(const Event* ev);
     /// @brief Finish analysis
     void finish();
+    /// @brief Write histograms to the current directory
+    void writeOutput();
 
     /// @brief Returns reports of all cuts applied and correlation functions being done
     virtual void report();
     /// @brief Return a TList of objects to be written as output
     virtual TList* getOutputList();
+    /// @brief Add input quantities used by the analysis (PF jet composition)
+    virtual void addRequiredInputs(InputRequirements& inputs) const;
 
     /// @brief Set centrality weight
     void useCentralityWeight()                     { fUseCentralityWeight = {true}; }
@@ -22,9 +22,11 @@
 
 #pragma link C++ class EventCut+;
 #pragma link C++ class JetCut+;
+#pragma link C++ class TrackCut+;
 #pragma link C++ class JetESRAnalysis+;
 #pragma link C++ class DiJetCut+;
 #pragma link C++ class DiJetAnalysis+;
+#pragma link C++ class DiJetTreeWriter+;
 #pragma link C++ class Manager+;
 #pragma link C++ class HistoManagerJetESR+;
 #pragma link C++ class HistoManagerDiJet+;
@@ -32,5 +34,7 @@
 
 // User-defined classes
 #pragma link C++ class ForestAODReader+;
+#pragma link C++ class DiJetTreeReader+;
+#pragma link C++ class JetCacheReader+;
 
 #endif
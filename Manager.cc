@@ -13,43 +13,262 @@
 #include "Manager.h"
 #include "Event.h"
 
+// ROOT headers
+#include "TROOT.h"
+#include "TFile.h"
+#include "TMemFile.h"
+#include "TFileMerger.h"
+#include "TH1.h"
+#include "TClass.h"
+#include "TParameter.h"
+#include "TSystem.h"
+
+// C++ headers
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/// @brief Set by SIGTERM: the last checkpoint is written and the job stops
+static volatile std::sig_atomic_t gTerminationRequested = 0;
+
 //________________
-Manager::Manager() : 
+static void handleTermination(int) {
+    gTerminationRequested = 1;
+}
+
+//________________
+Manager::Manager() :
     fAnalysisCollection{nullptr}, fEventReader{nullptr}, fTimer{nullptr},
-    fEventsInChain{0} {
+    fEventsInChain{0}, fNThreads{1}, fWorkerFactory{}, fWorkers{},
+    fEventsProcessed{0}, fReadAheadDepth{0}, fQueues{}, 
+    fSamplingStep{1}, fSamplingBlockSize{1}, fEventBudget{0}, fTimeBudget{0}, fStartTime{},
+    fLoopEventsProcessed{}, fLoopEntriesInRange{}, fLoopTime{}, fScheduler{nullptr},
+    fReaderStageStats{}, fAnalysisStageStats{}, fStageStats{}, fFirstEntry{0}, fLastEntry{-1},
+    fShardIndex{0}, fNShards{1}, fNProcesses{1}, fProcessIndex{0}, fChildPids{}, 
+    fCheckpointFileName{}, fCheckpointEvents{100000}, 
+    fCheckpointBaseFileName{}, fCheckpointEntriesInRange{0}, fOutputFileName{},
+    fCompression{ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault} {
     fAnalysisCollection = new AnalysisCollection;
 }
 
 //________________
 Manager::~Manager() {
     AnalysisIterator iter;
-    for (iter = fAnalysisCollection->begin(); 
-         iter != fAnalysisCollection->end(); 
+    for (iter = fAnalysisCollection->begin();
+         iter != fAnalysisCollection->end();
          iter++ ) {
         delete *iter;
         *iter = nullptr;
     }
+    for (auto worker : fWorkers) {
+        for (auto ana : worker->analyses) {
+            delete ana;
+        }
+        if (worker->reader) delete worker->reader;
+        delete worker;
+    }
+    for (auto queue : fQueues) {
+        delete queue;
+    }
+    if (fScheduler) delete fScheduler;
+    for (auto stats : fReaderStageStats) {
+        delete stats;
+    }
+    for (auto stats : fAnalysisStageStats) {
+        delete stats;
+    }
     if (fTimer) delete fTimer;
     if (fEventReader) delete fEventReader;
 }
 
 //________________
 void Manager::init() {
+
+    if ( fNProcesses > 1 ) {
+        if ( fCheckpointFileName.Length() > 0 || fOutputFileName.Length() <= 0 ) {
+            std::cout << "[WARNING] Manager::init - several processes need an output file name and no checkpoints. "
+                      << "Events will be processed by a single process" << std::endl;
+            fNProcesses = 1;
+        }
+        else {
+            // Input files are validated once: forked processes reuse the result and
+            // do not write the same entry manifest concurrently
+            if ( fEventReader ) fEventReader->prepareInput();
+            // Must be done before the chains are set up or any event loop thread is started
+            forkProcesses();
+        }
+    }
+
+    if ( fNThreads > 1 || fReadAheadDepth > 0 ) {
+        // Several chains are read in parallel
+        ROOT::EnableThreadSafety();
+        // Histograms of different workers have the same names
+        TH1::AddDirectory(kFALSE);
+    }
+
     if (fEventReader) {
+        // Entry range (and shard of it) must be known before the reader is initialized
+        if ( fFirstEntry > 0 || fLastEntry >= 0 ) {
+            fEventReader->setEntryRange(fFirstEntry, fLastEntry);
+        }
+        if ( fNShards > 1 ) {
+            fEventReader->setShard(fShardIndex, fNShards);
+        }
+        fEventReader->setSampling(fSamplingStep, fSamplingBlockSize);
+        // Read only quantities used by the analyses
+        if ( !fAnalysisCollection->empty() ) {
+            InputRequirements inputs;
+            for (auto ana : *fAnalysisCollection) {
+                ana->addRequiredInputs( inputs );
+            }
+            fEventReader->setRequiredInputs( inputs );
+        }
         fEventReader->init();
         fEventReader->report();
+
+        // Each process takes its part of the entry range. Sampling blocks stay
+        // anchored to the whole range (set by init()), so the processes read the same entries
+        if ( fNProcesses > 1 ) {
+            Long64_t firstEntry = fEventReader->firstEntry();
+            Long64_t nEvents = fEventReader->nEntriesInRange();
+            fEventReader->setEntryRange( firstEntry + fProcessIndex * nEvents / fNProcesses,
+                                         firstEntry + (fProcessIndex + 1) * nEvents / fNProcesses );
+        }
     }
-    
+
+    if ( fCheckpointFileName.Length() > 0 ) {
+        resumeFromCheckpoint();
+    }
+
     fTimer = new TStopwatch();
     fTimer->Start();
     fEventsInChain = fEventReader->nEventsTotal();
 
+    if ( fNThreads > 1 ) {
+        if ( fCheckpointFileName.Length() > 0 ) {
+            std::cout << "[WARNING] Manager::init - checkpoints are supported with a single event loop only. "
+                      << "Events will be processed in a single thread" << std::endl;
+            fNThreads = 1;
+        }
+        else {
+            createWorkers();
+        }
+    }
+    // Scheduler splits the range of the main reader: it is counted once. After resuming
+    // from a checkpoint the original range is already counted in the base file
+    fLoopEntriesInRange.assign( fWorkers.size() + 1, 0 );
+    fLoopEntriesInRange.at(0) = ( fCheckpointBaseFileName.Length() > 0 ) ? 0 : fEventReader->nEntriesInRange();
+
+    // Each event loop measures time of its reader and analyses separately
+    for (unsigned int iLoop{0}; iLoop<=fWorkers.size(); iLoop++) {
+        fReaderStageStats.push_back( new StageStats{} );
+        fAnalysisStageStats.push_back( new StageStats{} );
+        loopReader( iLoop )->setStageStats( fReaderStageStats.back() );
+    }
+
     AnalysisIterator anaIter;
     for ( anaIter = fAnalysisCollection->begin();
           anaIter != fAnalysisCollection->end();
           anaIter++ ) {
         (*anaIter)->init();
     }
+    for (auto worker : fWorkers) {
+        for (auto ana : worker->analyses) {
+            ana->init();
+        }
+    }
+}
+
+//________________
+void Manager::forkProcesses() {
+
+    // Output of the forked processes should not be duplicated
+    std::cout << std::flush;
+    std::cerr << std::flush;
+
+    for (int iProcess{1}; iProcess<fNProcesses; iProcess++) {
+        pid_t pid = fork();
+        if ( pid < 0 ) {
+            std::cerr << "[ERROR] Manager::forkProcesses - cannot fork process " << iProcess << ". Terminating" << std::endl;
+            exit(1);
+        }
+        if ( pid == 0 ) {
+            // Forked process writes its own output and is merged by the parent
+            fProcessIndex = iProcess;
+            fChildPids.clear();
+            fOutputFileName = processOutputFileName( iProcess );
+            return;
+        }
+        fChildPids.push_back( pid );
+    }
+    std::cout << Form("Events will be processed by %d processes\n", fNProcesses);
+}
+
+//________________
+TString Manager::processOutputFileName(const int& iProcess) const {
+    TString fileName = fOutputFileName;
+    if ( fileName.EndsWith(".root") ) {
+        fileName.Resize( fileName.Length() - 5 );
+    }
+    return Form("%s_process%d.root", fileName.Data(), iProcess);
+}
+
+//________________
+bool Manager::waitForProcesses() {
+    bool isGood{true};
+    for (unsigned int iChild{0}; iChild<fChildPids.size(); iChild++) {
+        int status{0};
+        if ( waitpid( fChildPids.at(iChild), &status, 0 ) < 0 || 
+             !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) {
+            std::cerr << "[ERROR] Manager::waitForProcesses - process " << iChild + 1 
+                      << " failed" << std::endl;
+            isGood = false;
+        }
+    }
+    fChildPids.clear();
+    return isGood;
+}
+
+//________________
+void Manager::createWorkers() {
+
+    if ( !fWorkerFactory ) {
+        std::cout << "[WARNING] Manager::createWorkers - no worker factory is set. "
+                  << "Events will be processed in a single thread" << std::endl;
+        fNThreads = 1;
+        return;
+    }
+
+    // Readers of the workers are set up for the whole entry range: tasks choose the entries
+    Long64_t firstEntry = fEventReader->firstEntry();
+    Long64_t lastEntry = firstEntry + fEventReader->nEntriesInRange();
+    for (int iThread{1}; iThread<fNThreads; iThread++) {
+        ManagerWorker *worker = new ManagerWorker{};
+        fWorkerFactory( *worker );
+        if ( !worker->reader ) {
+            std::cerr << "[ERROR] Manager::createWorkers - worker factory did not create a reader. Terminating" << std::endl;
+            exit(1);
+        }
+        worker->reader->setEntryRange(firstEntry, lastEntry);
+        worker->reader->setSampling(fSamplingStep, fSamplingBlockSize);
+        worker->reader->setSamplingOrigin( fEventReader->samplingOrigin() );
+        worker->reader->setRequiredInputs( fEventReader->requiredInputs() );
+        worker->reader->init();
+        fWorkers.push_back( worker );
+    }
+
+    // Tasks are (file, cluster) entry ranges. A thread that is done with its own
+    // tasks takes the ones left by slower threads, so a large file does not set the job time
+    std::vector<EntryTask> tasks;
+    fEventReader->entryTasks( tasks );
+    fScheduler = new TaskScheduler( fNThreads );
+    fScheduler->addTasks( tasks );
+
+    std::cout << Form("Events will be processed by %d threads\n", fNThreads);
 }
 
 //________________
@@ -57,6 +276,9 @@ void Manager::finish() {
     if (fEventReader) {
         fEventReader->finish();
     }
+    for (auto worker : fWorkers) {
+        worker->reader->finish();
+    }
 
     AnalysisIterator anaIter;
     for ( anaIter = fAnalysisCollection->begin();
@@ -64,56 +286,499 @@ void Manager::finish() {
           anaIter++ ) {
         (*anaIter)->finish();
     }
+    for (auto worker : fWorkers) {
+        for (auto ana : worker->analyses) {
+            ana->finish();
+        }
+    }
     fTimer->Stop();
+
+    for (unsigned int iQueue{0}; iQueue<fQueues.size(); iQueue++) {
+        fQueues.at(iQueue)->report( Form("Read-ahead queue of thread %u", iQueue) );
+    }
+
+    if ( isSampled() ) {
+        Long64_t nEntriesInRange{0};
+        Long64_t nEntriesProcessed{0};
+        for (unsigned int iLoop{0}; iLoop<fLoopEventsProcessed.size(); iLoop++) {
+            nEntriesInRange += fLoopEntriesInRange.at( iLoop );
+            nEntriesProcessed += fLoopEventsProcessed.at( iLoop );
+        }
+        std::cout << Form("Sampled fraction: %lld / %lld = %.5f\n", nEntriesProcessed, nEntriesInRange,
+                          ( nEntriesInRange > 0 ) ? double(nEntriesProcessed) / nEntriesInRange : 0. );
+    }
+
+    {
+        StageTimer timer(&fStageStats, fStageStats.stageId("Manager::writeOutput"));
+        writeOutput();
+    }
+
+    reportStageStats();
+
+    // Forked process is done: its output is merged by the parent
+    if ( fProcessIndex > 0 ) {
+        std::cout << std::flush;
+        _exit(0);
+    }
 }
 
 //________________
-void Manager::performAnalysis() {
+void Manager::reportStageStats() {
 
-    //std::cout << "Manager::performAnalysis - Number of events in chain: " << fEventsInChain << std::endl;
+    StageStats total{};
+    for (unsigned int iLoop{0}; iLoop<fReaderStageStats.size(); iLoop++) {
+        total.merge( *fReaderStageStats.at(iLoop) );
+        total.merge( *fAnalysisStageStats.at(iLoop) );
+    }
+    total.merge( fStageStats );
+
+    std::cout << "Time spent in the processing stages (summed over threads):" << std::endl;
+    total.print();
+
+    // Thread that ran out of tasks waits for the slowest one
+    double makespan{0};
+    for (auto time : fLoopTime) {
+        makespan = std::max( makespan, time );
+    }
+    auto nLoopTasks = [this](const unsigned int& iLoop) -> Long64_t 
+    { return ( fScheduler ) ? fScheduler->nTasks( iLoop ) : 1; };
+    auto nLoopStolen = [this](const unsigned int& iLoop) -> Long64_t 
+    { return ( fScheduler ) ? fScheduler->nStolen( iLoop ) : 0; };
+    auto utilisation = [this, makespan](const unsigned int& iLoop) -> double 
+    { return ( makespan > 0 ) ? fLoopTime.at( iLoop ) / makespan : 0.; };
+    std::cout << "Event loops:" << std::endl;
+    for (unsigned int iLoop{0}; iLoop<fLoopTime.size(); iLoop++) {
+        std::cout << Form("  thread %u: events %lld tasks %lld (stolen %lld) time %.2f sec utilisation %.1f%%\n",
+                          iLoop, fLoopEventsProcessed.at( iLoop ), nLoopTasks( iLoop ), nLoopStolen( iLoop ),
+                          fLoopTime.at( iLoop ), 100. * utilisation( iLoop ) );
+    }
+
+    // Only the parent process writes the summary
+    if ( fOutputFileName.Length() <= 0 || fProcessIndex > 0 ) return;
+
+    // Summary is written next to the output file: output.root -> output_stages.json
+    TString jsonFileName = fOutputFileName;
+    if ( jsonFileName.EndsWith(".root") ) {
+        jsonFileName.Resize( jsonFileName.Length() - 5 );
+    }
+    jsonFileName += "_stages.json";
+
+    std::ofstream jsonFile( jsonFileName.Data() );
+    if ( !jsonFile.is_open() ) {
+        std::cerr << "[ERROR] Manager::reportStageStats - cannot open file " << jsonFileName.Data() << std::endl;
+        return;
+    }
+    jsonFile << "{\n"
+             << Form("  \"output\": \"%s\",\n", fOutputFileName.Data())
+             << Form("  \"threads\": %d,\n", fNThreads)
+             << Form("  \"events\": %lld,\n", fEventsProcessed.load())
+             << Form("  \"realTime\": %.3f,\n", fTimer->RealTime())
+             << Form("  \"cpuTime\": %.3f,\n", fTimer->CpuTime())
+             << "  \"workers\": [\n";
+    for (unsigned int iLoop{0}; iLoop<fLoopTime.size(); iLoop++) {
+        jsonFile << Form("    {\"thread\": %u, \"events\": %lld, \"tasks\": %lld, \"stolen\": %lld, \"time\": %.3f, \"utilisation\": %.4f}%s\n",
+                         iLoop, fLoopEventsProcessed.at( iLoop ), nLoopTasks( iLoop ), nLoopStolen( iLoop ),
+                         fLoopTime.at( iLoop ), utilisation( iLoop ), 
+                         ( iLoop + 1 < fLoopTime.size() ) ? "," : "");
+    }
+    jsonFile << "  ],\n"
+             << "  \"stages\": [\n";
+    for (unsigned int i{0}; i<total.nStages(); i++) {
+        jsonFile << Form("    {\"name\": \"%s\", \"calls\": %lld, \"time\": %.6f}%s\n", 
+                         total.name(i), total.calls(i), total.time(i), 
+                         ( i + 1 < total.nStages() ) ? "," : "");
+    }
+    jsonFile << "  ]\n}\n";
+    jsonFile.close();
+    std::cout << "Stage summary is written to " << jsonFileName.Data() << std::endl;
+}
+
+//________________
+void Manager::resumeFromCheckpoint() {
+
+    // Range of the first run is kept in all checkpoints of the job
+    fCheckpointEntriesInRange = fEventReader->nEntriesInRange();
+
+    // Checkpoint of the previous run becomes the base of this one (it will be
+    // overwritten by the new checkpoints). If the previous run was stopped
+    // before its first checkpoint, the base of the previous run is used
+    TString baseFileName = fCheckpointFileName + ".prev";
+    if ( !gSystem->AccessPathName( fCheckpointFileName.Data() ) ) {
+        gSystem->Rename( fCheckpointFileName.Data(), baseFileName.Data() );
+    }
+    if ( gSystem->AccessPathName( baseFileName.Data() ) ) {
+        std::cout << "No checkpoint found. Processing starts from the beginning" << std::endl;
+        // React on eviction
+        std::signal( SIGTERM, handleTermination );
+        return;
+    }
+
+    TFile *baseFile = TFile::Open( baseFileName.Data() );
+    TParameter<Long64_t> *nextEntry{nullptr};
+    TParameter<Long64_t> *entriesInRange{nullptr};
+    TParameter<Long64_t> *samplingOrigin{nullptr};
+    if ( baseFile && !baseFile->IsZombie() ) {
+        baseFile->GetObject("checkpointNextEntry", nextEntry);
+        baseFile->GetObject("checkpointEntriesInRange", entriesInRange);
+        baseFile->GetObject("checkpointSamplingOrigin", samplingOrigin);
+    }
+    if ( !nextEntry ) {
+        std::cerr << "[ERROR] Manager::resumeFromCheckpoint - cannot read checkpoint "
+                  << baseFileName.Data() << ". Terminating" << std::endl;
+        exit(1);
+    }
+
+    Long64_t firstEntry = fEventReader->firstEntry();
+    Long64_t lastEntry = firstEntry + fEventReader->nEntriesInRange();
+    if ( nextEntry->GetVal() < firstEntry || nextEntry->GetVal() > lastEntry ) {
+        std::cerr << Form("[ERROR] Manager::resumeFromCheckpoint - next entry %lld from the checkpoint is outside the entry range [%lld, %lld). Terminating\n", 
+                          nextEntry->GetVal(), firstEntry, lastEntry);
+        exit(1);
+    }
+
+    if ( entriesInRange ) {
+        fCheckpointEntriesInRange = entriesInRange->GetVal();
+    }
+    std::cout << Form("Resuming from checkpoint %s: entries [%lld, %lld) are already processed (job range: %lld entries)\n",
+                      baseFileName.Data(), firstEntry, nextEntry->GetVal(), fCheckpointEntriesInRange);
+    // Sampling blocks of the interrupted run are kept: the next entry may be inside a block
+    if ( samplingOrigin ) {
+        fEventReader->setSamplingOrigin( samplingOrigin->GetVal() );
+    }
+    fEventReader->setEntryRange( nextEntry->GetVal(), lastEntry );
+    fCheckpointBaseFileName = baseFileName;
+
+    delete nextEntry;
+    delete entriesInRange;
+    delete samplingOrigin;
+    baseFile->Close();
+    delete baseFile;
+
+    // React on eviction
+    std::signal( SIGTERM, handleTermination );
+}
+
+//________________
+void Manager::writeCheckpoint(const Long64_t& nextEntry) {
+
+    // Write a temporary file first: the old checkpoint stays valid if the job
+    // is killed while writing
+    TString tmpFileName = fCheckpointFileName + ".tmp";
+    if ( !mergeOutput( tmpFileName.Data(), ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault ) ) {
+        std::cerr << "[ERROR] Manager::writeCheckpoint - cannot write checkpoint" << std::endl;
+        return;
+    }
+    TFile *tmpFile = TFile::Open( tmpFileName.Data(), "update" );
+    TParameter<Long64_t> parameter("checkpointNextEntry", nextEntry);
+    parameter.Write("", TObject::kOverwrite);
+    TParameter<Long64_t> entriesInRange("checkpointEntriesInRange", fCheckpointEntriesInRange);
+    entriesInRange.Write("", TObject::kOverwrite);
+    TParameter<Long64_t> samplingOrigin("checkpointSamplingOrigin", fEventReader->samplingOrigin());
+    samplingOrigin.Write("", TObject::kOverwrite);
+    tmpFile->Close();
+    delete tmpFile;
+
+    gSystem->Rename( tmpFileName.Data(), fCheckpointFileName.Data() );
+    std::cout << Form("Checkpoint is written to %s. Next entry: %lld\n", fCheckpointFileName.Data(), nextEntry);
+}
+
+//________________
+bool Manager::mergeOutput(const char *fileName, const int& compression) {
+
+    // Each thread writes its output to memory. Then everything is merged
+    // into the output file (same as hadd does)
+    TFileMerger merger(kFALSE);
+    merger.OutputFile(fileName, "RECREATE", compression);
+    // Entry offset, range and sampling origin of the checkpoint are not a part of the output
+    merger.AddObjectNames("checkpointNextEntry checkpointEntriesInRange checkpointSamplingOrigin");
+    if ( fCheckpointBaseFileName.Length() > 0 ) {
+        merger.AddFile( fCheckpointBaseFileName.Data() );
+    }
+    // Output of the forked processes
+    if ( fProcessIndex == 0 ) {
+        for (int iProcess{1}; iProcess<fNProcesses; iProcess++) {
+            merger.AddFile( processOutputFileName( iProcess ).Data() );
+        }
+    }
+    for (int iThread{0}; iThread<fNThreads; iThread++) {
+        TMemFile *memFile = new TMemFile(Form("thread_%d.root", iThread), "recreate");
+        for (auto ana : *loopAnalyses( iThread )) {
+            ana->writeOutput();
+        }
+        writeSamplingInfo( iThread );
+        memFile->Write();
+        // Merger takes ownership of the in-memory file
+        merger.AddAdoptFile(memFile);
+    }
+    return merger.PartialMerge( TFileMerger::kAll | TFileMerger::kRegular | TFileMerger::kSkipListed );
+}
+
+//________________
+void Manager::writeOutput() {
+
+    if ( fOutputFileName.Length() <= 0 ) {
+        if ( !fWorkers.empty() ) {
+            std::cout << "[WARNING] Manager::writeOutput - no output file name is set. "
+                      << "Output of the extra threads is lost" << std::endl;
+        }
+        return;
+    }
+
+    // Parent needs output of all forked processes
+    bool isParentOfProcesses = ( fProcessIndex == 0 && fNProcesses > 1 );
+    if ( isParentOfProcesses && !waitForProcesses() ) {
+        std::cerr << "[ERROR] Manager::writeOutput - not all processes finished successfully. "
+                  << "Output is not written" << std::endl;
+        exit(1);
+    }
+
+    if ( fWorkers.empty() && fCheckpointBaseFileName.Length() <= 0 && !isParentOfProcesses ) {
+        TFile *oFile = new TFile(fOutputFileName.Data(), "recreate", "", fCompression);
+        for (auto ana : *fAnalysisCollection) {
+            ana->writeOutput();
+        }
+        writeSamplingInfo( 0 );
+        oFile->Close();
+        delete oFile;
+    }
+    else if ( !mergeOutput( fOutputFileName.Data(), fCompression ) ) {
+        std::cerr << "[ERROR] Manager::writeOutput - cannot merge output into "
+                  << fOutputFileName.Data() << std::endl;
+        return;
+    }
+
+    if ( isParentOfProcesses ) {
+        for (int iProcess{1}; iProcess<fNProcesses; iProcess++) {
+            gSystem->Unlink( processOutputFileName( iProcess ).Data() );
+        }
+    }
+
+    // Job is finished: checkpoints are not needed anymore
+    if ( fCheckpointFileName.Length() > 0 ) {
+        gSystem->Unlink( fCheckpointFileName.Data() );
+        gSystem->Unlink( (fCheckpointFileName + ".prev").Data() );
+    }
+}
+
+//________________
+Long64_t Manager::nextTask(const unsigned int& iLoop, bool& isFirst) {
+    BaseReader *reader = loopReader( iLoop );
+    if ( !fScheduler ) {
+        // Single event loop reads the whole entry range
+        if ( !isFirst ) return 0;
+        isFirst = {false};
+        return reader->nEventsTotal();
+    }
+
+    isFirst = {false};
+    EntryTask task;
+    while ( fScheduler->next( iLoop, task ) ) {
+        reader->startTask( task );
+        // Task may contain no sampled entries
+        if ( reader->nEventsTotal() > 0 ) return reader->nEventsTotal();
+    }
+    return 0;
+}
+
+//________________
+void Manager::processEvents(const unsigned int& iLoop) {
+
+    BaseReader *reader = loopReader( iLoop );
+    AnalysisCollection *analyses = loopAnalyses( iLoop );
+    EventQueue *queue = fQueues.empty() ? nullptr : fQueues.at( iLoop );
+    StageStats *stats = fAnalysisStageStats.at( iLoop );
+    // The main thread prints progress of all threads
+    bool printProgress = ( iLoop == 0 );
 
     int nEventsPerCycle{50000};
     double progress{0.0};
 
+    // Stage of each analysis
+    std::vector<int> stageIds;
+    for (unsigned int iAna{0}; iAna<analyses->size(); iAna++) {
+        stageIds.push_back( stats->stageId( Form("%s::processEvent [%u]", analyses->at(iAna)->IsA()->GetName(), iAna) ) );
+    }
+
+    // Reader thread fills the queue while this thread runs the analyses
+    std::thread readerThread;
+    if ( queue ) {
+        readerThread = std::thread( [this, iLoop, reader, queue]() {
+            bool isFirstTask{true};
+            Long64_t nTaskEvents{0};
+            while ( ( nTaskEvents = nextTask( iLoop, isFirstTask ) ) > 0 ) {
+                for (Long64_t iEvent=0; iEvent<nTaskEvents; iEvent++) {
+                    Event *event = reader->returnEvent();
+                    if ( !queue->push( event, reader->status() ) ) {
+                        // Analysis stopped before the end of input
+                        if ( event ) reader->recycleEvent( event );
+                        return;
+                    }
+                }
+            }
+            // Status 2 (end of input) stops the analysis
+            queue->push( nullptr, 2 );
+        } );
+    }
+
     // Loop over all events available
-    for (Long64_t iEvent=0; iEvent<fEventsInChain; iEvent++) {
+    bool isFirstTask{true};
+    Long64_t nTaskEvents{0};
+    Long64_t iEvent{0};
+    while ( true ) {
+
+        // Stop if the event or time budget is used up
+        if ( isSampled() && isBudgetExhausted() ) {
+            if ( printProgress ) {
+                std::cout << "Event or time budget is used up. Stopping the event loop" << std::endl;
+            }
+            break;
+        }
+
+        // Without the reader thread tasks are taken by this thread
+        if ( !queue && nTaskEvents <= 0 ) {
+            nTaskEvents = nextTask( iLoop, isFirstTask );
+            if ( nTaskEvents <= 0 ) break;
+        }
 
         // Print progress
-        if ( iEvent % nEventsPerCycle == 0 ) {
-            progress = 100.0 * iEvent / fEventsInChain;
+        if ( printProgress && iEvent % nEventsPerCycle == 0 ) {
+            Long64_t nProcessed = fEventsProcessed.load();
+            progress = 100.0 * nProcessed / fEventsInChain;
 
             fTimer->Stop();
-            std::cout << Form("Processed %lld events. Progress : %.2f%% Real time (sec): %.2f CPU time (sec): %.2f", iEvent, progress, fTimer->RealTime(), fTimer->CpuTime()) << std::endl;
+            std::cout << Form("Processed %lld events. Progress : %.2f%% Real time (sec): %.2f CPU time (sec): %.2f", nProcessed, progress, fTimer->RealTime(), fTimer->CpuTime()) << std::endl;
             fTimer->Continue();
         }
 
         //std::cout << "=================================" << std::endl;
         //std::cout << "Manager::performAnalysis - Processing event: " << iEvent << std::endl;
-        Event *currentEvent = fEventReader->returnEvent();
-
-        if ( !currentEvent ) {
-            if ( fEventReader->status() != 0) {
-                std::cout << "Reader returned status: " 
-                        << fEventReader->status() 
-                        << ". Terminating\n";
-            }
-        } // if ( !currentEvent)
+        if ( queue ) {
+            Int_t status{0};
+            Event *currentEvent = queue->pop( status );
+            if ( !currentEvent && status == 2 ) break;
+            processEvent( reader, currentEvent, status, analyses, stats, stageIds );
+        }
         else {
-            // Perform data processing by all analyses
-            AnalysisIterator anaIter;
-            for ( anaIter = fAnalysisCollection->begin();
-                anaIter != fAnalysisCollection->end();
-                anaIter++ ) {
+            Event *currentEvent = reader->returnEvent();
+            nTaskEvents--;
+            processEvent( reader, currentEvent, reader->status(), analyses, stats, stageIds );
+        }
+        fEventsProcessed++;
+        iEvent++;
 
-                (*anaIter)->processEvent( currentEvent );
+        // Checkpoints are written by the only event loop
+        if ( fCheckpointFileName.Length() > 0 && 
+             ( iEvent % fCheckpointEvents == 0 || gTerminationRequested ) ) {
+            Long64_t nextEntry = ( iEvent < reader->nEventsTotal() ) ? reader->entryNumber( iEvent ) : 
+                                 reader->firstEntry() + reader->nEntriesInRange();
+            // Sampling information of the checkpoint needs the events processed so far
+            fLoopEventsProcessed.at( iLoop ) = iEvent;
+            writeCheckpoint( nextEntry );
+            if ( gTerminationRequested ) {
+                std::cout << "Termination requested. The job can be resumed from the checkpoint" << std::endl;
+                // Reader thread may still be running: do not wait for it
+                std::_Exit(143);
             }
         }
+    } // while ( true )
+    fLoopEventsProcessed.at( iLoop ) = iEvent;
 
-        if ( currentEvent ) {
-            delete currentEvent;
-            currentEvent = nullptr;
+    if ( readerThread.joinable() ) {
+        // Reader thread may wait for the free place in the queue
+        queue->close();
+        readerThread.join();
+        // Events read ahead but not processed
+        while ( queue->size() > 0 ) {
+            Int_t status{0};
+            Event *event = queue->pop( status );
+            if ( event ) reader->recycleEvent( event );
         }
-    } // for (Long64_t iEvent=0; iEvent<fEventsInChain; iEvent++)
+    }
+    // Time this thread was busy (idle till the slowest thread is done)
+    fLoopTime.at( iLoop ) = std::chrono::duration<double>( std::chrono::steady_clock::now() - fStartTime ).count();
+}
+
+//________________
+bool Manager::isBudgetExhausted() const {
+    if ( fEventBudget > 0 && fEventsProcessed.load() >= fEventBudget ) {
+        return true;
+    }
+    if ( fTimeBudget > 0 && 
+         std::chrono::duration<double>( std::chrono::steady_clock::now() - fStartTime ).count() >= fTimeBudget ) {
+        return true;
+    }
+    return false;
+}
+
+//________________
+void Manager::writeSamplingInfo(const unsigned int& iLoop) {
+    if ( !isSampled() ) return;
+    // Histograms are summed when outputs are merged: sampled fraction = bin 2 / bin 1
+    TH1D *hSampledEntries = new TH1D("hSampledEntries", "Entries in range and processed entries", 2, 0.5, 2.5);
+    hSampledEntries->GetXaxis()->SetBinLabel(1, "entriesInRange");
+    hSampledEntries->GetXaxis()->SetBinLabel(2, "entriesProcessed");
+    hSampledEntries->SetBinContent(1, fLoopEntriesInRange.at( iLoop ) );
+    hSampledEntries->SetBinContent(2, fLoopEventsProcessed.at( iLoop ) );
+    hSampledEntries->Write();
+    delete hSampledEntries;
+}
+
+//________________
+void Manager::processEvent(BaseReader *reader, Event *currentEvent, const Int_t& status, AnalysisCollection *analyses, 
+                           StageStats *stats, const std::vector<int>& stageIds) {
+
+    if ( !currentEvent ) {
+        if ( status != 0) {
+            std::cout << "Reader returned status: "
+                      << status
+                      << ". Terminating\n";
+        }
+    } // if ( !currentEvent)
+    else {
+        // Perform data processing by all analyses
+        for (unsigned int iAna{0}; iAna<analyses->size(); iAna++) {
+            StageTimer timer(stats, stageIds[iAna]);
+            analyses->at(iAna)->processEvent( currentEvent );
+        }
+    }
+
+    if ( currentEvent ) {
+        // Reader may reuse the event
+        reader->recycleEvent( currentEvent );
+        currentEvent = nullptr;
+    }
+}
+
+//________________
+void Manager::performAnalysis() {
+
+    //std::cout << "Manager::performAnalysis - Number of events in chain: " << fEventsInChain << std::endl;
+
+    fEventsProcessed = 0;
+
+    // Each event loop gets its own read-ahead queue
+    if ( fReadAheadDepth > 0 && fQueues.empty() ) {
+        for (unsigned int iQueue{0}; iQueue<=fWorkers.size(); iQueue++) {
+            fQueues.push_back( new EventQueue( fReadAheadDepth ) );
+            loopReader( iQueue )->setEventsAreQueued( true );
+        }
+    }
+    fLoopEventsProcessed.assign( fWorkers.size() + 1, 0 );
+    fLoopTime.assign( fWorkers.size() + 1, 0 );
+    fStartTime = std::chrono::steady_clock::now();
+
+    if ( fWorkers.empty() ) {
+        processEvents( 0 );
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned int iLoop{0}; iLoop<=fWorkers.size(); iLoop++) {
+        threads.emplace_back( &Manager::processEvents, this, iLoop );
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
 }
 
 //________________
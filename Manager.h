@@ -16,11 +16,36 @@
 #include "BaseAnalysis.h"
 #include "BaseReader.h"
 #include "Collections.h"
+#include "EventQueue.h"
+#include "StageStats.h"
+#include "TaskScheduler.h"
 
 // ROOT headers
 #include "TObject.h"
 #include "Rtypes.h"
 #include "TStopwatch.h"
+#include "TString.h"
+#include "Compression.h"
+
+// C++ headers
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <sys/types.h>
+
+//________________
+/// @brief Event reader and analyses processed by a single thread
+struct ManagerWorker {
+    /// @brief Event reader of the worker (owned by the manager)
+    BaseReader *reader{nullptr};
+    /// @brief Analyses of the worker (owned by the manager)
+    AnalysisCollection analyses{};
+};
+
+/// @brief Function that creates reader and analyses of an extra worker.
+/// Analyses must be configured in the same way as the ones added to the manager
+typedef std::function<void(ManagerWorker&)> WorkerFactory;
 
 //________________
 class Manager {
@@ -45,7 +70,91 @@ class Manager {
     /// @brief Set event reader
     void setEventReader(BaseReader* reader) { fEventReader = reader; }
 
+    /// @brief Set number of threads to process events (default: 1). Threads take
+    /// (file, TTree cluster) tasks from a work-stealing scheduler
+    void setNumberOfThreads(const int& n = 1) { fNThreads = (n < 1) ? 1 : n; }
+    /// @brief Set function that creates reader and analyses for each extra thread
+    void setWorkerFactory(WorkerFactory factory) { fWorkerFactory = factory; }
+    /// @brief Set output file name and compression settings. If set, the output of all
+    /// analyses (merged over threads) is written to this file at finish()
+    void setOutputFileName(const char *name, const int& compression = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault)
+    { fOutputFileName = name; fCompression = compression; }
+
+    /// @brief Process only entries [first, last) of the input. Negative last means till the end of input
+    void setEntryRange(const Long64_t& first, const Long64_t& last = -1) { fFirstEntry = first; fLastEntry = last; }
+    /// @brief Process only shard index (0 <= index < nShards) of nShards equal parts of the entry range
+    void setShard(const int& index, const int& nShards) { fShardIndex = index; fNShards = nShards; }
+
+    /// @brief Set number of events read ahead by a separate reader thread
+    /// (per event loop). 0 - events are read by the analysis thread (default)
+    void setReadAheadDepth(const int& depth = 0) { fReadAheadDepth = (depth < 0) ? 0 : depth; }
+
+    /// @brief Set number of processes to process events (default: 1). Extra processes are
+    /// forked at init() and take disjoint entry ranges. Their output is merged by the parent
+    void setNumberOfProcesses(const int& n = 1) { fNProcesses = (n < 1) ? 1 : n; }
+
+    /// @brief Periodically save histograms of all analyses and the next entry to read into
+    /// the checkpoint file (single event loop only). SIGTERM triggers the last checkpoint.
+    /// If the checkpoint file exists at init(), processing resumes from it
+    void setCheckpoint(const char *fileName, const Long64_t& nEvents = 100000)
+    { fCheckpointFileName = fileName; fCheckpointEvents = (nEvents < 1) ? 1 : nEvents; }
+
+    /// @brief Process only the first of every step blocks of blockSize consecutive entries
+    /// (deterministic sub-sampling for quick QA). Sampled fraction is stored in the output
+    void setSampling(const Long64_t& step, const Long64_t& blockSize = 1) 
+    { fSamplingStep = (step < 1) ? 1 : step; fSamplingBlockSize = (blockSize < 1) ? 1 : blockSize; }
+    /// @brief Stop after the given number of events (summed over threads). 0 - no limit
+    void setEventBudget(const Long64_t& nEvents = 0) { fEventBudget = (nEvents < 0) ? 0 : nEvents; }
+    /// @brief Stop after the given wall time (in seconds) of the event loop. 0 - no limit
+    void setTimeBudget(const double& seconds = 0) { fTimeBudget = (seconds < 0) ? 0 : seconds; }
+
+    /// @brief Return number of threads
+    int numberOfThreads() const { return fNThreads; }
+    /// @brief Return number of events to be processed (summed over threads)
+    Long64_t nEventsTotal() const { return fEventsInChain; }
+
   private:
+
+    /// @brief Create extra workers and split entries between them
+    void createWorkers();
+    /// @brief Reader of the event loop (0 - main reader)
+    BaseReader *loopReader(const unsigned int& iLoop) const
+    { return ( iLoop == 0 ) ? fEventReader : fWorkers.at(iLoop-1)->reader; }
+    /// @brief Analyses of the event loop (0 - main analyses)
+    AnalysisCollection *loopAnalyses(const unsigned int& iLoop) const
+    { return ( iLoop == 0 ) ? fAnalysisCollection : &fWorkers.at(iLoop-1)->analyses; }
+    /// @brief Event loop of a single thread
+    void processEvents(const unsigned int& iLoop);
+    /// @brief Give the next task of the event loop to its reader
+    /// @param isFirst Loop did not take any task yet
+    /// @return Number of events to read (0 - no input left)
+    Long64_t nextTask(const unsigned int& iLoop, bool& isFirst);
+    /// @brief Check if the event or time budget is used up
+    bool isBudgetExhausted() const;
+    /// @brief Sub-sampling or budget is used
+    bool isSampled() const { return ( fSamplingStep > 1 || fEventBudget > 0 || fTimeBudget > 0 ); }
+    /// @brief Write number of entries in the range and of processed entries of the event loop
+    void writeSamplingInfo(const unsigned int& iLoop);
+    /// @brief Pass event to all analyses and give it back to the reader
+    void processEvent(BaseReader *reader, Event *event, const Int_t& status, AnalysisCollection *analyses, 
+                      StageStats *stats, const std::vector<int>& stageIds);
+    /// @brief Merge stage stats of all threads, print them and write JSON summary next to the output file
+    void reportStageStats();
+    /// @brief Write output of all analyses to the output file
+    void writeOutput();
+    /// @brief Merge output of previous runs (checkpoint) and of all event loops into the file
+    bool mergeOutput(const char *fileName, const int& compression);
+    /// @brief Fork extra processes
+    void forkProcesses();
+    /// @brief Output file name of the forked process
+    TString processOutputFileName(const int& iProcess) const;
+    /// @brief Wait for all forked processes to finish
+    bool waitForProcesses();
+    /// @brief Continue from the checkpoint file if it exists
+    void resumeFromCheckpoint();
+    /// @brief Write histograms and the next entry to read into the checkpoint file
+    void writeCheckpoint(const Long64_t& nextEntry);
+
     /// @brief Pointer to analysis collection
     AnalysisCollection *fAnalysisCollection;
     /// @brief Poiter to event reader
@@ -55,7 +164,78 @@ class Manager {
     /// Number of events in input
     Long64_t fEventsInChain;
 
+    /// @brief Number of threads to process events
+    int fNThreads;
+    /// @brief Function that creates extra workers
+    WorkerFactory fWorkerFactory; //!
+    /// @brief Extra workers (the first thread uses fEventReader and fAnalysisCollection)
+    std::vector<ManagerWorker*> fWorkers; //!
+    /// @brief Number of events processed by all threads
+    std::atomic<Long64_t> fEventsProcessed; //!
+
+    /// @brief Number of events read ahead by the reader thread
+    int fReadAheadDepth;
+    /// @brief Read-ahead queues (one per event loop)
+    std::vector<EventQueue*> fQueues; //!
+
+    /// @brief Sampling step: every step-th block of entries is processed
+    Long64_t fSamplingStep;
+    /// @brief Number of consecutive entries in the sampling block
+    Long64_t fSamplingBlockSize;
+    /// @brief Maximal number of events to process (0 - no limit)
+    Long64_t fEventBudget;
+    /// @brief Maximal wall time of the event loop in seconds (0 - no limit)
+    double fTimeBudget;
+    /// @brief Start of the event loop
+    std::chrono::steady_clock::time_point fStartTime; //!
+    /// @brief Number of events processed by each event loop
+    std::vector<Long64_t> fLoopEventsProcessed; //!
+    /// @brief Number of entries in the range of each event loop (before sampling)
+    std::vector<Long64_t> fLoopEntriesInRange; //!
+    /// @brief Wall time of each event loop
+    std::vector<double> fLoopTime; //!
+
+    /// @brief Scheduler of tasks of the event loops (threaded mode only)
+    TaskScheduler *fScheduler; //!
+
+    /// @brief Time spent in the reading stages (one per reader)
+    std::vector<StageStats*> fReaderStageStats; //!
+    /// @brief Time spent in the analyses (one per event loop)
+    std::vector<StageStats*> fAnalysisStageStats; //!
+    /// @brief Time spent in the manager stages
+    StageStats fStageStats; //!
+
+    /// @brief First entry to process
+    Long64_t fFirstEntry;
+    /// @brief Last entry to process (excluded). Negative value means the end of input
+    Long64_t fLastEntry;
+    /// @brief Shard index to process
+    int fShardIndex;
+    /// @brief Number of shards the entry range is split into
+    int fNShards;
+
+    /// @brief Number of processes to process events
+    int fNProcesses;
+    /// @brief Index of the current process (0 - parent)
+    int fProcessIndex;
+    /// @brief Process IDs of the forked processes (parent only)
+    std::vector<pid_t> fChildPids; //!
+
+    /// @brief Checkpoint file name (empty - no checkpoints)
+    TString fCheckpointFileName;
+    /// @brief Number of events between checkpoints
+    Long64_t fCheckpointEvents;
+    /// @brief File with histograms of the previous runs (empty - fresh start)
+    TString fCheckpointBaseFileName;
+    /// @brief Number of entries in the range of the first run of the job (before sampling)
+    Long64_t fCheckpointEntriesInRange;
+
+    /// @brief Output file name
+    TString fOutputFileName;
+    /// @brief Output file compression settings
+    int fCompression;
+
   ClassDef(Manager, 0)
 };
 
-#endif // #define ANALYSISMANAGER_H
\ No newline at end of file
+#endif // #define ANALYSISMANAGER_H
@@ -22,7 +22,7 @@
 //________________
 RecoJet::RecoJet() : BaseJet{}, fPtJECCorr{0}, fGenJetId{-99}, fTrackPtMax{0},
     fJtPfNHF{0}, fJtPfNEF{0}, fJtPfCHF{0}, fJtPfMUF{0}, fJtPfCEF{0}, 
-    fJtPfCHM{0}, fJtPfCEM{0}, fJtPfNHM{0}, fJtPfNEM{0}, fJtPfMUM{0} {
+    fJtPfCHM{0}, fJtPfCEM{0}, fJtPfNHM{0}, fJtPfNEM{0}, fJtPfMUM{0}, fJetIdFlags{0} {
     /* Empty */
 }
 
@@ -44,6 +44,11 @@ bool RecoJet::isGoodTrkMax() const {
 //________________
 bool RecoJet::isGoodJetId(const bool& useLooseJetIdCut) const {
 
+    // Decisions stored instead of the PF content (e.g. jets read from the slim dijet tree)
+    if ( fJetIdFlags & kJetIdFlagsSet ) {
+        return ( fJetIdFlags & ( useLooseJetIdCut ? kGoodLooseJetId : kGoodTightJetId ) ) != 0;
+    }
+
     bool passJetId = {false};
 
     int chm = this->jtPfCHM();
@@ -126,6 +131,15 @@ bool RecoJet::isGoodJetId(const bool& useLooseJetIdCut) const {
 	return passJetId;
 }
 
+//________________
+int RecoJet::jetIdFlags() const {
+    if ( fJetIdFlags & kJetIdFlagsSet ) return (int)fJetIdFlags;
+    int flags{kJetIdFlagsSet};
+    if ( isGoodJetId( true ) ) flags |= kGoodLooseJetId;
+    if ( isGoodJetId( false ) ) flags |= kGoodTightJetId;
+    return flags;
+}
+
 //________________
 bool RecoJet::operator==(const RecoJet& other) const {
     return ( BaseJet::operator==(other) &&
@@ -22,6 +22,13 @@
 //________________
 class RecoJet : public BaseJet {
   public:
+    /// @brief Jet quality decisions that can be stored instead of the PF content
+    enum JetIdFlag {
+        kJetIdFlagsSet   = 1 << 0, ///< flags are set: jetId decisions are taken from them
+        kGoodLooseJetId  = 1 << 1, ///< passes loose jetId
+        kGoodTightJetId  = 1 << 2  ///< passes tight jetId
+    };
+
     /// @brief Default constructor
     RecoJet();
     /// @brief Destructor
@@ -62,7 +69,8 @@ class RecoJet : public BaseJet {
     void setJtPfNEM(const int& x) { fJtPfNEM = (UChar_t)x; }
     /// @brief Set muon multiplicity
     void setJtPfMUM(const int& x) { fJtPfMUM = (UChar_t)x; }
-
+    /// @brief Set jetId decisions (JetIdFlag). Used when the PF content is not available
+    void setJetIdFlags(const int& flags) { fJetIdFlags = (UChar_t)( flags | kJetIdFlagsSet ); }
 
     /// @brief Print parameters of the given jet
     void print();
@@ -111,6 +119,8 @@ class RecoJet : public BaseJet {
     bool isGoodTrkMax() const;
     /// @brief Check if jet passes jetId selection criteria for various eta ranges
     bool isGoodJetId(const bool& useLooseJetIdCut = true) const;
+    /// @brief Return jetId decisions (JetIdFlag) evaluated from the PF content or the stored ones
+    int jetIdFlags() const;
 
   private:
 
@@ -142,6 +152,8 @@ class RecoJet : public BaseJet {
     UChar_t fJtPfNEM;
     /// @brief Muon multiplicity
     UChar_t fJtPfMUM;
+    /// @brief Stored jetId decisions (0 - evaluated from the PF content)
+    UChar_t fJetIdFlags; //!
     
     ClassDef(RecoJet, 5)
 };
@@ -0,0 +1,48 @@
+/**
+ * @file StageStats.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Time and number of calls spent in the processing stages
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "StageStats.h"
+
+// ROOT headers
+#include "TString.h"
+
+// C++ headers
+#include <iostream>
+
+//________________
+int StageStats::stageId(const char *name) {
+    for (unsigned int i{0}; i<fNames.size(); i++) {
+        if ( fNames[i] == name ) return i;
+    }
+    fNames.push_back( name );
+    fTime.push_back( 0. );
+    fCalls.push_back( 0 );
+    return fNames.size() - 1;
+}
+
+//________________
+void StageStats::merge(const StageStats& other) {
+    for (unsigned int i{0}; i<other.nStages(); i++) {
+        int id = stageId( other.name(i) );
+        fTime[id] += other.time(i);
+        fCalls[id] += other.calls(i);
+    }
+}
+
+//________________
+void StageStats::print() const {
+    std::cout << Form("%-45s %14s %12s %14s\n", "Stage", "Calls", "Time (sec)", "Per call (us)");
+    for (unsigned int i{0}; i<fNames.size(); i++) {
+        double perCall = ( fCalls[i] > 0 ) ? 1e6 * fTime[i] / fCalls[i] : 0.;
+        std::cout << Form("%-45s %14lld %12.2f %14.3f\n", fNames[i].c_str(), fCalls[i], fTime[i], perCall);
+    }
+}
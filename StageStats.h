@@ -0,0 +1,87 @@
+/**
+ * @file StageStats.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Time and number of calls spent in the processing stages
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef StageStats_h
+#define StageStats_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <chrono>
+#include <string>
+#include <vector>
+
+//________________
+class StageStats {
+  public:
+    /// @brief Constructor
+    StageStats() : fNames{}, fTime{}, fCalls{} { /* empty */ }
+    /// @brief Destructor
+    virtual ~StageStats() { /* empty */ }
+
+    /// @brief Return index of the stage with the given name (stage is added if it does not exist)
+    int stageId(const char *name);
+    /// @brief Add time (in seconds) spent in the stage and count the call
+    void add(const int& id, const double& seconds) { fTime[id] += seconds; fCalls[id]++; }
+    /// @brief Add time and calls of the other stats (stages are matched by name)
+    void merge(const StageStats& other);
+
+    /// @brief Number of stages
+    unsigned int nStages() const                  { return fNames.size(); }
+    /// @brief Name of the stage
+    const char *name(const int& id) const         { return fNames.at(id).c_str(); }
+    /// @brief Time (in seconds) spent in the stage
+    double time(const int& id) const              { return fTime.at(id); }
+    /// @brief Number of calls of the stage
+    Long64_t calls(const int& id) const           { return fCalls.at(id); }
+
+    /// @brief Print table with stages
+    void print() const;
+
+  private:
+    /// @brief Stage names
+    std::vector<std::string> fNames;
+    /// @brief Time (in seconds) spent in each stage
+    std::vector<double> fTime;
+    /// @brief Number of calls of each stage
+    std::vector<Long64_t> fCalls;
+};
+
+//________________
+/// @brief Measures time between creation and destruction and adds it to the stage.
+/// Does nothing if no stats are given
+class StageTimer {
+  public:
+    /// @brief Constructor starts the timer
+    StageTimer(StageStats *stats, const int& id) : fStats{stats}, fId{id}, fStart{} {
+        if ( fStats ) fStart = std::chrono::steady_clock::now();
+    }
+    /// @brief Destructor adds time to the stage
+    ~StageTimer() { stop(); }
+    /// @brief Add time to the stage now (the timer is not used afterwards)
+    void stop() {
+        if ( fStats ) {
+            fStats->add( fId, std::chrono::duration<double>( std::chrono::steady_clock::now() - fStart ).count() );
+            fStats = nullptr;
+        }
+    }
+
+  private:
+    /// @brief Stats to fill
+    StageStats *fStats;
+    /// @brief Stage index
+    int fId;
+    /// @brief Start time
+    std::chrono::steady_clock::time_point fStart;
+};
+
+#endif // #define StageStats_h
@@ -0,0 +1,89 @@
+/**
+ * @file TaskScheduler.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Work-stealing scheduler of entry ranges processed by several threads
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "TaskScheduler.h"
+
+//________________
+TaskScheduler::TaskScheduler(const unsigned int& nWorkers) : fQueues{} {
+    for (unsigned int iWorker{0}; iWorker<( (nWorkers < 1) ? 1 : nWorkers ); iWorker++) {
+        fQueues.push_back( new WorkerQueue{} );
+    }
+}
+
+//________________
+TaskScheduler::~TaskScheduler() {
+    for (auto queue : fQueues) {
+        delete queue;
+    }
+}
+
+//________________
+void TaskScheduler::addTasks(const std::vector<EntryTask>& tasks) {
+    // Consecutive tasks stay with the same worker: files are opened once
+    const unsigned int nWorkers = fQueues.size();
+    for (unsigned int iWorker{0}; iWorker<nWorkers; iWorker++) {
+        std::size_t lo = iWorker * tasks.size() / nWorkers;
+        std::size_t hi = (iWorker + 1) * tasks.size() / nWorkers;
+        std::lock_guard<std::mutex> lock( fQueues.at(iWorker)->mutex );
+        fQueues.at(iWorker)->tasks.insert( fQueues.at(iWorker)->tasks.end(), 
+                                           tasks.begin() + lo, tasks.begin() + hi );
+    }
+}
+
+//________________
+bool TaskScheduler::next(const unsigned int& iWorker, EntryTask& task) {
+    WorkerQueue *queue = fQueues.at(iWorker);
+    bool found{false};
+    {
+        std::lock_guard<std::mutex> lock( queue->mutex );
+        if ( !queue->tasks.empty() ) {
+            task = queue->tasks.front();
+            queue->tasks.pop_front();
+            found = {true};
+        }
+    }
+    if ( !found ) {
+        found = steal( iWorker, task );
+        if ( found ) queue->nStolen++;
+    }
+    if ( found ) {
+        queue->nTasks++;
+        queue->nEntries += task.last - task.first;
+    }
+    return found;
+}
+
+//________________
+bool TaskScheduler::steal(const unsigned int& iWorker, EntryTask& task) {
+    // Victim may be emptied by another thief: look again until all queues are empty
+    while ( true ) {
+        WorkerQueue *victim{nullptr};
+        std::size_t nLeft{0};
+        for (unsigned int i{0}; i<fQueues.size(); i++) {
+            if ( i == iWorker ) continue;
+            std::lock_guard<std::mutex> lock( fQueues.at(i)->mutex );
+            if ( fQueues.at(i)->tasks.size() > nLeft ) {
+                nLeft = fQueues.at(i)->tasks.size();
+                victim = fQueues.at(i);
+            }
+        }
+        if ( !victim ) return false;
+
+        // Take the task the victim would process last
+        std::lock_guard<std::mutex> lock( victim->mutex );
+        if ( !victim->tasks.empty() ) {
+            task = victim->tasks.back();
+            victim->tasks.pop_back();
+            return true;
+        }
+    }
+}
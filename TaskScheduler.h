@@ -0,0 +1,80 @@
+/**
+ * @file TaskScheduler.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Work-stealing scheduler of entry ranges processed by several threads
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef TaskScheduler_h
+#define TaskScheduler_h
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <deque>
+#include <mutex>
+#include <vector>
+
+//________________
+/// @brief Range of chain entries [first, last) processed as a single unit of work
+struct EntryTask {
+    /// @brief First entry
+    Long64_t first{0};
+    /// @brief Last entry (excluded)
+    Long64_t last{0};
+};
+
+//________________
+class TaskScheduler {
+  public:
+    /// @brief Constructor
+    /// @param nWorkers Number of threads that take tasks
+    TaskScheduler(const unsigned int& nWorkers = 1);
+    /// @brief Destructor
+    virtual ~TaskScheduler();
+
+    /// @brief Split tasks (ordered by entry) into consecutive blocks: one per worker
+    void addTasks(const std::vector<EntryTask>& tasks);
+    /// @brief Take the next task of the worker. If the worker has no tasks left,
+    /// the last task of the worker with the most tasks left is taken
+    /// @return false if no tasks are left
+    bool next(const unsigned int& iWorker, EntryTask& task);
+
+    /// @brief Return number of workers
+    unsigned int nWorkers() const                       { return fQueues.size(); }
+    /// @brief Return number of tasks done by the worker
+    Long64_t nTasks(const unsigned int& iWorker) const   { return fQueues.at(iWorker)->nTasks; }
+    /// @brief Return number of tasks the worker took from the other workers
+    Long64_t nStolen(const unsigned int& iWorker) const  { return fQueues.at(iWorker)->nStolen; }
+    /// @brief Return number of entries in the tasks done by the worker
+    Long64_t nEntries(const unsigned int& iWorker) const { return fQueues.at(iWorker)->nEntries; }
+
+  private:
+
+    /// @brief Tasks and statistics of a single worker
+    struct WorkerQueue {
+        /// @brief Guards the tasks (other workers may steal them)
+        std::mutex mutex;
+        /// @brief Tasks left: the owner takes them from the front, others from the back
+        std::deque<EntryTask> tasks;
+        /// @brief Number of tasks done
+        Long64_t nTasks{0};
+        /// @brief Number of tasks taken from the other workers
+        Long64_t nStolen{0};
+        /// @brief Number of entries in the tasks done
+        Long64_t nEntries{0};
+    };
+
+    /// @brief Take the last task of the worker with the most tasks left
+    bool steal(const unsigned int& iWorker, EntryTask& task);
+
+    /// @brief Queues of all workers
+    std::vector<WorkerQueue*> fQueues;
+};
+
+#endif // #define TaskScheduler_h
@@ -0,0 +1,112 @@
+/**
+ * @file TrackCut.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Track quality selection
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "TrackCut.h"
+
+// ROOT headers
+#include "TString.h"
+
+// C++ headers
+#include <cmath>
+
+//________________
+TrackCut::TrackCut() : fPt{0.f, 1e6f}, fEta{-1e6f, 1e6f}, fHighPurity{false},
+    fPtErrOverPt{1e6f}, fDcaXYSignificance{1e6f}, fDcaZSignificance{1e6f},
+    fNHits{0}, fChi2PerNdofPerLayer{1e6f}, fCaloMatchingPt{-1.f}, fCaloMatchingFraction{0.f},
+    fVerbose{false} {
+    /* Empty */
+}
+
+//________________
+TrackCut::~TrackCut() {
+    /* Empty */
+}
+
+//________________
+void TrackCut::setStandardSelection() {
+    setEta( -2.4f, 2.4f );
+    setHighPurity( true );
+    setPtErrOverPt( 0.1f );
+    setDcaSignificance( 3.f, 3.f );
+    setNHits( 11 );
+    setChi2PerNdofPerLayer( 0.18f );
+    setCaloMatching( 20.f, 0.5f );
+}
+
+//________________
+void TrackCut::report() {
+    TString report = "Reporting from TrackCut\n";
+    report += TString::Format( "--> pT                 :\t %f - %f\n", fPt[0], fPt[1] );
+    report += TString::Format( "--> eta                :\t %f - %f\n", fEta[0], fEta[1] );
+    report += TString::Format( "--> high purity        :\t %s\n", (fHighPurity) ? "true" : "false" );
+    report += TString::Format( "--> pT error / pT (max):\t %f\n", fPtErrOverPt );
+    report += TString::Format( "--> DCA xy / error(max):\t %f\n", fDcaXYSignificance );
+    report += TString::Format( "--> DCA z / error (max):\t %f\n", fDcaZSignificance );
+    report += TString::Format( "--> nHits (min)        :\t %d\n", fNHits );
+    report += TString::Format( "--> chi2/ndf/nLayers   :\t %f\n", fChi2PerNdofPerLayer );
+    if ( fCaloMatchingPt >= 0 ) {
+        report += TString::Format( "--> calo matching      :\t E > %f pT for pT > %f\n", fCaloMatchingFraction, fCaloMatchingPt );
+    }
+    std::cout << report.Data() << std::endl;
+}
+
+//________________
+bool TrackCut::pass(const TrackColumns& tracks, const int& index) {
+
+    const float pt = tracks.pt[index];
+    const float eta = tracks.eta[index];
+    bool goodKine = ( fPt[0] <= pt && pt <= fPt[1] && fEta[0] <= eta && eta <= fEta[1] );
+    bool goodPurity = ( !fHighPurity || tracks.highPurity[index] );
+    bool goodPtErr = ( tracks.ptErr[index] <= fPtErrOverPt * pt );
+    bool goodDca = ( std::fabs( tracks.dcaXY[index] ) <= fDcaXYSignificance * tracks.dcaXYErr[index] &&
+                     std::fabs( tracks.dcaZ[index] ) <= fDcaZSignificance * tracks.dcaZErr[index] );
+    bool goodHits = ( tracks.nHits[index] >= fNHits );
+    // Tracks without degrees of freedom or layers fail a finite chi2 cut
+    const float ndofLayers = static_cast<float>( tracks.nDOF[index] ) * tracks.nLayers[index];
+    bool goodChi2 = ( fChi2PerNdofPerLayer >= 1e6f ||
+                      ( ndofLayers > 0 && tracks.chi2[index] <= fChi2PerNdofPerLayer * ndofLayers ) );
+    bool goodCalo{true};
+    if ( fCaloMatchingPt >= 0 && pt > fCaloMatchingPt ) {
+        const float caloEt = ( tracks.pfEcal[index] + tracks.pfHcal[index] ) / std::cosh( eta );
+        goodCalo = ( caloEt > fCaloMatchingFraction * pt );
+    }
+
+    bool isGood = goodKine && goodPurity && goodPtErr && goodDca && goodHits && goodChi2 && goodCalo;
+
+    if ( fVerbose ) {
+        std::cout << "\n----- Track cut -----\n";
+        std::cout << Form("--> pT: %5.2f eta: %5.2f \t %s \n", pt, eta, ( goodKine ) ? "[passed]" : "[failed]" );
+        std::cout << Form("--> high purity \t %s \n", ( goodPurity ) ? "[passed]" : "[failed]" );
+        std::cout << Form("--> pT error: %5.3f \t %s \n", tracks.ptErr[index], ( goodPtErr ) ? "[passed]" : "[failed]" );
+        std::cout << Form("--> DCA xy: %5.3f z: %5.3f \t %s \n", tracks.dcaXY[index], tracks.dcaZ[index], 
+                          ( goodDca ) ? "[passed]" : "[failed]" );
+        std::cout << Form("--> nHits: %d \t %s \n", tracks.nHits[index], ( goodHits ) ? "[passed]" : "[failed]" );
+        std::cout << Form("--> chi2: %5.2f \t %s \n", tracks.chi2[index], ( goodChi2 ) ? "[passed]" : "[failed]" );
+        std::cout << Form("--> calo matching \t %s \n", ( goodCalo ) ? "[passed]" : "[failed]" );
+        std::cout << Form("--> good track : \t %s \n", (isGood) ? "[passed]" : "[failed]");
+    }
+
+    return isGood;
+}
+
+//________________
+bool TrackCut::pass(const GenTrackColumns& tracks, const int& index) {
+    const float pt = tracks.pt[index];
+    const float eta = tracks.eta[index];
+    bool isGood = ( tracks.charge[index] != 0 && fPt[0] <= pt && pt <= fPt[1] && 
+                    fEta[0] <= eta && eta <= fEta[1] );
+    if ( fVerbose ) {
+        std::cout << Form("--> gen particle pT: %5.2f eta: %5.2f charge: %d \t %s \n",
+                          pt, eta, tracks.charge[index], ( isGood ) ? "[passed]" : "[failed]" );
+    }
+    return isGood;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file TrackCut.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Track quality selection
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef TrackCut_h
+#define TrackCut_h
+
+// Jet analysis headers
+#include "TrackView.h"
+
+// ROOT headers
+#include "Rtypes.h"
+
+// C++ headers
+#include <iostream>
+
+//________________
+class TrackCut {
+  public:
+    /// @brief Constructor (all tracks pass)
+    TrackCut();
+    /// @brief Destructor
+    virtual ~TrackCut();
+
+    //
+    // Setters
+    //
+
+    /// @brief Track transverse momentum
+    void setPt(const float& lo, const float& hi)  { fPt[0] = lo; fPt[1] = hi; }
+    /// @brief Track pseudorapidity
+    void setEta(const float& lo, const float& hi) { fEta[0] = lo; fEta[1] = hi; }
+    /// @brief Require high purity tracks
+    void setHighPurity(const bool& require = true) { fHighPurity = require; }
+    /// @brief Maximal relative pT uncertainty
+    void setPtErrOverPt(const float& max)      { fPtErrOverPt = max; }
+    /// @brief Maximal DCA significance in the transverse plane and along the beam
+    void setDcaSignificance(const float& maxXY, const float& maxZ) { fDcaXYSignificance = maxXY; fDcaZSignificance = maxZ; }
+    /// @brief Minimal number of hits in the tracker
+    void setNHits(const int& min)              { fNHits = min; }
+    /// @brief Maximal chi2/ndf/nLayers
+    void setChi2PerNdofPerLayer(const float& max) { fChi2PerNdofPerLayer = max; }
+    /// @brief Require energy in the calorimeters (ECAL + HCAL) above fraction * pT
+    /// for tracks with pT above ptMin
+    void setCaloMatching(const float& ptMin = 20.f, const float& fraction = 0.5f)
+    { fCaloMatchingPt = ptMin; fCaloMatchingFraction = fraction; }
+    /// @brief Standard selection of charged particles in PbPb and pPb (2018)
+    void setStandardSelection();
+    /// @brief Set verbose mode
+    void setVerbose() { fVerbose = true; }
+
+    /// @brief Report cut limits
+    void report();
+    /// @brief Check if index-th track of the arrays passes the cut
+    virtual bool pass(const TrackColumns& tracks, const int& index);
+    /// @brief Check if index-th generated particle of the arrays passes the kinematic cuts.
+    /// Only charged particles pass
+    virtual bool pass(const GenTrackColumns& tracks, const int& index);
+
+  private:
+    /// @brief Track pT
+    float fPt[2];
+    /// @brief Track pseudorapidity
+    float fEta[2];
+    /// @brief High purity is required
+    bool  fHighPurity;
+    /// @brief Maximal pT error / pT
+    float fPtErrOverPt;
+    /// @brief Maximal |DCA| / error in the transverse plane
+    float fDcaXYSignificance;
+    /// @brief Maximal |DCA| / error along the beam
+    float fDcaZSignificance;
+    /// @brief Minimal number of hits
+    int   fNHits;
+    /// @brief Maximal chi2/ndf/nLayers
+    float fChi2PerNdofPerLayer;
+    /// @brief Calorimeter matching is applied above this pT (negative - not applied)
+    float fCaloMatchingPt;
+    /// @brief Minimal calorimeter energy / pT
+    float fCaloMatchingFraction;
+    /// @brief Print status for each track
+    bool  fVerbose;
+};
+
+#endif // #define TrackCut_h
@@ -0,0 +1,117 @@
+/**
+ * @file TrackView.cc
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Selected tracks of the event viewed over the track arrays of the reader
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// Jet analysis headers
+#include "TrackView.h"
+
+// C++ headers
+#include <numeric>
+
+namespace {
+
+//________________
+/// @brief Copy selected elements of the column to the front of the buffer
+template <typename T>
+const T *gather(BranchBuffer<T>& buffer, const T *column, const std::vector<int>& selected) {
+    if ( !column ) return nullptr;
+    // Buffers only grow: events reused from the pool do not allocate
+    if ( buffer.size() < selected.size() ) {
+        BranchBuffer<T> copy;
+        copy.allocate( selected.size() );
+        for (size_t i{0}; i<selected.size(); i++) copy[i] = column[ selected[i] ];
+        buffer = std::move( copy );
+    }
+    else {
+        // Indices are increasing: in-place copy of a detached view is safe
+        for (size_t i{0}; i<selected.size(); i++) buffer[i] = column[ selected[i] ];
+    }
+    return buffer.data();
+}
+
+} // namespace
+
+//________________
+TrackView::TrackView() : fColumns{}, fNTracksInput{0}, fSelected{} {
+    /* empty */
+}
+
+//________________
+void TrackView::clear() {
+    fColumns = TrackColumns{};
+    fNTracksInput = 0;
+    fSelected.clear();
+}
+
+//________________
+void TrackView::setColumns(const TrackColumns& columns, const int& nTracks) {
+    fColumns = columns;
+    fNTracksInput = ( nTracks > 0 ) ? nTracks : 0;
+    fSelected.clear();
+}
+
+//________________
+void TrackView::detach() {
+    TrackColumns columns;
+    columns.pt = gather( fPt, fColumns.pt, fSelected );
+    columns.eta = gather( fEta, fColumns.eta, fSelected );
+    columns.phi = gather( fPhi, fColumns.phi, fSelected );
+    columns.ptErr = gather( fPtErr, fColumns.ptErr, fSelected );
+    columns.dcaXY = gather( fDcaXY, fColumns.dcaXY, fSelected );
+    columns.dcaXYErr = gather( fDcaXYErr, fColumns.dcaXYErr, fSelected );
+    columns.dcaZ = gather( fDcaZ, fColumns.dcaZ, fSelected );
+    columns.dcaZErr = gather( fDcaZErr, fColumns.dcaZErr, fSelected );
+    columns.chi2 = gather( fChi2, fColumns.chi2, fSelected );
+    columns.pfEcal = gather( fPfEcal, fColumns.pfEcal, fSelected );
+    columns.pfHcal = gather( fPfHcal, fColumns.pfHcal, fSelected );
+    columns.mva = gather( fMva, fColumns.mva, fSelected );
+    columns.nDOF = gather( fNDOF, fColumns.nDOF, fSelected );
+    columns.nHits = gather( fNHits, fColumns.nHits, fSelected );
+    columns.nLayers = gather( fNLayers, fColumns.nLayers, fSelected );
+    columns.algo = gather( fAlgo, fColumns.algo, fSelected );
+    columns.charge = gather( fCharge, fColumns.charge, fSelected );
+    columns.highPurity = gather( fHighPurity, fColumns.highPurity, fSelected );
+    fColumns = columns;
+    fNTracksInput = static_cast<int>( fSelected.size() );
+    std::iota( fSelected.begin(), fSelected.end(), 0 );
+}
+
+//________________
+GenTrackView::GenTrackView() : fColumns{}, fNTracksInput{0}, fSelected{} {
+    /* empty */
+}
+
+//________________
+void GenTrackView::clear() {
+    fColumns = GenTrackColumns{};
+    fNTracksInput = 0;
+    fSelected.clear();
+}
+
+//________________
+void GenTrackView::setColumns(const GenTrackColumns& columns, const int& nTracks) {
+    fColumns = columns;
+    fNTracksInput = ( nTracks > 0 ) ? nTracks : 0;
+    fSelected.clear();
+}
+
+//________________
+void GenTrackView::detach() {
+    GenTrackColumns columns;
+    columns.pt = gather( fPt, fColumns.pt, fSelected );
+    columns.eta = gather( fEta, fColumns.eta, fSelected );
+    columns.phi = gather( fPhi, fColumns.phi, fSelected );
+    columns.charge = gather( fCharge, fColumns.charge, fSelected );
+    columns.pdg = gather( fPdg, fColumns.pdg, fSelected );
+    columns.sube = gather( fSube, fColumns.sube, fSelected );
+    fColumns = columns;
+    fNTracksInput = static_cast<int>( fSelected.size() );
+    std::iota( fSelected.begin(), fSelected.end(), 0 );
+}
@@ -0,0 +1,201 @@
+/**
+ * @file TrackView.h
+ * @author Grigory Nigmatkulov (gnigmat@uic.edu)
+ * @brief Selected tracks of the event viewed over the track arrays of the reader
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef TrackView_h
+#define TrackView_h
+
+// Jet analysis headers
+#include "BranchBuffer.h"
+
+// C++ headers
+#include <vector>
+
+//________________
+/// @brief Track arrays of the input (one value per track)
+struct TrackColumns {
+    const float *pt{nullptr};
+    const float *eta{nullptr};
+    const float *phi{nullptr};
+    const float *ptErr{nullptr};
+    const float *dcaXY{nullptr};
+    const float *dcaXYErr{nullptr};
+    const float *dcaZ{nullptr};
+    const float *dcaZErr{nullptr};
+    const float *chi2{nullptr};
+    const float *pfEcal{nullptr};
+    const float *pfHcal{nullptr};
+    const float *mva{nullptr};
+    const unsigned char *nDOF{nullptr};
+    const unsigned char *nHits{nullptr};
+    const unsigned char *nLayers{nullptr};
+    const unsigned char *algo{nullptr};
+    const int *charge{nullptr};
+    const bool *highPurity{nullptr};
+};
+
+//________________
+/// @brief Generated particle arrays of the input (one value per particle)
+struct GenTrackColumns {
+    const float *pt{nullptr};
+    const float *eta{nullptr};
+    const float *phi{nullptr};
+    const int *charge{nullptr};
+    const int *pdg{nullptr};
+    const int *sube{nullptr};
+};
+
+//________________
+/// @brief Tracks that passed the selection. The i-th track is the index(i)-th
+/// element of the input arrays: no object is created per track
+class TrackView {
+  public:
+    /// @brief Constructor
+    TrackView();
+    /// @brief Destructor
+    virtual ~TrackView() { /* empty */ }
+
+    /// @brief Remove all tracks (memory is kept for the next event)
+    void clear();
+    /// @brief View arrays of nTracks tracks. No track is selected
+    void setColumns(const TrackColumns& columns, const int& nTracks);
+    /// @brief Add track with the given index in the arrays
+    void select(const int& index) { fSelected.push_back( index ); }
+    /// @brief Copy selected tracks into arrays owned by the view. Needed when the
+    /// input arrays are overwritten before the event is used (read-ahead)
+    void detach();
+
+    /// @brief Number of selected tracks
+    size_t size() const { return fSelected.size(); }
+    /// @brief Number of tracks in the input arrays
+    int nTracksInput() const { return fNTracksInput; }
+    /// @brief Index of the i-th selected track in the input arrays
+    int index(const size_t& i) const { return fSelected[i]; }
+    /// @brief Arrays the view points to
+    const TrackColumns& columns() const { return fColumns; }
+
+    /// @brief Transverse momentum
+    float pt(const size_t& i) const         { return fColumns.pt[ fSelected[i] ]; }
+    /// @brief Pseudorapidity
+    float eta(const size_t& i) const        { return fColumns.eta[ fSelected[i] ]; }
+    /// @brief Azimuthal angle
+    float phi(const size_t& i) const        { return fColumns.phi[ fSelected[i] ]; }
+    /// @brief Transverse momentum uncertainty
+    float ptErr(const size_t& i) const      { return fColumns.ptErr[ fSelected[i] ]; }
+    /// @brief Distance of closest approach in the transverse plane and its error
+    float dcaXY(const size_t& i) const      { return fColumns.dcaXY[ fSelected[i] ]; }
+    float dcaXYErr(const size_t& i) const   { return fColumns.dcaXYErr[ fSelected[i] ]; }
+    /// @brief Distance of closest approach along the beam and its error
+    float dcaZ(const size_t& i) const       { return fColumns.dcaZ[ fSelected[i] ]; }
+    float dcaZErr(const size_t& i) const    { return fColumns.dcaZErr[ fSelected[i] ]; }
+    /// @brief Fit chi2 and number of degrees of freedom
+    float chi2(const size_t& i) const       { return fColumns.chi2[ fSelected[i] ]; }
+    int nDOF(const size_t& i) const         { return fColumns.nDOF[ fSelected[i] ]; }
+    /// @brief Number of hits and of layers with measurement
+    int nHits(const size_t& i) const        { return fColumns.nHits[ fSelected[i] ]; }
+    int nLayers(const size_t& i) const      { return fColumns.nLayers[ fSelected[i] ]; }
+    /// @brief Tracking algorithm (step) and its MVA value
+    int algo(const size_t& i) const         { return fColumns.algo[ fSelected[i] ]; }
+    float mva(const size_t& i) const        { return fColumns.mva[ fSelected[i] ]; }
+    /// @brief Charge
+    int charge(const size_t& i) const       { return fColumns.charge[ fSelected[i] ]; }
+    /// @brief High purity flag
+    bool highPurity(const size_t& i) const  { return fColumns.highPurity[ fSelected[i] ]; }
+    /// @brief Particle flow energy in ECAL and HCAL matched to the track
+    float pfEcal(const size_t& i) const     { return fColumns.pfEcal[ fSelected[i] ]; }
+    float pfHcal(const size_t& i) const     { return fColumns.pfHcal[ fSelected[i] ]; }
+
+  private:
+    /// @brief Arrays the view points to
+    TrackColumns fColumns;
+    /// @brief Number of tracks in the arrays
+    int fNTracksInput;
+    /// @brief Indices of the selected tracks
+    std::vector<int> fSelected;
+
+    /// @brief Copies of the selected tracks (filled by detach)
+    BranchBuffer<float> fPt;
+    BranchBuffer<float> fEta;
+    BranchBuffer<float> fPhi;
+    BranchBuffer<float> fPtErr;
+    BranchBuffer<float> fDcaXY;
+    BranchBuffer<float> fDcaXYErr;
+    BranchBuffer<float> fDcaZ;
+    BranchBuffer<float> fDcaZErr;
+    BranchBuffer<float> fChi2;
+    BranchBuffer<float> fPfEcal;
+    BranchBuffer<float> fPfHcal;
+    BranchBuffer<float> fMva;
+    BranchBuffer<unsigned char> fNDOF;
+    BranchBuffer<unsigned char> fNHits;
+    BranchBuffer<unsigned char> fNLayers;
+    BranchBuffer<unsigned char> fAlgo;
+    BranchBuffer<int> fCharge;
+    BranchBuffer<bool> fHighPurity;
+};
+
+//________________
+/// @brief Generated particles that passed the selection (see TrackView)
+class GenTrackView {
+  public:
+    /// @brief Constructor
+    GenTrackView();
+    /// @brief Destructor
+    virtual ~GenTrackView() { /* empty */ }
+
+    /// @brief Remove all particles (memory is kept for the next event)
+    void clear();
+    /// @brief View arrays of nTracks particles. No particle is selected
+    void setColumns(const GenTrackColumns& columns, const int& nTracks);
+    /// @brief Add particle with the given index in the arrays
+    void select(const int& index) { fSelected.push_back( index ); }
+    /// @brief Copy selected particles into arrays owned by the view
+    void detach();
+
+    /// @brief Number of selected particles
+    size_t size() const { return fSelected.size(); }
+    /// @brief Number of particles in the input arrays
+    int nTracksInput() const { return fNTracksInput; }
+    /// @brief Index of the i-th selected particle in the input arrays
+    int index(const size_t& i) const { return fSelected[i]; }
+    /// @brief Arrays the view points to
+    const GenTrackColumns& columns() const { return fColumns; }
+
+    /// @brief Transverse momentum
+    float pt(const size_t& i) const  { return fColumns.pt[ fSelected[i] ]; }
+    /// @brief Pseudorapidity
+    float eta(const size_t& i) const { return fColumns.eta[ fSelected[i] ]; }
+    /// @brief Azimuthal angle
+    float phi(const size_t& i) const { return fColumns.phi[ fSelected[i] ]; }
+    /// @brief Charge
+    int charge(const size_t& i) const { return fColumns.charge[ fSelected[i] ]; }
+    /// @brief PDG code
+    int pdg(const size_t& i) const   { return fColumns.pdg[ fSelected[i] ]; }
+    /// @brief Sub-event index (0 - signal)
+    int sube(const size_t& i) const  { return fColumns.sube[ fSelected[i] ]; }
+
+  private:
+    /// @brief Arrays the view points to
+    GenTrackColumns fColumns;
+    /// @brief Number of particles in the arrays
+    int fNTracksInput;
+    /// @brief Indices of the selected particles
+    std::vector<int> fSelected;
+
+    /// @brief Copies of the selected particles (filled by detach)
+    BranchBuffer<float> fPt;
+    BranchBuffer<float> fEta;
+    BranchBuffer<float> fPhi;
+    BranchBuffer<int> fCharge;
+    BranchBuffer<int> fPdg;
+    BranchBuffer<int> fSube;
+};
+
+#endif // #define TrackView_h
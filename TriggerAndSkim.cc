@@ -13,71 +13,103 @@
 #include "TriggerAndSkim.h"
 
 // C++ headers
-#include <limits>
+#include <cstring>
+
+namespace {
+
+/// @brief Registry entry: branch name and type of the flag
+struct FlagInfo {
+    const char *name;
+    bool isSkimFilter;
+};
+
+/// @brief Flags in the order of TriggerAndSkim::Flag
+const FlagInfo kFlagTable[] = {
+    // HLT
+    { "HLT_HIAK4CaloJet60_v1", false },
+    { "HLT_HIAK4CaloJet80_v1", false },
+    { "HLT_PAAK4CaloJet60_Eta5p1_v3", false },
+    { "HLT_PAAK4CaloJet80_Eta5p1_v3", false },
+    { "HLT_PAAK4CaloJet100_Eta5p1_v3", false },
+    { "HLT_PAAK4PFJet60_Eta5p1_v4", false },
+    { "HLT_PAAK4PFJet80_Eta5p1_v3", false },
+    { "HLT_PAAK4PFJet100_Eta5p1_v3", false },
+    { "HLT_PAAK4PFJet120_Eta5p1_v2", false },
+
+    { "HLT_HIAK4PFJet15_v1", false },
+    { "HLT_HIAK4PFJet30_v1", false },
+    { "HLT_HIAK4PFJet40_v1", false },
+    { "HLT_HIAK4PFJet60_v1", false },
+    { "HLT_HIAK4PFJet80_v1", false },
+    { "HLT_HIAK4PFJet120_v1", false },
+
+    { "HLT_HIAK8PFJet15_v1", false },
+    { "HLT_HIAK8PFJet25_v1", false },
+    { "HLT_HIAK8PFJet40_v1", false },
+    { "HLT_HIAK8PFJet60_v1", false },
+    { "HLT_HIAK8PFJet80_v1", false },
+    { "HLT_HIAK8PFJet140_v1", false },
+
+    { "HLT_HIPFJet25_v1", false },
+    { "HLT_HIPFJet140_v1", false },
+
+    { "HLT_HIPuAK4CaloJet80Eta5p1_v1", false },
+    { "HLT_HIPuAK4CaloJet100Eta5p1_v1", false },
+
+    // Skimming filters
+    { "HBHENoiseFilterResultRun2Loose", true },
+    { "HBHENoiseFilterResultRun2Tight", true },
+    { "HBHEIsoNoiseFilterResult", true },
+    { "collisionEventSelectionAODv2", true },
+    { "phfCoincFilter2Th4", true },
+    { "pPAprimaryVertexFilter", true },
+    { "pBeamScrapingFilter", true },
+    { "pprimaryVertexFilter", true },
+    { "pVertexFilterCutG", true },
+    { "pVertexFilterCutGloose", true },
+    { "pVertexFilterCutGtight", true },
+    { "pVertexFilterCutE", true },
+    { "pVertexFilterCutEandG", true },
+    { "pclusterCompatibilityFilter", true },
+
+    { "phfCoincFilter", true },
+    { "pVertexFilterCutdz1p0", true },
+    { "pVertexFilterCutGplus", true },
+    { "pVertexFilterCutVtx1", true }
+};
+
+static_assert( sizeof(kFlagTable) / sizeof(kFlagTable[0]) == TriggerAndSkim::kNFlags,
+               "Flag table does not match TriggerAndSkim::Flag" );
+
+} // namespace
+
+//________________
+const char *TriggerAndSkim::flagName(const int& flag) {
+    return ( flag >= 0 && flag < kNFlags ) ? kFlagTable[flag].name : "";
+}
+
+//________________
+int TriggerAndSkim::flagIndex(const char *name) {
+    for (int iFlag{0}; iFlag<kNFlags; iFlag++) {
+        if ( std::strcmp( kFlagTable[iFlag].name, name ) == 0 ) return iFlag;
+    }
+    return -1;
+}
+
+//________________
+bool TriggerAndSkim::isSkimFilter(const int& flag) {
+    return ( flag >= 0 && flag < kNFlags ) && kFlagTable[flag].isSkimFilter;
+}
 
 //________________
-TriggerAndSkim::TriggerAndSkim() :
-  fHLT_HIAK4CaloJet60_v1{0},
-  fHLT_HIAK4CaloJet80_v1{0},
-  fHLT_PAAK4CaloJet60_Eta5p1_v3{0},
-  fHLT_PAAK4CaloJet80_Eta5p1_v3{0},
-  fHLT_PAAK4CaloJet100_Eta5p1_v3{0},
-  fHLT_PAAK4PFJet60_Eta5p1_v4{0},
-  fHLT_PAAK4PFJet80_Eta5p1_v3{0},
-  fHLT_PAAK4PFJet100_Eta5p1_v3{0},
-  fHLT_PAAK4PFJet120_Eta5p1_v2{0},
-  fHLT_HIAK4PFJet15_v1{0},
-  fHLT_HIAK4PFJet15_v1_Prescl{0},
-  fHLT_HIAK4PFJet30_v1{0},
-  fHLT_HIAK4PFJet30_v1_Prescl{0},
-  fHLT_HIAK4PFJet40_v1{0},
-  fHLT_HIAK4PFJet40_v1_Prescl{0},
-  fHLT_HIAK4PFJet60_v1{0},
-  fHLT_HIAK4PFJet60_v1_Prescl{0},
-  fHLT_HIAK4PFJet80_v1{0},
-  fHLT_HIAK4PFJet80_v1_Prescl{0},
-  fHLT_HIAK4PFJet120_v1{0},
-  fHLT_HIAK4PFJet120_v1_Prescl{0},
-
-  fHLT_HIAK8PFJet15_v1{0},
-  fHLT_HIAK8PFJet15_v1_Prescl{0},
-  fHLT_HIAK8PFJet25_v1{0},
-  fHLT_HIAK8PFJet25_v1_Prescl{0},
-  fHLT_HIAK8PFJet40_v1{0},
-  fHLT_HIAK8PFJet40_v1_Prescl{0},
-  fHLT_HIAK8PFJet60_v1{0},
-  fHLT_HIAK8PFJet60_v1_Prescl{0},
-  fHLT_HIAK8PFJet80_v1{0},
-  fHLT_HIAK8PFJet80_v1_Prescl{0},
-  fHLT_HIAK8PFJet140_v1{0},
-  fHLT_HIAK8PFJet140_v1_Prescl{0},
-
-  fHLT_HIPFJet25_v1{0},
-  fHLT_HIPFJet25_v1_Prescl{0},
-  fHLT_HIPFJet140_v1{0},
-  fHLT_HIPFJet140_v1_Prescl{0},
-
-  fHLT_HIPuAK4CaloJet80Eta5p1_v1{0},
-  fHLT_HIPuAK4CaloJet100Eta5p1_v1{0},
-  
-  fHBHENoiseFilterResultRun2Loose{0},
-  fHBHENoiseFilterResultRun2Tight{0},
-  fHBHEIsoNoiseFilterResult{0},
-  fCollisionEventSelectionAODv2{0},
-  fPhfCoincFilter2Th4{0},
-  fPPAprimaryVertexFilter{0},
-  fPBeamScrapingFilter{0},
-  fPprimaryVertexFilter{0},
-  fPVertexFilterCutG{0},
-  fPVertexFilterCutGloose{0},
-  fPVertexFilterCutGtight{0},
-  fPVertexFilterCutE{0},
-  fPVertexFilterCutEandG{0},
-  fPClusterCompatibilityFilter{0},
-  
-  fPhfCoincFilter{0},
-  fPVertexFilterCutdz1p0{0},
-  fPVertexFilterCutGplus{0},
-  fPVertexFilterCutVtx1{0} {
-    /* empty */
-}
\ No newline at end of file
+ULong64_t TriggerAndSkim::skimFilterMask() {
+    // Table does not change: the mask is built once
+    static const ULong64_t mask = []() {
+        ULong64_t bits{0};
+        for (int iFlag{0}; iFlag<kNFlags; iFlag++) {
+            if ( kFlagTable[iFlag].isSkimFilter ) bits |= flagBit(iFlag);
+        }
+        return bits;
+    }();
+    return mask;
+}
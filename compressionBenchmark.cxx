@@ -0,0 +1,187 @@
+// C++ headers
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Jet analysis headers
+#include "ForestSkimmer.h"
+#include "ForestTools.h"
+
+// ROOT headers
+#include "TString.h"
+#include "TSystem.h"
+
+//________________
+void usage() {
+    std::cout << "./compressionBenchmark inputFile outputDir isMc jetTree codecs levels basketSizes nEvents nRepeats branches keepFiles path2JetAnalysis" << std::endl;
+    std::cout << "inputFile: sample forest file (.root)" << std::endl;
+    std::cout << "outputDir: directory for the rewritten files" << std::endl;
+    std::cout << "isMc: 1 (embedding or pythia), 0 (data)" << std::endl;
+    std::cout << "jetTree: jet tree copied and read (default: akCs4PFJetAnalyzer)" << std::endl;
+    std::cout << "codecs: comma-separated ZLIB, LZ4, ZSTD, LZMA (default: ZLIB,LZ4,ZSTD,LZMA)" << std::endl;
+    std::cout << "levels: comma-separated compression levels (default: 1,4,8)" << std::endl;
+    std::cout << "basketSizes: comma-separated basket sizes in bytes, 0 - as input (default: 0,32000,256000)" << std::endl;
+    std::cout << "nEvents: events read with ForestAODReader, -1 - all (default: -1)" << std::endl;
+    std::cout << "nRepeats: reads of each file, the fastest one is used (default: 2)" << std::endl;
+    std::cout << "branches: all, reader (branches read by ForestAODReader) or \"dir:pattern,pattern;dir:pattern\" (default: reader)" << std::endl;
+    std::cout << "keepFiles: 1 - keep the rewritten files, 0 - remove them (default: 0)" << std::endl;
+    std::cout << "path2JetAnalysis: directory with aux_files used for JEC (default: ../)" << std::endl;
+}
+
+//________________
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream( list );
+    std::string item;
+    while ( getline( stream, item, ',' ) ) {
+        if ( !item.empty() ) items.push_back( item );
+    }
+    return items;
+}
+
+//________________
+/// @brief Best reading rate of several reads of the file
+double bestReadingRate(const char *input, const bool& isMc, const std::string& jetTree, const TString& path2JetAnalysis,
+                       const Long64_t& nEvents, const int& nRepeats, Long64_t& nRead) {
+    double best{0};
+    for (int iRepeat{0}; iRepeat<nRepeats; iRepeat++) {
+        best = std::max( best, ForestTools::readEvents( input, isMc, jetTree, path2JetAnalysis.Data(), nEvents, nRead ) );
+    }
+    return best;
+}
+
+//________________
+/// @brief Rewrite a forest file with a matrix of codecs, levels and basket sizes and
+/// compare file sizes and ForestAODReader reading rates
+/// @param argc Number of arguments
+/// @param argv Argument list
+/// @return 0 in case of OKAY
+int main(int argc, char const *argv[]) {
+
+    std::cout << "Starting compressionBenchmark program" << std::endl;
+
+    if ( argc < 3 ) {
+        std::cout << "Too few arguments passed. Terminating" << std::endl;
+        usage();
+        return -1;
+    }
+
+    TString inFileName = argv[1];
+    TString outDir = argv[2];
+    bool isMc = ( argc > 3 ) ? atoi( argv[3] ) : false;
+    std::string jetTree = ( argc > 4 ) ? argv[4] : "akCs4PFJetAnalyzer";
+    std::vector<std::string> codecs = splitList( ( argc > 5 ) ? argv[5] : "ZLIB,LZ4,ZSTD,LZMA" );
+    std::vector<std::string> levels = splitList( ( argc > 6 ) ? argv[6] : "1,4,8" );
+    std::vector<std::string> basketSizes = splitList( ( argc > 7 ) ? argv[7] : "0,32000,256000" );
+    Long64_t nEvents = ( argc > 8 ) ? atoll( argv[8] ) : -1;
+    int nRepeats = ( argc > 9 ) ? std::max( atoi( argv[9] ), 1 ) : 2;
+    const char *branches = ( argc > 10 ) ? argv[10] : "reader";
+    bool keepFiles = ( argc > 11 ) ? atoi( argv[11] ) : false;
+    TString path2JetAnalysis = ( argc > 12 ) ? argv[12] : "../";
+
+    std::cout << "Arguments passed:\n"
+              << "Input file name        : " << inFileName << std::endl
+              << "Output directory       : " << outDir << std::endl
+              << "Is MC                  : " << isMc << std::endl
+              << "Jet tree               : " << jetTree << std::endl
+              << "Codecs                 : " << ( ( argc > 5 ) ? argv[5] : "ZLIB,LZ4,ZSTD,LZMA" ) << std::endl
+              << "Levels                 : " << ( ( argc > 6 ) ? argv[6] : "1,4,8" ) << std::endl
+              << "Basket sizes           : " << ( ( argc > 7 ) ? argv[7] : "0,32000,256000" ) << std::endl
+              << "Number of events       : " << nEvents << std::endl
+              << "Number of repeats      : " << nRepeats << std::endl
+              << "Branches               : " << branches << std::endl
+              << "Keep files             : " << keepFiles << std::endl
+              << std::endl;
+
+    FileStat_t inStat;
+    if ( gSystem->GetPathInfo( inFileName.Data(), inStat ) != 0 ) {
+        std::cerr << "Cannot find " << inFileName << ". Terminating" << std::endl;
+        return -1;
+    }
+    gSystem->mkdir( outDir.Data(), kTRUE );
+
+    //
+    // Input file is the reference
+    //
+    Long64_t nRead{0};
+    const double inputRate = bestReadingRate( inFileName.Data(), isMc, jetTree, path2JetAnalysis, nEvents, nRepeats, nRead );
+    const Long64_t inputEvents = nRead;
+
+    struct Row {
+        std::string codec;
+        int level;
+        int basketSize;
+        int settings;
+        Long64_t bytes;
+        double writeSeconds;
+        double rate;
+        Long64_t nEvents;
+    };
+    std::vector<Row> rows;
+
+    //
+    // Rewrite the file for every codec, level and basket size and read it back
+    //
+    for (const auto& codec : codecs) {
+        for (const auto& level : levels) {
+            const int settings = ForestSkimmer::compressionSettings( Form("%s:%s", codec.c_str(), level.c_str()) );
+            if ( settings < 0 ) {
+                std::cerr << "[WARNING] Unknown compression " << codec << ":" << level << ". Skipping" << std::endl;
+                continue;
+            }
+            for (const auto& basket : basketSizes) {
+                const int basketSize = std::max( atoi( basket.c_str() ), 0 );
+
+                // Event selection is not applied: the files differ by the format only
+                ForestSkimmer skimmer;
+                skimmer.addTree( "hiEvtAnalyzer", "HiTree" );
+                skimmer.addTree( "hltanalysis", "HltTree" );
+                skimmer.addTree( "skimanalysis", "HltTree" );
+                skimmer.addTree( jetTree.c_str(), "t" );
+                skimmer.keepBranches( branches );
+                skimmer.setCompression( settings );
+                skimmer.setBasketSize( basketSize );
+
+                TString outFileName = Form("%s/%s%d_basket%d.root", outDir.Data(), codec.c_str(), atoi( level.c_str() ), basketSize);
+                ForestSkimmer::Result result = skimmer.skim( inFileName.Data(), outFileName.Data() );
+                if ( !result.isGood ) {
+                    std::cerr << "[ERROR] Cannot rewrite " << inFileName << " into " << outFileName << ". Skipping" << std::endl;
+                    continue;
+                }
+
+                Row row{ codec, atoi( level.c_str() ), basketSize, settings, result.outBytes, result.seconds, 0., 0 };
+                row.rate = bestReadingRate( outFileName.Data(), isMc, jetTree, path2JetAnalysis, nEvents, nRepeats, row.nEvents );
+                rows.push_back( row );
+                if ( !keepFiles ) gSystem->Unlink( outFileName.Data() );
+            }
+        }
+    }
+
+    //
+    // Print table
+    //
+    std::cout << "\nFiles are read right after writing (page cache): the rates compare decompression and deserialization\n";
+    std::cout << Form("%-8s %6s %10s %9s %10s %8s %10s %12s %10s\n",
+                      "Codec", "Level", "Basket", "Settings", "Size, MB", "Size/In", "Write, s", "Events/s", "Rate/In");
+    std::cout << Form("%-8s %6s %10s %9s %10.2f %8.3f %10s %12.1f %10.3f\n",
+                      "input", "-", "-", "-", inStat.fSize / 1024. / 1024., 1., "-", inputRate, 1.);
+    bool isConsistent{true};
+    for (const auto& row : rows) {
+        const std::string basket = ( row.basketSize > 0 ) ? std::to_string( row.basketSize ) : "input";
+        std::cout << Form("%-8s %6d %10s %9d %10.2f %8.3f %10.2f %12.1f %10.3f\n",
+                          row.codec.c_str(), row.level, basket.c_str(),
+                          row.settings, row.bytes / 1024. / 1024.,
+                          ( inStat.fSize > 0 ) ? static_cast<double>( row.bytes ) / inStat.fSize : 0.,
+                          row.writeSeconds, row.rate, ( inputRate > 0 ) ? row.rate / inputRate : 0.);
+        isConsistent = isConsistent && ( row.nEvents == inputEvents );
+    }
+    if ( !isConsistent ) {
+        std::cerr << "[ERROR] Numbers of events read from the rewritten files differ from the input" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -17,7 +17,7 @@
 
 //________________
 void usage() {
-    std::cout << "./programName inputFileList oFileName isMc isPbGoingDir ptHatLow ptHatHi jeuSyst jerSyst triggerId recoJetSelMethod" << std::endl;
+    std::cout << "./programName inputFileList oFileName isMc isPbGoingDir ptHatLow ptHatHi jeuSyst jerSyst triggerId recoJetSelMethod nThreads shardIndex nShards firstEntry lastEntry readAheadDepth checkpointFile nProcesses samplingStep samplingBlockSize eventBudget timeBudget treeCacheSizeMB asyncPrefetch" << std::endl;
     std::cout << "isMc: 0 (data), 1 (embedding), 2 (pythia)" << std::endl;
     std::cout << "isPbGoingDir: 1 (Pb-going), 0 (p-going)" << std::endl;
     std::cout << "ptHatLow: Low ptHat cut (for embedding)" << std::endl;
@@ -26,6 +26,16 @@ void usage() {
     std::cout << "jerSyst: 0 (default), 1 (JER+), -1 (JER-), other - only JEC is applied" << std::endl;
     std::cout << "triggerId: 0 - no trigger (or MB), 1 - jet60, 2 - jet80, 3 - jet100" << std::endl;
     std::cout << "recoJetSelMethod: 0 - no selection, 1 - trkMaxPt/RawPt, 2 - jetId" << std::endl;
+    std::cout << "nThreads: number of threads to process events (default: 1)" << std::endl;
+    std::cout << "shardIndex nShards: process only shard shardIndex (0..nShards-1) of the entry range (default: 0 1)" << std::endl;
+    std::cout << "firstEntry lastEntry: process only entries [firstEntry, lastEntry) of the input, -1 means the end (default: 0 -1)" << std::endl;
+    std::cout << "readAheadDepth: number of events read ahead by a separate reader thread, 0 - no read-ahead (default: 0)" << std::endl;
+    std::cout << "checkpointFile: file for periodic checkpoints, the job resumes from it if it exists (default: none)" << std::endl;
+    std::cout << "nProcesses: number of forked processes to process events, use \"\" as checkpointFile to skip it (default: 1)" << std::endl;
+    std::cout << "samplingStep samplingBlockSize: process only the first of every samplingStep blocks of samplingBlockSize entries (default: 1 1)" << std::endl;
+    std::cout << "eventBudget timeBudget: stop after eventBudget events or timeBudget seconds, 0 - no limit (default: 0 0)" << std::endl;
+    std::cout << "treeCacheSizeMB: TTreeCache size of every chain in MB, -1 - 10 MB (50 MB for the jet tree) (default: -1)" << std::endl;
+    std::cout << "asyncPrefetch: 1 - prefetch baskets asynchronously, 0 - no prefetching (default: 0)" << std::endl;
 }
 
 //________________
@@ -148,7 +158,8 @@ ForestAODReader *createForestAODReader(const TString &inFileName, const bool &is
     const TString &collisionSystemName, const int &collisionSystem, const int &collEnergyGeV, 
     const int &collYear, const float &etaShift, const TString &path2JEC, const TString &JECFileName, 
     const TString &JECFileDataName, const TString &JEUFileName, const int &useJEUSyst, 
-    const int &useJERSyst, EventCut *eventCut = nullptr, JetCut *jetCut = nullptr) {
+    const int &useJERSyst, EventCut *eventCut = nullptr, JetCut *jetCut = nullptr, 
+    const int &treeCacheSizeMB = -1, const bool &asyncPrefetch = false) {
 
     // Create ForestAODReader object
     ForestAODReader *forestReader = new ForestAODReader{inFileName};
@@ -185,6 +196,16 @@ ForestAODReader *createForestAODReader(const TString &inFileName, const bool &is
     // Perform jet manual jet matching
     forestReader->fixJetArrays();
 
+    // Explicit TTreeCache per chain (remote reads on EOS): jet tree is the largest one
+    if ( treeCacheSizeMB >= 0 ) {
+        forestReader->setTreeCacheSize( static_cast<Long64_t>( treeCacheSizeMB ) * 1024 * 1024 );
+    }
+    else {
+        forestReader->setTreeCacheSize( 10 * 1024 * 1024 );
+        forestReader->setTreeCacheSize( "jet", 50 * 1024 * 1024 );
+    }
+    forestReader->useAsyncPrefetch( asyncPrefetch );
+
     // Set path to jet analysis directory (then will automatically add path to aux_files)
     forestReader->setPath2JetAnalysis( path2JEC.Data() );
     forestReader->addJECFile( JECFileName.Data() );
@@ -249,6 +270,15 @@ DiJetAnalysis *createDiJetAnalysis(const int &collisionSystem, const int &collEn
     return analysis;
 }
 
+//________________
+HistoManagerDiJet *createHistoManagerDiJet(const bool &isMc) {
+    HistoManagerDiJet *hm = new HistoManagerDiJet{};
+    hm->setIsMc( isMc );
+    hm->setUseVariableBinning( false ); // Use variable binning for eta (mainly dijet)
+    hm->init();
+    return hm;
+}
+
 //________________
 /// @brief The prorgram that launches the physics analysis
 /// @param argc Number of arguments
@@ -296,6 +326,20 @@ int main(int argc, char const *argv[]) {
     float etaShift = 0.465;
     int   triggerId{0};     // 0 - no trigger (or MB), 1 - jet60, 2 - jet80, 3 - jet100
     int   recoJetSelMethod{1}; // 0 - no selection, 1 - trkMaxPt/RawPt, 2 - jetId
+    int   nThreads{1};         // Number of threads to process events
+    int   shardIndex{0};       // Shard of the entry range to process
+    int   nShards{1};          // Number of shards the entry range is split into
+    Long64_t firstEntry{0};    // First entry to process
+    Long64_t lastEntry{-1};    // Last entry to process (excluded), -1 - till the end
+    int   readAheadDepth{0};   // Number of events read ahead by a separate reader thread
+    TString checkpointFileName{}; // Checkpoint file (empty - no checkpoints)
+    int   nProcesses{1};       // Number of processes to process events
+    Long64_t samplingStep{1};  // Process every samplingStep-th block of entries
+    Long64_t samplingBlockSize{1}; // Number of consecutive entries in the sampling block
+    Long64_t eventBudget{0};   // Maximal number of events to process (0 - no limit)
+    double timeBudget{0};      // Maximal time of the event loop in seconds (0 - no limit)
+    int   treeCacheSizeMB{-1}; // TTreeCache size of every chain in MB (-1 - default per chain)
+    bool  asyncPrefetch{false}; // Prefetch baskets asynchronously
 
     // Sequence of command line arguments:
     //
@@ -309,6 +353,20 @@ int main(int argc, char const *argv[]) {
     // useJERSyst                     - 0 (default), 1 (JER+), -1 (JER-)
     // triggerId                      - 0 - no trigger (or MB), 1 - jet60, 2 - jet80, 3 - jet100
     // recoJetSelMethod               - 0 - no selection, 1 - trkMaxPt/RawPt, 2 - jetId
+    // nThreads                       - number of threads to process events (default: 1)
+    // shardIndex                     - shard of the entry range to process (default: 0)
+    // nShards                        - number of shards the entry range is split into (default: 1)
+    // firstEntry                     - first entry to process (default: 0)
+    // lastEntry                      - last entry to process, excluded (default: -1 - till the end)
+    // readAheadDepth                 - number of events read ahead by a reader thread (default: 0 - no read-ahead)
+    // checkpointFile                 - file for periodic checkpoints, the job resumes from it (default: none)
+    // nProcesses                     - number of forked processes to process events (default: 1)
+    // samplingStep                   - process every samplingStep-th block of entries (default: 1)
+    // samplingBlockSize              - number of consecutive entries in the block (default: 1)
+    // eventBudget                    - maximal number of events to process (default: 0 - no limit)
+    // timeBudget                     - maximal time of the event loop in seconds (default: 0 - no limit)
+    // treeCacheSizeMB                - TTreeCache size of every chain in MB (default: -1 - 10 MB, 50 MB for jets)
+    // asyncPrefetch                  - 1 - prefetch baskets asynchronously (default: 0)
 
     // Read input argument list 
     if (argc <= 1) {
@@ -346,6 +404,43 @@ int main(int argc, char const *argv[]) {
         else {
             recoJetSelMethod = atoi( argv[10] );
         }
+        if (argc <= 11 ) {
+            nThreads = 1;
+        }
+        else {
+            nThreads = atoi( argv[11] );
+        }
+        if (argc > 13 ) {
+            shardIndex = atoi( argv[12] );
+            nShards = atoi( argv[13] );
+        }
+        if (argc > 15 ) {
+            firstEntry = atoll( argv[14] );
+            lastEntry = atoll( argv[15] );
+        }
+        if (argc > 16 ) {
+            readAheadDepth = atoi( argv[16] );
+        }
+        if (argc > 17 ) {
+            checkpointFileName = argv[17];
+        }
+        if (argc > 18 ) {
+            nProcesses = atoi( argv[18] );
+        }
+        if (argc > 20 ) {
+            samplingStep = atoll( argv[19] );
+            samplingBlockSize = atoll( argv[20] );
+        }
+        if (argc > 22 ) {
+            eventBudget = atoll( argv[21] );
+            timeBudget = atof( argv[22] );
+        }
+        if (argc > 23 ) {
+            treeCacheSizeMB = atoi( argv[23] );
+        }
+        if (argc > 24 ) {
+            asyncPrefetch = atoi( argv[24] );
+        }
     }
 
     std::cout << "Arguments passed:\n"
@@ -361,6 +456,15 @@ int main(int argc, char const *argv[]) {
               << "Use JER systematics                    : " << useJERSyst << std::endl
               << "Trigger ID                             : " << triggerId << std::endl
               << "Reco jet selection method              : " << recoJetSelMethod << std::endl
+              << "Number of threads                      : " << nThreads << std::endl
+              << "Shard                                  : " << shardIndex << " of " << nShards << std::endl
+              << "Entry range                            : " << firstEntry << "-" << lastEntry << std::endl
+              << "Read-ahead depth                       : " << readAheadDepth << std::endl
+              << "Checkpoint file                        : " << checkpointFileName << std::endl
+              << "Number of processes                    : " << nProcesses << std::endl
+              << "Sampling step and block size           : " << samplingStep << " " << samplingBlockSize << std::endl
+              << "Event and time budget                  : " << eventBudget << " " << timeBudget << std::endl
+              << "TTreeCache size (MB) and prefetching   : " << treeCacheSizeMB << " " << asyncPrefetch << std::endl
               << std::endl;
 
     if (isMc) {
@@ -432,7 +536,8 @@ int main(int argc, char const *argv[]) {
     ForestAODReader *reader = createForestAODReader(inFileName, isMc, isCentWeightCalc, isPbGoingDir, 
                                                     recoJetBranchName, collisionSystemName, collisionSystem, collEnergyGeV, 
                                                     collYear, etaShift, path2JEC, JECFileName, JECFileDataName, 
-                                                    JEUFileName, useJEUSyst, useJERSyst, eventCut, nullptr);
+                                                    JEUFileName, useJEUSyst, useJERSyst, eventCut, nullptr, 
+                                                    treeCacheSizeMB, asyncPrefetch);
 
     // Pass reader to the manager
     manager->setEventReader(reader);
@@ -446,10 +551,7 @@ int main(int argc, char const *argv[]) {
     //
     // Initialize histogram manager
     //
-    HistoManagerDiJet *hm = new HistoManagerDiJet{};
-    hm->setIsMc( isMc );
-    hm->setUseVariableBinning( false ); // Use variable binning for eta (mainly dijet)
-    hm->init();
+    HistoManagerDiJet *hm = createHistoManagerDiJet( isMc );
 
     //
     // Add histogram manager to analysis
@@ -461,23 +563,66 @@ int main(int argc, char const *argv[]) {
     //
     manager->addAnalysis( analysis );
 
+    //
+    // Process only a slice of the input (e.g. one of many condor jobs)
+    //
+    manager->setEntryRange( firstEntry, lastEntry );
+    manager->setShard( shardIndex, nShards );
+
+    //
+    // Quick QA passes: sub-sampling and event/time budget
+    //
+    manager->setSampling( samplingStep, samplingBlockSize );
+    manager->setEventBudget( eventBudget );
+    manager->setTimeBudget( timeBudget );
+
+    //
+    // Each process handles its part of the entry range
+    //
+    manager->setNumberOfProcesses( nProcesses );
+
+    //
+    // Each extra thread gets its own reader, cuts, analysis and histograms
+    //
+    manager->setNumberOfThreads( nThreads );
+    manager->setReadAheadDepth( readAheadDepth );
+    if ( checkpointFileName.Length() > 0 ) {
+        manager->setCheckpoint( checkpointFileName.Data() );
+    }
+    manager->setWorkerFactory( [=](ManagerWorker &worker) {
+        worker.reader = createForestAODReader(inFileName, isMc, isCentWeightCalc, isPbGoingDir, 
+                                              recoJetBranchName, collisionSystemName, collisionSystem, collEnergyGeV, 
+                                              collYear, etaShift, path2JEC, JECFileName, JECFileDataName, 
+                                              JEUFileName, useJEUSyst, useJERSyst, 
+                                              createEventCut(isMc, triggerId, ptHatCut), nullptr, 
+                                              treeCacheSizeMB, asyncPrefetch);
+        DiJetAnalysis *workerAnalysis = createDiJetAnalysis(collisionSystem, collEnergyGeV, isMc, isPbGoingDir, ptHatCut, 
+                                                            createRecoJetCut(collEnergyGeV, recoJetSelMethod), 
+                                                            createGenJetCut(collEnergyGeV), createDiJetCut(), etaShift);
+        workerAnalysis->addHistoManager( createHistoManagerDiJet( isMc ) );
+        if ( isMc ) {
+            workerAnalysis->setNEventsInSample( reader->nEntriesInChain() );
+        }
+        worker.analyses.push_back( workerAnalysis );
+    });
+
+    //
+    // Output file with results of calculations (merged over threads)
+    // For compression read: https://root.cern.ch/doc/master/Compression_8h_source.html#l00049
+    //
+    int compressionSetting = 208; // LZMA compression
+    manager->setOutputFileName( oFileName.Data(), compressionSetting );
+
     // Run chain of analyses
     manager->init();
 
     // Important for pPb8160 embedding reweightening
     if ( isMc ) {
-        analysis->setNEventsInSample( reader->nEventsTotal() );
+        analysis->setNEventsInSample( reader->nEntriesInChain() );
     }
 
     manager->performAnalysis();
     manager->finish();
 
-    // Create output file and store results of calculations
-    // For compression read: https://root.cern.ch/doc/master/Compression_8h_source.html#l00049
-    int compressionSetting = 208; // LZMA compression
-    TFile* oFile = new TFile(oFileName, "recreate", "", compressionSetting);
-    hm->writeOutput();
-    oFile->Close();
-
     return 0;
 }
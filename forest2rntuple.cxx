@@ -0,0 +1,167 @@
+// C++ headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Jet analysis headers
+#include "ForestRNTupleConverter.h"
+#include "ForestRNTupleInput.h"
+#include "ForestTools.h"
+
+// ROOT headers
+#include "TROOT.h"
+#include "TString.h"
+#include "TSystem.h"
+
+//________________
+void usage() {
+    std::cout << "./forest2rntuple inputFileList outputDir isMc jetTrees compression nThreads nBenchmarkEvents path2JetAnalysis" << std::endl;
+    std::cout << "inputFileList: forest file (.root) or list of forest files" << std::endl;
+    std::cout << "outputDir: directory for the converted files and their list rntuple.list" << std::endl;
+    std::cout << "isMc: 1 (embedding), 0 (data)" << std::endl;
+    std::cout << "jetTrees: comma-separated jet trees to convert (default: akCs4PFJetAnalyzer). The first one is read in the benchmark" << std::endl;
+    std::cout << "compression: algorithm * 100 + level (default: 505 - ZSTD level 5)" << std::endl;
+    std::cout << "nThreads: number of files converted in parallel (default: 4)" << std::endl;
+    std::cout << "nBenchmarkEvents: events read with ForestAODReader from the trees and from the RNTuples (default: 0 - no benchmark, -1 - all)" << std::endl;
+    std::cout << "path2JetAnalysis: directory with aux_files used for JEC in the benchmark (default: ../)" << std::endl;
+}
+
+//________________
+/// @brief Convert forest files into RNTuples and compare reading rates of both formats
+/// @param argc Number of arguments
+/// @param argv Argument list
+/// @return 0 in case of OKAY
+int main(int argc, char const *argv[]) {
+
+    std::cout << "Starting forest2rntuple program" << std::endl;
+
+    if ( argc < 4 ) {
+        std::cout << "Too few arguments passed. Terminating" << std::endl;
+        usage();
+        return -1;
+    }
+    if ( !ForestRNTupleInput::isAvailable() ) {
+        std::cerr << "RNTuple support is not compiled in (ROOT 6.36 or newer is needed). Terminating" << std::endl;
+        return -1;
+    }
+
+    TString inFileName = argv[1];
+    TString outDir = argv[2];
+    bool isMc = atoi( argv[3] );
+    std::vector<std::string> jetTrees;
+    std::stringstream jetTreeNames( ( argc > 4 ) ? argv[4] : "akCs4PFJetAnalyzer" );
+    std::string jetTree;
+    while ( getline( jetTreeNames, jetTree, ',' ) ) {
+        if ( !jetTree.empty() ) jetTrees.push_back( jetTree );
+    }
+    if ( jetTrees.empty() ) jetTrees.push_back( "akCs4PFJetAnalyzer" );
+    int compression = ( argc > 5 ) ? atoi( argv[5] ) : 505;
+    int nThreads = ( argc > 6 ) ? std::max( atoi( argv[6] ), 1 ) : 4;
+    Long64_t nBenchmarkEvents = ( argc > 7 ) ? atoll( argv[7] ) : 0;
+    TString path2JetAnalysis = ( argc > 8 ) ? argv[8] : "../";
+
+    std::cout << "Arguments passed:\n"
+              << "Input file name        : " << inFileName << std::endl
+              << "Output directory       : " << outDir << std::endl
+              << "Is MC                  : " << isMc << std::endl
+              << "Jet trees              : " << ( argc > 4 ? argv[4] : "akCs4PFJetAnalyzer" ) << std::endl
+              << "Compression            : " << compression << std::endl
+              << "Number of threads      : " << nThreads << std::endl
+              << "Benchmark events       : " << nBenchmarkEvents << std::endl
+              << std::endl;
+
+    std::vector<std::string> inFiles;
+    ForestTools::readFileList( inFileName.Data(), inFiles );
+    if ( inFiles.empty() ) {
+        std::cerr << "No input files. Terminating" << std::endl;
+        return -1;
+    }
+    gSystem->mkdir( outDir.Data(), kTRUE );
+
+    //
+    // Convert files in parallel
+    //
+    ForestRNTupleConverter converter;
+    for (const auto& name : jetTrees) converter.addJetTree( name.c_str() );
+    converter.setIsMc( isMc );
+    converter.setCompression( compression );
+
+    std::vector<std::string> outFiles( inFiles.size() );
+    std::vector<char> isConverted( inFiles.size(), 0 );
+    for (size_t iFile{0}; iFile<inFiles.size(); iFile++) {
+        outFiles.at(iFile) = Form("%s/%s", outDir.Data(), gSystem->BaseName( inFiles.at(iFile).c_str() ));
+    }
+    nThreads = std::min( nThreads, static_cast<int>( inFiles.size() ) );
+    if ( nThreads > 1 ) {
+        ROOT::EnableThreadSafety();
+    }
+    auto conversionStart = std::chrono::steady_clock::now();
+    std::atomic<size_t> next{0};
+    auto convert = [&]() {
+        for (size_t iFile = next++; iFile < inFiles.size(); iFile = next++) {
+            isConverted.at(iFile) = converter.convert( inFiles.at(iFile).c_str(), outFiles.at(iFile).c_str() );
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int iThread{1}; iThread<nThreads; iThread++) {
+        threads.emplace_back( convert );
+    }
+    convert();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double conversionTime = std::chrono::duration<double>( std::chrono::steady_clock::now() - conversionStart ).count();
+
+    // List of the converted files (input of ForestAODReader::useRNTupleInput)
+    TString outList = Form("%s/rntuple.list", outDir.Data());
+    std::ofstream list( outList.Data() );
+    Long64_t inBytes{0}, outBytes{0};
+    int nConverted{0};
+    for (size_t iFile{0}; iFile<inFiles.size(); iFile++) {
+        if ( !isConverted.at(iFile) ) continue;
+        list << outFiles.at(iFile) << "\n";
+        FileStat_t inStat, outStat;
+        if ( gSystem->GetPathInfo( inFiles.at(iFile).c_str(), inStat ) == 0 ) inBytes += inStat.fSize;
+        if ( gSystem->GetPathInfo( outFiles.at(iFile).c_str(), outStat ) == 0 ) outBytes += outStat.fSize;
+        nConverted++;
+    }
+    list.close();
+    std::cout << Form("Converted %d of %zu files in %.1f s. Forest files: %.1f MB, RNTuple files: %.1f MB (event, HLT, skimming and jet trees only)\n",
+                      nConverted, inFiles.size(), conversionTime, inBytes / 1024. / 1024., outBytes / 1024. / 1024.);
+    std::cout << "List of converted files: " << outList << std::endl;
+    if ( nConverted != static_cast<int>( inFiles.size() ) ) {
+        std::cerr << "Not all files are converted. Benchmark is not run" << std::endl;
+        return 1;
+    }
+
+    //
+    // Compare reading of the same events from the trees and from the RNTuples
+    //
+    if ( nBenchmarkEvents != 0 ) {
+        double treeChecksum{0}, rntupleChecksum{0};
+        Long64_t treeEvents{0}, rntupleEvents{0};
+        const Long64_t nEvents = ( nBenchmarkEvents > 0 ) ? nBenchmarkEvents : -1;
+        const double treeRate = ForestTools::readEvents( inFileName.Data(), isMc, jetTrees.front(), path2JetAnalysis.Data(),
+                                                         nEvents, treeEvents, &treeChecksum, false );
+        const double rntupleRate = ForestTools::readEvents( outList.Data(), isMc, jetTrees.front(), path2JetAnalysis.Data(),
+                                                            nEvents, rntupleEvents, &rntupleChecksum, true );
+
+        std::cout << "\n" << Form("%-10s %12s %14s %20s\n", "Input", "Events", "Events/s", "Checksum");
+        std::cout << Form("%-10s %12lld %14.1f %20.6e\n", "TChain", treeEvents, treeRate, treeChecksum);
+        std::cout << Form("%-10s %12lld %14.1f %20.6e\n", "RNTuple", rntupleEvents, rntupleRate, rntupleChecksum);
+        std::cout << Form("RNTuple / TChain reading rate: %.2f\n", ( treeRate > 0 ) ? rntupleRate / treeRate : 0.);
+        const bool isEqual = ( treeEvents == rntupleEvents &&
+                               std::abs( treeChecksum - rntupleChecksum ) <= 1e-9 * std::max( 1., std::abs( treeChecksum ) ) );
+        std::cout << ( isEqual ? "Events are identical" : "[ERROR] Events differ" ) << std::endl;
+        if ( !isEqual ) return 1;
+    }
+
+    return 0;
+}
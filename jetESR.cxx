@@ -16,7 +16,7 @@
 
 //________________
 void usage() {
-    std::cout << "./programName inputFileList oFileName isMc isPbGoingDir ptHatLow ptHatHi jeuSyst jerSyst triggerId recoJetSelMethod" << std::endl;
+    std::cout << "./programName inputFileList oFileName isMc isPbGoingDir ptHatLow ptHatHi jeuSyst jerSyst triggerId recoJetSelMethod treeCacheSizeMB asyncPrefetch" << std::endl;
     std::cout << "isMc: 1 (embedding), 0 (data)" << std::endl;
     std::cout << "isPbGoingDir: 1 (Pb-going), 0 (p-going)" << std::endl;
     std::cout << "ptHatLow: Low ptHat cut (for embedding)" << std::endl;
@@ -25,6 +25,8 @@ void usage() {
     std::cout << "jerSyst: 0 (default), 1 (JER+), -1 (JER-), other - only JEC is applied" << std::endl;
     std::cout << "triggerId: 0 - no trigger (or MB), 1 - jet60, 2 - jet80, 3 - jet100" << std::endl;
     std::cout << "recoJetSelMethod: 0 - no selection, 1 - trkMaxPt/RawPt, 2 - jetId" << std::endl;
+    std::cout << "treeCacheSizeMB: TTreeCache size of every chain in MB, -1 - 10 MB (50 MB for the jet tree) (default: -1)" << std::endl;
+    std::cout << "asyncPrefetch: 1 - prefetch baskets asynchronously, 0 - no prefetching (default: 0)" << std::endl;
 }
 
 //________________
@@ -120,7 +122,8 @@ ForestAODReader *createForestAODReader(const TString &inFileName, const bool &is
     const TString &collisionSystemName, const int &collisionSystem, const int &collEnergyGeV, 
     const int &collYear, const float &etaShift, const TString &path2JEC, const TString &JECFileName, 
     const TString &JECFileDataName, const TString &JEUFileName, const int &useJEUSyst, 
-    const int &useJERSyst, EventCut *eventCut = nullptr, JetCut *jetCut = nullptr) {
+    const int &useJERSyst, EventCut *eventCut = nullptr, JetCut *jetCut = nullptr, 
+    const int &treeCacheSizeMB = -1, const bool &asyncPrefetch = false) {
 
     // Create ForestAODReader object
     ForestAODReader *forestReader = new ForestAODReader{inFileName};
@@ -157,6 +160,16 @@ ForestAODReader *createForestAODReader(const TString &inFileName, const bool &is
     // Perform jet manual jet matching
     forestReader->fixJetArrays();
 
+    // Explicit TTreeCache per chain (remote reads on EOS): jet tree is the largest one
+    if ( treeCacheSizeMB >= 0 ) {
+        forestReader->setTreeCacheSize( static_cast<Long64_t>( treeCacheSizeMB ) * 1024 * 1024 );
+    }
+    else {
+        forestReader->setTreeCacheSize( 10 * 1024 * 1024 );
+        forestReader->setTreeCacheSize( "jet", 50 * 1024 * 1024 );
+    }
+    forestReader->useAsyncPrefetch( asyncPrefetch );
+
     // Set path to jet analysis directory (then will automatically add path to aux_files)
     forestReader->setPath2JetAnalysis( path2JEC.Data() );
     forestReader->addJECFile( JECFileName.Data() );
@@ -261,6 +274,8 @@ int main(int argc, char const *argv[]) {
     float etaShift = 0.465;
     int   triggerId{0};     // 0 - no trigger (or MB), 1 - jet60, 2 - jet80, 3 - jet100
     int   recoJetSelMethod{1}; // 0 - no selection, 1 - trkMaxPt/RawPt, 2 - jetId
+    int   treeCacheSizeMB{-1}; // TTreeCache size of every chain in MB (-1 - default per chain)
+    bool  asyncPrefetch{false}; // Prefetch baskets asynchronously
 
     // Sequence of command line arguments:
     //
@@ -274,6 +289,8 @@ int main(int argc, char const *argv[]) {
     // useJERSyst                     - 0 (default), 1 (JER+), -1 (JER-)
     // triggerId                      - 0 - no trigger (or MB), 1 - jet60, 2 - jet80, 3 - jet100
     // recoJetSelMethod               - 0 - no selection, 1 - trkMaxPt/RawPt, 2 - jetId
+    // treeCacheSizeMB                - TTreeCache size of every chain in MB (default: -1 - 10 MB, 50 MB for jets)
+    // asyncPrefetch                  - 1 - prefetch baskets asynchronously (default: 0)
 
     // Read input argument list 
     if (argc <= 1) {
@@ -303,6 +320,12 @@ int main(int argc, char const *argv[]) {
         else {
             recoJetSelMethod = atoi( argv[10] );
         }
+        if (argc > 11 ) {
+            treeCacheSizeMB = atoi( argv[11] );
+        }
+        if (argc > 12 ) {
+            asyncPrefetch = atoi( argv[12] );
+        }
     }
 
     std::cout << "Arguments passed:\n"
@@ -318,6 +341,7 @@ int main(int argc, char const *argv[]) {
               << "Use JER systematics                    : " << useJERSyst << std::endl
               << "Trigger ID                             : " << triggerId << std::endl
               << "Reco jet selection method              : " << recoJetSelMethod << std::endl
+              << "TTreeCache size (MB) and prefetching   : " << treeCacheSizeMB << " " << asyncPrefetch << std::endl
               << std::endl;
 
     if (isMc) {
@@ -373,7 +397,8 @@ int main(int argc, char const *argv[]) {
     ForestAODReader *reader = createForestAODReader(inFileName, isMc, isCentWeightCalc, isPbGoingDir, 
                                                     recoJetBranchName, collisionSystemName, collisionSystem, collEnergyGeV, 
                                                     collYear, etaShift, path2JEC, JECFileName, JECFileDataName, 
-                                                    JEUFileName, useJEUSyst, useJERSyst, eventCut, nullptr);
+                                                    JEUFileName, useJEUSyst, useJERSyst, eventCut, nullptr, 
+                                                    treeCacheSizeMB, asyncPrefetch);
 
     // Pass reader to the manager
     manager->setEventReader(reader);
@@ -4,8 +4,8 @@
 source $HOME/setup_cmsenv.sh
 
 # Check if the correct number of arguments is provided
-if [ "$#" -ne 2 ]; then
-    echo "Usage: $0 <input ROOT filename> <output directory>"
+if [ "$#" -lt 2 ]; then
+    echo "Usage: $0 <input ROOT filename> <output directory> [skimForest options]"
     exit 1
 fi
 
@@ -26,10 +26,10 @@ if [ ! -d "$outputDirectory" ]; then
     echo "Output directory '$outputDirectory' created!"  
 fi
 
-# Call the cloneFile.C macro using ROOT
+# Call the compiled skimmer (see ./skimForest for the options)
 if [ $? -eq 0 ]; then
-    root -l -b -q "~/soft/jetAnalysis/macro/cloneForest.C(\"$inputFileName\", \"$outputDirectory\")"
+    ~/soft/jetAnalysis/build/skimForest "$inputFileName" "$outputDirectory" "${@:3}"
 else
-    echo "Error: Failed to execute macro"
+    echo "Error: Failed to execute skimForest"
     exit 1
 fi
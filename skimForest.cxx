@@ -0,0 +1,144 @@
+// C++ headers
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Jet analysis headers
+#include "EventCut.h"
+#include "ForestSkimmer.h"
+#include "ForestTools.h"
+
+// ROOT headers
+#include "TString.h"
+
+//________________
+void usage() {
+    std::cout << "./skimForest inputFileList outputDir isMc compression nThreads leadingJetPt vzCut flags branches jetTrees jetPtBranch" << std::endl;
+    std::cout << "inputFileList: forest file (.root) or list of forest files" << std::endl;
+    std::cout << "outputDir: directory for the skimmed files (named after the input files)" << std::endl;
+    std::cout << "isMc: 1 (embedding or pythia), 0 (data)" << std::endl;
+    std::cout << "compression: LZ4:level, ZSTD:level, LZMA:level, ZLIB:level or algorithm * 100 + level (default: LZMA:8)" << std::endl;
+    std::cout << "nThreads: number of files skimmed in parallel (default: 1)" << std::endl;
+    std::cout << "leadingJetPt: keep events with the leading jet pT above the value, -1 - no selection (default: -1)" << std::endl;
+    std::cout << "vzCut: keep events with |vz| < vzCut, -1 - no selection (default: -1)" << std::endl;
+    std::cout << "flags: comma-separated triggers and skimming filters that must be set, \"\" - none (default: none)" << std::endl;
+    std::cout << "branches: all, reader (branches read by ForestAODReader) or \"dir:pattern,pattern;dir:pattern\" (default: all)" << std::endl;
+    std::cout << "jetTrees: comma-separated jet trees to copy, the first one is used for the leading jet (default: ak4PFJetAnalyzer)" << std::endl;
+    std::cout << "jetPtBranch: jet pT branch of the leading jet selection (default: jtpt)" << std::endl;
+}
+
+//________________
+/// @brief Skim forest files: select events, keep requested branches and recompress
+/// @param argc Number of arguments
+/// @param argv Argument list
+/// @return 0 in case of OKAY
+int main(int argc, char const *argv[]) {
+
+    std::cout << "Starting skimForest program" << std::endl;
+
+    if ( argc < 3 ) {
+        std::cout << "Too few arguments passed. Terminating" << std::endl;
+        usage();
+        return -1;
+    }
+
+    TString inFileName = argv[1];
+    TString outDir = argv[2];
+    bool isMc = ( argc > 3 ) ? atoi( argv[3] ) : false;
+    const char *compressionName = ( argc > 4 ) ? argv[4] : "LZMA:8";
+    int nThreads = ( argc > 5 ) ? std::max( atoi( argv[5] ), 1 ) : 1;
+    double leadingJetPt = ( argc > 6 ) ? atof( argv[6] ) : -1.;
+    double vzCut = ( argc > 7 ) ? atof( argv[7] ) : -1.;
+    std::string flags = ( argc > 8 ) ? argv[8] : "";
+    const char *branches = ( argc > 9 ) ? argv[9] : "all";
+    std::string jetTreeNames = ( argc > 10 ) ? argv[10] : "ak4PFJetAnalyzer";
+    const char *jetPtBranch = ( argc > 11 ) ? argv[11] : "jtpt";
+
+    const int compression = ForestSkimmer::compressionSettings( compressionName );
+    if ( compression < 0 ) {
+        std::cerr << "Unknown compression " << compressionName << ". Terminating" << std::endl;
+        usage();
+        return -1;
+    }
+
+    std::cout << "Arguments passed:\n"
+              << "Input file name        : " << inFileName << std::endl
+              << "Output directory       : " << outDir << std::endl
+              << "Is MC                  : " << isMc << std::endl
+              << "Compression            : " << compressionName << " (" << compression << ")" << std::endl
+              << "Number of threads      : " << nThreads << std::endl
+              << "Leading jet pT         : " << leadingJetPt << std::endl
+              << "|vz| cut               : " << vzCut << std::endl
+              << "Flags                  : " << flags << std::endl
+              << "Branches               : " << branches << std::endl
+              << "Jet trees              : " << jetTreeNames << std::endl
+              << "Jet pT branch          : " << jetPtBranch << std::endl
+              << std::endl;
+
+    std::vector<std::string> inFiles;
+    ForestTools::readFileList( inFileName.Data(), inFiles );
+    if ( inFiles.empty() ) {
+        std::cerr << "No input files. Terminating" << std::endl;
+        return -1;
+    }
+
+    //
+    // Trees of the forest to copy
+    //
+    ForestSkimmer skimmer;
+    skimmer.addTree( "hiEvtAnalyzer", "HiTree" );
+    skimmer.addTree( "hltanalysis", "HltTree" );
+    skimmer.addTree( "skimanalysis", "HltTree" );
+    std::vector<std::string> jetTrees;
+    std::stringstream jetTreeStream( jetTreeNames );
+    std::string jetTree;
+    while ( getline( jetTreeStream, jetTree, ',' ) ) {
+        if ( !jetTree.empty() ) {
+            skimmer.addTree( jetTree.c_str(), "t" );
+            jetTrees.push_back( jetTree );
+        }
+    }
+    skimmer.setIsMc( isMc );
+    skimmer.setCompression( compression );
+    skimmer.keepBranches( branches );
+
+    //
+    // Event preselection
+    //
+    if ( vzCut >= 0 || !flags.empty() ) {
+        EventCut *eventCut = new EventCut{};
+        if ( vzCut >= 0 ) eventCut->setVz( -vzCut, vzCut );
+        std::stringstream flagStream( flags );
+        std::string flag;
+        while ( getline( flagStream, flag, ',' ) ) {
+            if ( !flag.empty() ) eventCut->useFlag( flag.c_str() );
+        }
+        skimmer.setEventCut( eventCut );
+    }
+    if ( leadingJetPt >= 0 ) {
+        skimmer.setLeadingJetPt( leadingJetPt, ( jetTrees.empty() ) ? "" : jetTrees.front().c_str(), jetPtBranch );
+    }
+    skimmer.report();
+
+    //
+    // Skim files in parallel
+    //
+    ForestSkimmer::Result total = skimmer.skim( inFiles, outDir.Data(), nThreads );
+    std::cout << Form("Skimmed %zu files in %.1f s: %lld of %lld events (%.2f%%), %.1f -> %.1f MB\n",
+                      inFiles.size(), total.seconds, total.nSelected, total.nEvents,
+                      ( total.nEvents > 0 ) ? 100. * total.nSelected / total.nEvents : 0.,
+                      total.inBytes / 1024. / 1024., total.outBytes / 1024. / 1024.);
+    if ( total.nEventCutPassed + total.nEventCutFailed > 0 ) {
+        std::cout << Form("Event cut: %lld events passed, %lld events failed\n", 
+                          total.nEventCutPassed, total.nEventCutFailed);
+    }
+    if ( !total.isGood ) {
+        std::cerr << "Not all files are skimmed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}